@@ -91,6 +91,10 @@ static std::string text(const std::string& text) {
     return (end == std::string::npos) ? "" : text.substr(0, end + 1);
 }
 
+static std::string channel(const ais::Channel value) {
+    return (value == ais::Channel::A) ? "A" : "B";
+}
+
 static std::string navigational_status(const unsigned int value) {
     switch (value) {
         case 0:
@@ -192,7 +196,7 @@ void AISLogger::on_packet(const ais::Packet& packet) {
         entry += (nibble >= 10) ? ('W' + nibble) : ('0' + nibble);
     }
 
-    log_file.write_entry(packet.received_at(), entry);
+    log_file.write_entry(packet.received_at(), entry + " " + ais::format::channel(packet.channel()));
 
     if (pmem::beep_on_packets()) {
         baseband::request_audio_beep(1000, 24000, 60);
@@ -201,6 +205,7 @@ void AISLogger::on_packet(const ais::Packet& packet) {
 
 void AISRecentEntry::update(const ais::Packet& packet) {
     received_count++;
+    channel_counts[static_cast<size_t>(packet.channel())]++;
 
     switch (packet.message_id()) {
         case 1:
@@ -365,7 +370,7 @@ void AISRecentEntryDetailView::paint(Painter& painter) {
     field_rect = draw_field(painter, field_rect, s, "SoG ", ais::format::speed_over_ground(entry_.last_position.speed_over_ground));
     field_rect = draw_field(painter, field_rect, s, "CoG ", ais::format::course_over_ground(entry_.last_position.course_over_ground));
     field_rect = draw_field(painter, field_rect, s, "Head", ais::format::true_heading(entry_.last_position.true_heading));
-    field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count));
+    field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count) + " (A:" + to_string_dec_uint(entry_.channel_counts[0]) + " B:" + to_string_dec_uint(entry_.channel_counts[1]) + ")");
 }
 
 void AISRecentEntryDetailView::set_entry(const AISRecentEntry& entry) {
@@ -395,9 +400,10 @@ AISAppView::AISAppView(NavigationView& nav)
     receiver_model.enable();
 
     options_channel.on_change = [this](size_t, OptionsField::value_t v) {
-        receiver_model.set_target_frequency(v);
+        set_channel(v);
     };
     options_channel.set_by_value(receiver_model.target_frequency());
+    set_channel(options_channel.selected_index_value());
 
     recent_entries_view.on_select = [this](const AISRecentEntry& entry) {
         on_show_detail(entry);
@@ -421,6 +427,7 @@ AISAppView::~AISAppView() {
     audio::output::stop();
     receiver_model.disable();
     baseband::shutdown();
+    database::close_all();
 }
 
 void AISAppView::focus() {
@@ -434,6 +441,15 @@ void AISAppView::set_parent_rect(const Rect new_parent_rect) {
     recent_entry_detail_view.set_parent_rect(content_rect);
 }
 
+void AISAppView::set_channel(const OptionsField::value_t frequency) {
+    receiver_model.set_target_frequency(frequency);
+
+    // With both channels, the baseband tags each packet with its channel.
+    baseband::set_ais(
+        frequency == ais::dual_channel_frequency,
+        (frequency == ais::channel_b_frequency) ? ais::Channel::B : ais::Channel::A);
+}
+
 void AISAppView::on_packet(const ais::Packet& packet) {
     if (logger) {
         logger->on_packet(packet);
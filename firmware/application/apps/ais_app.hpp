@@ -40,6 +40,7 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -71,6 +72,7 @@ struct AISRecentEntry {
     std::string destination;
     AISPosition last_position;
     size_t received_count;
+    std::array<size_t, 2> channel_counts;
     int8_t navigational_status;
 
     AISRecentEntry()
@@ -85,6 +87,7 @@ struct AISRecentEntry {
           destination{},
           last_position{},
           received_count{0},
+          channel_counts{},
           navigational_status{-1} {
     }
 
@@ -192,8 +195,9 @@ class AISAppView : public View {
         {3 * 8, 0 * 16},
         3,
         {
-            {"87B", 161975000},
-            {"88B", 162025000},
+            {"87B", ais::channel_a_frequency},
+            {"88B", ais::channel_b_frequency},
+            {"A+B", ais::dual_channel_frequency},
         }};
 
     RFAmpField field_rf_amp{
@@ -220,12 +224,13 @@ class AISAppView : public View {
         Message::ID::AISPacket,
         [this](Message* const p) {
             const auto message = static_cast<const AISPacketMessage*>(p);
-            const ais::Packet packet{message->packet};
+            const ais::Packet packet{message->packet, message->channel};
             if (packet.is_valid()) {
                 this->on_packet(packet);
             }
         }};
 
+    void set_channel(const OptionsField::value_t frequency);
     void on_packet(const ais::Packet& packet);
     void on_show_list();
     void on_show_detail(const AISRecentEntry& entry);
@@ -255,6 +255,11 @@ AnalogAudioView::AnalogAudioView(
     waterfall.on_select = [this](int32_t offset) {
         field_frequency.set_value(receiver_model.target_frequency() + offset);
     };
+    waterfall.on_show_options = [this]() {
+        this->on_show_options_waterfall();
+    };
+    if (waterfall_bins <= toUType(spectrum::BinReducer::MaxPool))
+        waterfall.set_bin_reducer(static_cast<spectrum::BinReducer>(waterfall_bins));
 
     audio::output::start();
 
@@ -360,10 +365,12 @@ void AnalogAudioView::on_baseband_bandwidth_changed(uint32_t bandwidth_hz) {
 }
 
 void AnalogAudioView::on_modulation_changed(ReceiverModel::Mode modulation) {
-    baseband::spectrum_streaming_stop();
+    waterfall.stop();
     update_modulation(modulation);
     on_show_options_modulation();
-    baseband::spectrum_streaming_start();
+    // Zoom restarts centred on the tuned frequency; the wideband image can't zoom.
+    waterfall.set_zoom(0, (modulation == ReceiverModel::Mode::SpectrumAnalysis) ? 1 : std::max<uint8_t>(waterfall_zoom, 1));
+    waterfall.start();
 }
 
 void AnalogAudioView::remove_options_widget() {
@@ -462,6 +469,20 @@ void AnalogAudioView::on_show_options_modulation() {
     options_modulation.set_style(Theme::getInstance()->option_active);
 }
 
+void AnalogAudioView::on_show_options_waterfall() {
+    auto widget = std::make_unique<spectrum::WaterfallOptionsView>(waterfall, options_view_rect, Theme::getInstance()->option_active);
+
+    widget->set_zoom_visible(receiver_model.modulation() != ReceiverModel::Mode::SpectrumAnalysis);
+    widget->on_zoom_change = [this](uint32_t decimation) {
+        waterfall_zoom = decimation;
+    };
+    widget->on_bin_reducer_change = [this](spectrum::BinReducer reducer) {
+        waterfall_bins = toUType(reducer);
+    };
+
+    set_options_widget(std::move(widget));
+}
+
 void AnalogAudioView::on_frequency_step_changed(rf::Frequency f) {
     receiver_model.set_frequency_step(f);
     field_frequency.set_step(f);
@@ -547,7 +568,10 @@ void AnalogAudioView::update_modulation(ReceiverModel::Mode modulation) {
 }
 
 void AnalogAudioView::handle_coded_squelch(uint32_t value) {
-    text_ctcss.set(tone_key_string_by_value(value, text_ctcss.parent_rect().width() / 8));
+    if (value)
+        text_ctcss.set(tone_key_string_by_value(value, text_ctcss.parent_rect().width() / 8));
+    else
+        text_ctcss.set("        ");
 }
 
 void AnalogAudioView::on_freqchg(int64_t freq) {
@@ -232,6 +232,8 @@ class AnalogAudioView : public View {
     uint8_t zoom_factor_amfm{0};             // initial zoom factor in AMFM mode
     uint8_t previous_AM_mode_option{0};      // GUI 5 AM modes :  (0..4 ) (DSB9K, DSB6K, USB,LSB, CW). Used to select proper FIR filter (0..11) AM mode  + offset 0 (zoom+1) or +6 (if zoom+2)
     uint8_t previous_zoom{0};                // GUI ZOOM+1, ZOOM+2 , equivalent to two values offset 0 (zoom+1) or +6 (if zoom+2)
+    uint8_t waterfall_zoom{1};               // waterfall zoom factor (x1, x2, x4, x8), narrowband modes only
+    uint8_t waterfall_bins{0};               // waterfall BinReducer: Crop, Decimate or MaxPool
 
     app_settings::SettingsManager settings_{
         "rx_audio",
@@ -242,6 +244,8 @@ class AnalogAudioView : public View {
             {"zoom_factor_amfm"sv, &zoom_factor_amfm},                // we are saving and restoring AMFM ZOOM factor from Settings.
             {"previous_AM_mode_option"sv, &previous_AM_mode_option},  // we are saving and restoring AMFM ZOOM factor from Settings.
             {"previous_zoom"sv, &previous_zoom},                      // we are saving and restoring AMFM ZOOM factor from Settings.
+            {"waterfall_zoom"sv, &waterfall_zoom},
+            {"waterfall_bins"sv, &waterfall_bins},
         }};
 
     const Rect options_view_rect{0 * 8, 1 * 16, screen_width, 1 * 16};
@@ -306,6 +310,7 @@ class AnalogAudioView : public View {
     void on_show_options_frequency();
     void on_show_options_rf_gain();
     void on_show_options_modulation();
+    void on_show_options_waterfall();
     void on_frequency_step_changed(rf::Frequency f);
     void on_reference_ppm_correction_changed(int32_t v);
 
@@ -180,8 +180,8 @@ class BLECommView : public View {
     MessageHandlerRegistration message_handler_packet{
         Message::ID::BlePacket,
         [this](Message* const p) {
-            const auto message = static_cast<const BLEPacketMessage*>(p);
-            this->on_data(message->packet);
+            const auto message = static_cast<BLEPacketSlotMessage*>(p);
+            this->on_data(&message->data);
         }};
 
     MessageHandlerRegistration message_handler_tx_progress{
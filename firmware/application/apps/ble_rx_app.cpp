@@ -977,6 +977,7 @@ BLERxView::~BLERxView() {
     portapack::async_tx_enabled = async_tx_states_when_entered;
     receiver_model.disable();
     baseband::shutdown();
+    database::close_all();
 }
 
 void BLERxView::updateEntry(const BlePacketData* packet, BleRecentEntry& entry, ADV_PDU_TYPE pdu_type) {
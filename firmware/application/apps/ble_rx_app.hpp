@@ -390,8 +390,8 @@ class BLERxView : public View {
     MessageHandlerRegistration message_handler_packet{
         Message::ID::BlePacket,
         [this](Message* const p) {
-            const auto message = static_cast<const BLEPacketMessage*>(p);
-            this->on_data(message->packet);
+            const auto message = static_cast<BLEPacketSlotMessage*>(p);
+            this->on_data(&message->data);
         }};
 
     MessageHandlerRegistration message_handler_frame_sync{
@@ -441,6 +441,7 @@ ADSBRxView::~ADSBRxView() {
     audio::output::stop();
     receiver_model.disable();
     baseband::shutdown();
+    database::close_all();
 }
 
 void ADSBRxView::focus() {
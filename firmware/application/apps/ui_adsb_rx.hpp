@@ -167,7 +167,7 @@ struct AircraftRecentEntry {
     }
 };
 
-// NB: uses std::list underneath so assuming refs are NOT invalidated.
+// NB: entries live in a fixed pool, refs stay valid until the entry is erased.
 using AircraftRecentEntries = RecentEntries<AircraftRecentEntry>;
 
 /* Holds data for logging. */
@@ -74,6 +74,44 @@ void DebugMemoryView::focus() {
     button_done.focus();
 }
 
+/* DebugMessageQueueView *************************************************/
+
+DebugMessageQueueView::DebugMessageQueueView(NavigationView& nav) {
+    add_children({&text_pushed,
+                  &text_dropped,
+                  &text_high_water,
+                  &console,
+                  &button_reset,
+                  &button_done});
+
+    button_reset.on_select = [this](Button&) {
+        shared_memory.application_queue.reset_stats();
+        update();
+    };
+    button_done.on_select = [&nav](Button&) { nav.pop(); };
+
+    update();
+}
+
+void DebugMessageQueueView::focus() {
+    button_done.focus();
+}
+
+void DebugMessageQueueView::update() {
+    const auto& queue = shared_memory.application_queue;
+    text_pushed.set("Pushed:  " + to_string_dec_uint(queue.pushed()));
+    text_dropped.set("Dropped: " + to_string_dec_uint(queue.dropped()));
+    text_high_water.set("Peak:    " + to_string_dec_uint(queue.high_water()) + "/" + to_string_dec_uint(queue.size()) + " bytes");
+
+    console.clear(true);
+    console.writeln("Drops by message ID:");
+    for (size_t i = 0; i < static_cast<size_t>(Message::ID::MAX); i++) {
+        const auto count = queue.dropped(static_cast<Message::ID>(i));
+        if (count)
+            console.writeln("ID " + to_string_dec_uint(i, 3) + ": " + to_string_dec_uint(count));
+    }
+}
+
 /* RegistersWidget *******************************************************/
 
 RegistersWidget::RegistersWidget(
@@ -420,6 +458,7 @@ void DebugMenuView::on_populate() {
     add_items({
         {"Buttons Test", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_controls, [this]() { nav_.push<DebugControlsView>(); }},
         {"M0 Stack Dump", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { stack_dump(); }},
+        {"M4 Msg Queue", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugMessageQueueView>(); }},
         {"Memory Dump", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugMemoryDumpView>(); }},
         {"Peripherals", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_peripherals, [this]() { nav_.push<DebugPeripheralsMenuView>(); }},
         {"Pers. Memory", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugPmemView>(); }},
@@ -86,6 +86,41 @@ class DebugMemoryView : public View {
         "Done"};
 };
 
+class DebugMessageQueueView : public View {
+   public:
+    DebugMessageQueueView(NavigationView& nav);
+
+    void focus() override;
+
+    std::string title() const override { return "M4 Msg Queue"; };
+
+   private:
+    Text text_pushed{
+        {0, 16, screen_width, 16},
+    };
+
+    Text text_dropped{
+        {0, 32, screen_width, 16},
+    };
+
+    Text text_high_water{
+        {0, 48, screen_width, 16},
+    };
+
+    Console console{
+        {0, 72, screen_width, 192}};
+
+    Button button_reset{
+        {16, 272, 96, 24},
+        "Reset"};
+
+    Button button_done{
+        {128, 272, 96, 24},
+        "Done"};
+
+    void update();
+};
+
 typedef enum {
     CT_PMEM,
     CT_RFFC5072,
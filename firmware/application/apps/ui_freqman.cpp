@@ -264,8 +264,7 @@ void FrequencyManagerView::on_del_category() {
         [this](bool choice) {
             if (choice) {
                 db_.close();  // Ensure file is closed.
-                auto path = get_freqman_path(current_category());
-                delete_file(path);
+                delete_freqman_file(current_category());
                 refresh_categories();
             }
         });
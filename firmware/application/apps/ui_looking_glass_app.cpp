@@ -116,6 +116,31 @@ void GlassView::retune() {
     baseband::spectrum_streaming_start();  // Do the RX
 }
 
+void GlassView::configure_spectrum() {
+    baseband::set_spectrum(
+        looking_glass_bandwidth,
+        trigger,
+        static_cast<WidebandSpectrumConfigMessage::Window>(spectrum_window),
+        spectrum_overlap);
+}
+
+// A single pass view stays on one frequency, so level and peak views can be
+// reduced on the M4 in linear power. Sweeps retune between frames and keep
+// one FFT per step, smoothing across sweeps on the M0 instead.
+void GlassView::configure_accumulation() {
+    using Mode = SpectrumAccumulationConfigMessage::Mode;
+    Mode accumulation_mode = Mode::None;
+    if (mode == LOOKING_GLASS_SINGLEPASS) {
+        if (live_frequency_view == 1)
+            accumulation_mode = Mode::Average;
+        else if (live_frequency_view == 2)
+            accumulation_mode = Mode::PeakHold;
+    }
+
+    m4_accumulation = (accumulation_mode != Mode::None);
+    baseband::set_spectrum_accumulation(accumulation_mode, m4_accumulation ? live_frequency_integrate + 1 : 1);
+}
+
 void GlassView::reset_live_view() {
     max_freq_hold = 0;
     max_freq_power = -1000;
@@ -127,7 +152,10 @@ void GlassView::reset_live_view() {
 
 void GlassView::add_spectrum_pixel(uint8_t power) {
     spectrum_row[pixel_index] = gradient.lut[power];                                                                                // row of colors
-    spectrum_data[pixel_index] = (live_frequency_integrate * spectrum_data[pixel_index] + power) / (live_frequency_integrate + 1);  // smoothing
+    if (m4_accumulation)
+        spectrum_data[pixel_index] = power;  // already reduced on the M4
+    else
+        spectrum_data[pixel_index] = (live_frequency_integrate * spectrum_data[pixel_index] + power) / (live_frequency_integrate + 1);  // smoothing
     pixel_index++;
 
     if (pixel_index == screen_width)  // got an entire waterfall line
@@ -294,7 +322,8 @@ void GlassView::on_range_changed() {
 
     receiver_model.set_squelch_level(0);
     f_center = f_center_ini;  // Reset sweep into first slice
-    baseband::set_spectrum(looking_glass_bandwidth, trigger);
+    configure_spectrum();
+    configure_accumulation();
     receiver_model.set_target_frequency(f_center);  // tune rx for this slice
 }
 
@@ -431,6 +460,7 @@ GlassView::GlassView(
     view_config.on_change = [this](size_t, OptionsField::value_t v) {
         reset_live_view();  // Clear between changes.
         live_frequency_view = v;
+        configure_accumulation();
 
         switch (v) {
             case 0:  // SPEC
@@ -468,6 +498,7 @@ GlassView::GlassView(
     level_integration.on_change = [this](size_t, OptionsField::value_t v) {
         reset_live_view();
         live_frequency_integrate = v;
+        configure_accumulation();
     };
     level_integration.set_selected_index(live_frequency_integrate);
 
@@ -507,7 +538,7 @@ GlassView::GlassView(
 
     field_trigger.on_change = [this](int32_t v) {
         trigger = v;
-        baseband::set_spectrum(looking_glass_bandwidth, trigger);
+        configure_spectrum();
     };
     field_trigger.set_value(trigger);
 
@@ -538,7 +569,7 @@ GlassView::GlassView(
     // Discord User jteich:  WidebandSpectrum::on_message to set the trigger value. In WidebandSpectrum::execute,
     // it keeps adding the output of the fft to the buffer until "trigger" number of calls are made,
     // at which time it pushes the buffer up with channel_spectrum.feed
-    baseband::set_spectrum(looking_glass_bandwidth, trigger);
+    configure_spectrum();
 
     marker_pixel_index = screen_width / 2;
     on_range_changed();  // Force a UI update.
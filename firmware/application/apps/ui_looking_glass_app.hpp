@@ -85,6 +85,8 @@ class GlassView : public View {
     uint8_t iq_phase_calibration_value{15};  // initial default RX IQ phase calibration value , used for both max2837 & max2839
     int32_t beep_squelch = 20;               // range from -100 to +20, >=20 disabled
     bool beep_enabled = false;               // activate on bip button click
+    uint8_t spectrum_window = 1;             // WidebandSpectrumConfigMessage::Window, default Hann
+    uint8_t spectrum_overlap = 50;           // Window segment overlap in percent, 0-75
     app_settings::SettingsManager settings_{
         "rx_glass"sv,
         app_settings::Mode::RX,
@@ -100,6 +102,8 @@ class GlassView : public View {
             {"iq_phase_calibration"sv, &iq_phase_calibration_value},  // we are saving and restoring that CAL from Settings.
             {"beep_squelch"sv, &beep_squelch},
             {"beep_enabled"sv, &beep_enabled},
+            {"window"sv, &spectrum_window},
+            {"overlap"sv, &spectrum_overlap},
         }};
 
     struct preset_entry {
@@ -120,6 +124,8 @@ class GlassView : public View {
     rf::Frequency get_freq_from_bin_pos(uint8_t pos);
     void on_marker_change();
     void retune();
+    void configure_spectrum();
+    void configure_accumulation();
     bool process_bins(uint8_t* powerlevel);
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
     void do_timers();
@@ -158,6 +164,7 @@ class GlassView : public View {
 
     int32_t steps = 1;
     bool locked_range = false;
+    bool m4_accumulation = false;  // level/peak frames reduced by the M4
 
     uint8_t range_max_power = 0;
     uint8_t range_max_power_counter = 0;
@@ -97,8 +97,8 @@ bool ReconView::current_is_valid() {
     return (unsigned)current_index < frequency_list.size();
 }
 
-freqman_entry& ReconView::current_entry() {
-    return *frequency_list[current_index];
+const freqman_record& ReconView::current_entry() const {
+    return frequency_list.record(current_index);
 }
 
 void ReconView::set_loop_config(bool v) {
@@ -126,6 +126,9 @@ void ReconView::recon_stop_recording(bool exiting) {
 }
 
 void ReconView::clear_freqlist_for_ui_action() {
+    // Cluster members index into the list, so go back to the demodulator first.
+    if (fast_scan_active)
+        change_mode(field_mode.selected_index_value());
     recon_stop_recording(false);
     if (field_mode.selected_index_value() != SPEC_MODULATION)
         audio::output::stop();
@@ -136,6 +139,7 @@ void ReconView::clear_freqlist_for_ui_action() {
     } else
         frequency_list.shrink_to_fit();
     freqlist_cleared_for_ui_action = true;
+    fast_scan_clusters.invalidate();
 }
 
 void ReconView::reset_indexes() {
@@ -146,7 +150,7 @@ void ReconView::reset_indexes() {
 }
 
 void ReconView::update_description() {
-    if (frequency_list.empty() || current_entry().description.empty()) {
+    if (frequency_list.empty() || frequency_list.description(current_index).empty()) {
         description = "...no description...";
     } else {
         switch (current_entry().type) {
@@ -162,7 +166,7 @@ void ReconView::update_description() {
             default:
                 description = "S: ";
         }
-        description += current_entry().description;
+        description += frequency_list.description(current_index);
     }
     desc_cycle.set(description);
 }
@@ -198,7 +202,7 @@ bool ReconView::recon_save_freq(const fs::path& path, size_t freq_index, bool wa
     if (!freq_db.open(path, /*create*/ true))
         return false;
 
-    freqman_entry entry = *frequency_list[freq_index];  // Makes a copy.
+    freqman_entry entry = frequency_list.entry(freq_index);
 
     // For ranges, save the current frequency instead.
     if (entry.type == freqman_type::Range) {
@@ -233,6 +237,7 @@ void ReconView::load_persisted_settings() {
     load_repeaters = persistent_memory::recon_load_repeaters();
     update_ranges = persistent_memory::recon_update_ranges_when_recon();
     auto_record_locked = persistent_memory::recon_auto_record_locked();
+    fast_scan = persistent_memory::recon_fast_scan();
 }
 
 void ReconView::audio_output_start() {
@@ -277,12 +282,27 @@ void ReconView::recon_redraw() {
         last_db = db;
         text_max.set("/" + to_string_dec_uint(frequency_list.size()) + " " + to_string_dec_int(db) + " db");
     }
+    const systime_t retune_window = chTimeNow() - retune_window_start;
+    if (retune_window >= 1000) {
+        const uint32_t rate = retune_count * 1000 / retune_window;
+        retune_count = 0;
+        retune_window_start += retune_window;
+        if (rate != last_retune_rate) {
+            last_retune_rate = rate;
+            text_retune_rate.set("R/s:" + to_string_dec_uint(rate));
+        }
+    }
+}
+
+void ReconView::count_retune() {
+    retune_count++;
 }
 
 void ReconView::handle_retune() {
     if (last_freq != freq) {
         last_freq = freq;
         receiver_model.set_target_frequency(freq);  // Retune
+        count_retune();
     }
     if (frequency_list.size() > 0) {
         if (last_entry.modulation != current_entry().modulation && is_valid(current_entry().modulation)) {
@@ -367,6 +387,7 @@ ReconView::ReconView(NavigationView& nav)
                   &big_display,
                   &freq_stats,
                   &text_timer,
+                  &text_retune_rate,
                   &text_ctcss,
                   &button_manual_start,
                   &button_manual_end,
@@ -572,19 +593,21 @@ ReconView::ReconView(NavigationView& nav)
             // Clear doesn't actually free, re-assign so destructor runs on previous instance.
             frequency_list = freqman_db{};
             current_index = 0;
-            frequency_list.push_back(std::make_unique<freqman_entry>());
 
             def_step = step_mode.selected_index();
-            current_entry().type = freqman_type::Range;
-            current_entry().description =
+            freqman_entry range_entry{};
+            range_entry.type = freqman_type::Range;
+            range_entry.description =
                 to_string_short_freq(frequency_range.min).erase(0, 1) + ">" +  // euquiq: lame kludge to reduce spacing in step freq
                 to_string_short_freq(frequency_range.max).erase(0, 1) + " S:" +
                 freqman_entry_get_step_string_short(def_step);
-            current_entry().frequency_a = frequency_range.min;
-            current_entry().frequency_b = frequency_range.max;
-            current_entry().modulation = freqman_invalid_index;
-            current_entry().bandwidth = freqman_invalid_index;
-            current_entry().step = def_step;
+            range_entry.frequency_a = frequency_range.min;
+            range_entry.frequency_b = frequency_range.max;
+            range_entry.modulation = freqman_invalid_index;
+            range_entry.bandwidth = freqman_invalid_index;
+            range_entry.step = def_step;
+            frequency_list.push_back(range_entry);
+            fast_scan_clusters.invalidate();
 
             big_display.set_style(Theme::getInstance()->bg_darkest);  // Back to white color
 
@@ -659,8 +682,6 @@ ReconView::ReconView(NavigationView& nav)
             recon_pause();
         }
         button_add.hidden(scanner_mode);
-        if (scanner_mode)  // only needed when hiding, UI mayhem
-            set_dirty();
     };
 
     button_config.on_select = [this, &nav](Button&) {
@@ -785,6 +806,7 @@ void ReconView::frequency_file_load() {
         .load_ranges = load_ranges,
         .load_hamradios = load_hamradios,
         .load_repeaters = load_repeaters};
+    fast_scan_clusters.invalidate();
     if (!load_freqman_file(file_input, frequency_list, options) || frequency_list.empty()) {
         file_name.set_style(Theme::getInstance()->fg_red);
         desc_cycle.set("...empty file...");
@@ -911,7 +933,7 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
     }
     if (last_timer != timer) {
         last_timer = timer;
-        text_timer.set("TIMER: " + to_string_dec_int(timer));
+        text_timer.set("T:" + to_string_dec_int(timer));
     }
 
     if (timer != 0) {
@@ -1049,6 +1071,26 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
                         if (!recon && field_mode.selected_index_value() != SPEC_MODULATION)
                             audio_output_start();
                     }
+                    // singles are handed to the channelizer once per loop, the other entries are stepped as usual
+                    if (entry_has_changed && recon && fast_scan && !manual_mode && !stepper && !index_stepper && !(has_looped && !continuous)) {
+                        if (has_looped)
+                            fast_scan_pass_done = false;
+                        if (fast_scan_covers(current_index)) {
+                            if (!fast_scan_pass_done && fast_scan_start()) {
+                                recon_redraw();
+                                return;
+                            }
+                            if (fast_scan_skip_covered()) {
+                                fast_scan_pass_done = false;
+                                if (!continuous) {
+                                    has_looped = true;
+                                } else if (fast_scan_start()) {
+                                    recon_redraw();
+                                    return;
+                                }
+                            }
+                        }
+                    }
                     // reload entry if changed
                     if (entry_has_changed) {
                         timer = 0;
@@ -1094,6 +1136,9 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
 }
 
 void ReconView::recon_pause() {
+    // No audio from the channelizer, so pause on the cluster's first entry.
+    if (fast_scan_active)
+        fast_scan_stop(fast_scan_clusters.members()[fast_scan_clusters.current().first].index);
     timer = 0;
     freq_lock = 0;
     recon = false;
@@ -1118,6 +1163,8 @@ void ReconView::recon_resume() {
 }
 
 void ReconView::on_index_delta(int32_t v) {
+    if (fast_scan_active)
+        fast_scan_stop(fast_scan_clusters.members()[fast_scan_clusters.current().first].index);
     if (v > 0) {
         fwd = true;
         button_dir.set_text("FW>");
@@ -1134,6 +1181,8 @@ void ReconView::on_index_delta(int32_t v) {
 }
 
 void ReconView::on_stepper_delta(int32_t v) {
+    if (fast_scan_active)
+        fast_scan_stop(fast_scan_clusters.members()[fast_scan_clusters.current().first].index);
     if (v > 0) {
         fwd = true;
         button_dir.set_text("FW>");
@@ -1152,6 +1201,8 @@ void ReconView::on_stepper_delta(int32_t v) {
 size_t ReconView::change_mode(freqman_index_t new_mod) {
     if (recon_tx || is_repeat_active() || is_recording)
         return 0;
+    // Any demodulator image ends a fast scan.
+    fast_scan_active = false;
     field_mode.on_change = [this](size_t, OptionsField::value_t) {};
     field_bw.on_change = [this](size_t, OptionsField::value_t) {};
     recon_stop_recording(false);
@@ -1273,8 +1324,152 @@ size_t ReconView::change_mode(freqman_index_t new_mod) {
     return freqman_entry_get_step_value(def_step);
 }
 
+bool ReconView::fast_scan_start() {
+    if (recon_tx || is_repeat_active() || is_recording)
+        return false;
+
+    if (!fast_scan_clusters.valid())
+        fast_scan_clusters.build(frequency_list, fast_scan_sampling_rate);
+    if (fast_scan_clusters.empty())
+        return false;
+
+    if (fast_scan_advance) {
+        fast_scan_clusters.next();
+        fast_scan_advance = false;
+    } else {
+        fast_scan_clusters.clear_matches();
+    }
+
+    recon_stop_recording(false);
+    if (field_mode.selected_index_value() != SPEC_MODULATION)
+        audio::output::stop();
+
+    receiver_model.disable();
+    baseband::shutdown();
+    baseband::run_image(portapack::spi_flash::image_tag_channelizer);
+    receiver_model.set_sampling_rate(fast_scan_sampling_rate);
+    receiver_model.set_baseband_bandwidth(filter_bandwidth_for_sampling_rate(fast_scan_sampling_rate));
+    baseband::set_channelizer(fast_scan_sampling_rate, clip<int32_t>(squelch, INT8_MIN, 0));
+    receiver_model.enable();
+
+    fast_scan_active = true;
+    // The demodulator has to be reloaded when leaving, whatever the entry's modulation.
+    last_entry.modulation = freqman_invalid_index;
+    last_entry.bandwidth = freqman_invalid_index;
+    fast_scan_retune();
+    return true;
+}
+
+void ReconView::fast_scan_retune() {
+    const auto& cluster = fast_scan_clusters.current();
+    freq = cluster.center;
+    last_freq = freq;
+    receiver_model.set_target_frequency(freq);
+    count_retune();
+
+    fast_scan_timer = recon_lock_duration;
+    timer = 0;
+    freq_lock = 0;
+    status = 0;
+    chrono_start = chTimeNow();
+
+    desc_cycle.set("FAST " + to_string_dec_uint(fast_scan_clusters.position() + 1) + "/" + to_string_dec_uint(fast_scan_clusters.size()) + ": " + to_string_dec_uint(cluster.count) + " freqs");
+}
+
+void ReconView::fast_scan_stop(const size_t index) {
+    fast_scan_active = false;
+    fast_scan_advance = true;
+    current_index = index;
+
+    const auto& entry = current_entry();
+    const freqman_index_t mod = is_valid(entry.modulation) ? entry.modulation : field_mode.selected_index_value();
+    change_mode(mod);
+    last_entry.modulation = mod;
+    last_entry.bandwidth = freqman_invalid_index;
+    last_index = -1;
+
+    freq = entry.frequency_a;
+    last_freq = 0;
+    handle_retune();
+}
+
+void ReconView::fast_scan_leave() {
+    // Hand over to the next stepped entry; the next pass starts from the first cluster.
+    const auto position = current_index;
+    fast_scan_skip_covered();
+    const auto index = current_index;
+    current_index = position;
+    fast_scan_stop(index);
+    fast_scan_advance = false;
+    timer = 0;
+    freq_lock = 0;
+    status = 0;
+}
+
+bool ReconView::fast_scan_covers(const size_t index) {
+    if (!fast_scan_clusters.valid())
+        fast_scan_clusters.build(frequency_list, fast_scan_sampling_rate);
+    return fast_scan_clusters.covers(index);
+}
+
+bool ReconView::fast_scan_skip_covered() {
+    // Steps over the entries the channelizer watches. Returns true if the list looped.
+    bool looped = false;
+    for (size_t n = 0; (n < frequency_list.size()) && fast_scan_covers(current_index); n++) {
+        if (fwd) {
+            if ((uint32_t)++current_index >= frequency_list.size()) {
+                current_index = 0;
+                looped = true;
+            }
+        } else {
+            if (--current_index < 0) {
+                current_index = frequency_list.size() - 1;
+                looped = true;
+            }
+        }
+    }
+    return looped;
+}
+
+void ReconView::on_channelizer_activity(const ChannelizerActivityMessage& message) {
+    if (!fast_scan_active || !recon)
+        return;
+
+    chrono_end = chTimeNow();
+    const systime_t time_interval = chrono_end - chrono_start;
+    chrono_start = chrono_end;
+
+    db = fast_scan_clusters.peak_db(message);
+
+    const auto locked = fast_scan_clusters.on_activity(message, recon_lock_nb_match, recon_match_mode == RECON_MATCH_CONTINUOUS);
+    if (locked >= 0) {
+        // The channelizer already counted the matches, the demodulator only has to confirm one.
+        fast_scan_stop(locked);
+        freq_lock = recon_lock_nb_match - 1;
+        timer = recon_lock_duration;
+        recon_redraw();
+        return;
+    }
+
+    fast_scan_timer -= time_interval;
+    if (fast_scan_timer <= 0) {
+        const bool looped = fast_scan_clusters.next();
+        if (looped && (fast_scan_clusters.covered_count() < frequency_list.size())) {
+            // Every cluster had its dwell, the stepped entries are next.
+            fast_scan_pass_done = true;
+            fast_scan_leave();
+            recon_redraw();
+            return;
+        }
+        fast_scan_retune();
+        if (looped && !continuous)
+            recon_pause();
+    }
+    recon_redraw();
+}
+
 void ReconView::handle_coded_squelch(const uint32_t value) {
-    if (field_mode.selected_index() == NFM_MODULATION)
+    if (value && field_mode.selected_index() == NFM_MODULATION)
         text_ctcss.set(tone_key_string_by_value(value, text_ctcss.parent_rect().width() / 8));
     else
         text_ctcss.set("        ");
@@ -1284,12 +1479,13 @@ void ReconView::handle_remove_current_item() {
     if (frequency_list.empty() || !current_is_valid())
         return;
 
-    auto entry = current_entry();  // Copy the current entry.
+    auto entry = frequency_list.entry(current_index);
 
     // In Scanner or Recon modes, remove from the in-memory list.
     if (mode() != recon_mode::Manual) {
         if (current_is_valid()) {
-            frequency_list.erase(frequency_list.begin() + current_index);
+            frequency_list.erase(current_index);
+            fast_scan_clusters.invalidate();
         }
     }
 
@@ -1306,8 +1502,7 @@ void ReconView::handle_remove_current_item() {
     if (frequency_list.size() > 0) {
         current_index = clip<int32_t>(current_index, 0u, frequency_list.size() - 1);
         text_cycle.set_text(to_string_dec_uint(current_index + 1, 3));
-        entry = current_entry();
-        freq = entry.frequency_a;
+        freq = current_entry().frequency_a;
     } else {
         current_index = 0;
         text_cycle.set_text(" ");
@@ -1454,7 +1649,6 @@ void ReconView::stop_repeat(const bool do_loop) {
         }
         reload_restart_recon();
         progressbar.hidden(true);
-        set_dirty();  // fix progressbar no hiding
     }
 }
 
@@ -47,6 +47,7 @@
 #include "ui_navigation.hpp"
 #include "ui_freq_field.hpp"
 #include "ui_spectrum.hpp"
+#include "recon_fast_scan.hpp"
 
 #include <string>
 #include <memory>
@@ -109,9 +110,19 @@ class ReconView : public View {
     // placeholder for possible void recon_start_recording();
     void recon_stop_recording(bool exiting);
 
+    // Fast scan: watch a cluster of single entries at once with the channelizer image.
+    bool fast_scan_start();
+    void fast_scan_retune();
+    void fast_scan_stop(const size_t index);
+    void fast_scan_leave();
+    bool fast_scan_covers(const size_t index);
+    bool fast_scan_skip_covered();
+    void on_channelizer_activity(const ChannelizerActivityMessage& message);
+    void count_retune();
+
     // Returns true if 'current_index' is in bounds of frequency_list.
     bool current_is_valid();
-    freqman_entry& current_entry();
+    const freqman_record& current_entry() const;
 
     // TODO: consolidate mode bools and use recon_mode.
     recon_mode mode() const {
@@ -178,6 +189,17 @@ class ReconView : public View {
     systime_t chrono_start{};
     systime_t chrono_end{};
 
+    static constexpr uint32_t fast_scan_sampling_rate = 4000000;
+    bool fast_scan{false};
+    bool fast_scan_active{false};
+    bool fast_scan_advance{false};
+    bool fast_scan_pass_done{false};  // Clusters watched since the list last looped, stepped entries are due.
+    int32_t fast_scan_timer{0};
+    ReconFastScan fast_scan_clusters{};
+    uint32_t retune_count{0};
+    uint32_t last_retune_rate{UINT32_MAX};
+    systime_t retune_window_start{};
+
     const std::filesystem::path repeat_rec_file = u"RECON_REPEAT.C16";
     const std::filesystem::path repeat_rec_meta = u"RECON_REPEAT.TXT";
     const size_t repeat_read_size{16384};
@@ -272,10 +294,15 @@ class ReconView : public View {
         {0, 6 * 16, 21 * 8, 16},
     };
 
-    // TIMER: 9999
+    // T:9999
     Text text_timer{
         // Show frequency stats in text mode
-        {0, 7 * 16, 11 * 8, 16},
+        {0, 7 * 16, 6 * 8, 16},
+    };
+
+    // R/s:99 => retunes per second
+    Text text_retune_rate{
+        {7 * 8, 7 * 16, 7 * 8, 16},
     };
 
     // T: Senn. 32.000k
@@ -410,6 +437,12 @@ class ReconView : public View {
             on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
         }};
 
+    MessageHandlerRegistration message_handler_channelizer_activity{
+        Message::ID::ChannelizerActivity,
+        [this](const Message* const p) {
+            on_channelizer_activity(*reinterpret_cast<const ChannelizerActivityMessage*>(p));
+        }};
+
     MessageHandlerRegistration message_handler_replay_thread_error{
         Message::ID::ReplayThreadDone,
         [this](const Message* p) {
@@ -103,6 +103,7 @@ void ReconSetupViewMore::save() {
     persistent_memory::set_recon_load_repeaters(checkbox_load_repeaters.value());
     persistent_memory::set_recon_update_ranges_when_recon(checkbox_update_ranges_when_recon.value());
     persistent_memory::set_recon_auto_record_locked(checkbox_auto_record_locked.value());
+    persistent_memory::set_recon_fast_scan(checkbox_fast_scan.value());
     persistent_memory::set_recon_repeat_recorded(checkbox_repeat_recorded.value());
     persistent_memory::set_recon_repeat_recorded_file_mode(field_repeat_file_mode.selected_index_value());
     persistent_memory::set_recon_repeat_nb(field_repeat_nb.value());
@@ -123,6 +124,7 @@ ReconSetupViewMore::ReconSetupViewMore(NavigationView& nav, Rect parent_rect)
     add_children({&checkbox_load_freqs,
                   &checkbox_load_repeaters,
                   &checkbox_load_ranges,
+                  &checkbox_fast_scan,
                   &checkbox_load_hamradios,
                   &checkbox_update_ranges_when_recon,
                   &checkbox_auto_record_locked,
@@ -153,6 +155,7 @@ ReconSetupViewMore::ReconSetupViewMore(NavigationView& nav, Rect parent_rect)
     checkbox_load_hamradios.set_value(persistent_memory::recon_load_hamradios());
     checkbox_update_ranges_when_recon.set_value(persistent_memory::recon_update_ranges_when_recon());
     checkbox_auto_record_locked.set_value(persistent_memory::recon_auto_record_locked());
+    checkbox_fast_scan.set_value(persistent_memory::recon_fast_scan());
     checkbox_repeat_recorded.set_value(persistent_memory::recon_repeat_recorded());
     field_repeat_file_mode.set_selected_index(persistent_memory::recon_repeat_recorded_file_mode());
     checkbox_repeat_amp.set_value(persistent_memory::recon_repeat_amp());
@@ -130,6 +130,11 @@ class ReconSetupViewMore : public View {
         "load range",
         true};
 
+    Checkbox checkbox_fast_scan{
+        {14 * 8, 42},
+        3,
+        "fast scan"};
+
     Checkbox checkbox_load_hamradios{
         {1 * 8, 72},
         3,
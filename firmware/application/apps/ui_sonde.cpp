@@ -23,6 +23,7 @@
 
 #include "ui_sonde.hpp"
 #include "baseband_api.hpp"
+#include "event_m0.hpp"
 #include "audio.hpp"
 #include "app_settings.hpp"
 #include "file_path.hpp"
@@ -116,9 +117,9 @@ SondeView::SondeView(NavigationView& nav)
     // inject a PitchRSSIConfigureMessage in order to arm
     // the pitch rssi events that will be used by the
     // processor:
-    const PitchRSSIConfigureMessage message{true, 0};
+    PitchRSSIConfigureMessage message{true, 0};
 
-    shared_memory.application_queue.push(message);
+    EventDispatcher::send_message(message);
 
     baseband::set_pitch_rssi(0, true);
 }
@@ -136,8 +136,7 @@ void SubGhzDView::on_data(const SubGhzDDataMessage* data) {
     if (matching_recent != std::end(recent)) {
         // Found within. Move to front of list, increment counter.
         (*matching_recent).reset_age();
-        recent.push_front(*matching_recent);
-        recent.erase(matching_recent);
+        recent.move_to_front(matching_recent);
     } else {
         recent.emplace_front(key);
         truncate_entries(recent, 64);
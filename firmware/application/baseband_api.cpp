@@ -297,6 +297,13 @@ void set_adsb() {
     send_message(&message);
 }
 
+void set_ais(const bool dual_channel, const ais::Channel channel) {
+    const AISConfigureMessage message{
+        dual_channel,
+        channel};
+    send_message(&message);
+}
+
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed) {
     const JammerConfigureMessage message{
         run,
@@ -311,9 +318,15 @@ void set_rds_data(const uint16_t message_length) {
     send_message(&message);
 }
 
-void set_spectrum(const size_t sampling_rate, const size_t trigger) {
+void set_spectrum(const size_t sampling_rate, const size_t trigger, const WidebandSpectrumConfigMessage::Window window, const uint8_t overlap) {
     const WidebandSpectrumConfigMessage message{
-        sampling_rate, trigger};
+        sampling_rate, trigger, window, overlap};
+    send_message(&message);
+}
+
+void set_channelizer(const uint32_t sampling_rate, const int8_t squelch_db, const uint8_t hysteresis_db, const uint8_t report_interval_ms) {
+    const ChannelizerConfigMessage message{
+        sampling_rate, squelch_db, hysteresis_db, report_interval_ms};
     send_message(&message);
 }
 
@@ -410,6 +423,7 @@ void shutdown() {
     send_message(&message);
 
     shared_memory.application_queue.reset();
+    shared_memory.packet_batch.reset();
 
     baseband_image_running = false;
 }
@@ -420,12 +434,25 @@ void spectrum_streaming_start() {
     send_message(&message);
 }
 
+void spectrum_streaming_zoom(const int32_t offset, const uint32_t decimation) {
+    SpectrumStreamingConfigMessage message{
+        SpectrumStreamingConfigMessage::Mode::Zoom,
+        offset,
+        decimation};
+    send_message(&message);
+}
+
 void spectrum_streaming_stop() {
     SpectrumStreamingConfigMessage message{
         SpectrumStreamingConfigMessage::Mode::Stopped};
     send_message(&message);
 }
 
+void set_spectrum_accumulation(const SpectrumAccumulationConfigMessage::Mode mode, const uint8_t frames) {
+    SpectrumAccumulationConfigMessage message{mode, frames};
+    send_message(&message);
+}
+
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate) {
     SampleRateConfigMessage message{sample_rate, oversample_rate};
     send_message(&message);
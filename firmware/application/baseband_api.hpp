@@ -93,9 +93,11 @@ void kill_ook();
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift, const uint32_t progress_notice);
 void set_pocsag();
 void set_adsb();
+void set_ais(const bool dual_channel, const ais::Channel channel);
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed);
 void set_rds_data(const uint16_t message_length);
-void set_spectrum(const size_t sampling_rate, const size_t trigger);
+void set_spectrum(const size_t sampling_rate, const size_t trigger, const WidebandSpectrumConfigMessage::Window window = WidebandSpectrumConfigMessage::Window::Hann, const uint8_t overlap = 50);
+void set_channelizer(const uint32_t sampling_rate, const int8_t squelch_db, const uint8_t hysteresis_db = 3, const uint8_t report_interval_ms = 20);
 void set_siggen_tone(const uint32_t tone);
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration);
 void set_spectrum_painter_config(const uint16_t width, const uint16_t height, bool update, int32_t bw);
@@ -113,7 +115,9 @@ void run_prepared_image(const uint32_t m4_code);
 void shutdown();
 
 void spectrum_streaming_start();
+void spectrum_streaming_zoom(const int32_t offset, const uint32_t decimation);
 void spectrum_streaming_stop();
+void set_spectrum_accumulation(const SpectrumAccumulationConfigMessage::Mode mode, const uint8_t frames);
 
 /* NB: sample_rate should be desired rate. Don't pre-scale. */
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate = OversampleRate::None);
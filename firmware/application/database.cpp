@@ -23,84 +23,96 @@
  */
 
 #include "database.hpp"
+#include "database_index.hpp"
 #include "file.hpp"
 #include "file_path.hpp"
+#include <array>
 #include <cstring>
+#include <memory>
 
-int database::retrieve_mid_record(MidDBRecord* record, std::string search_term) {
-    file_path = ais_dir / u"mids.db";
-    index_item_length = 4;
-    record_length = 32;
+namespace {
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+using Index = DatabaseIndex<File>;
 
-    return (result);
-}
+struct OpenDatabase {
+    std::filesystem::path path{};
+    File file{};
+    std::unique_ptr<Index> index{};
+};
 
-int database::retrieve_airline_record(AirlinesDBRecord* record, std::string search_term) {
-    file_path = adsb_dir / u"airlines.db";
-    index_item_length = 4;
-    record_length = 64;
+// One slot per database file: mids, airlines, icao24, macaddress.
+std::array<OpenDatabase, 4> open_databases{};
+
+OpenDatabase* open_database(const std::filesystem::path& path, int index_item_length, int record_length) {
+    OpenDatabase* free_slot = nullptr;
+    for (auto& db : open_databases) {
+        if (db.index && db.path == path)
+            return &db;
+        if (!db.index && !free_slot)
+            free_slot = &db;
+    }
+
+    if (!free_slot)
+        return nullptr;
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+    auto error = free_slot->file.open(path);
+    if (error.is_valid())
+        return nullptr;
 
-    return (result);
+    free_slot->path = path;
+    free_slot->index = std::make_unique<Index>(free_slot->file, index_item_length, record_length);
+    return free_slot;
 }
 
-int database::retrieve_aircraft_record(AircraftDBRecord* record, std::string search_term) {
-    file_path = adsb_dir / u"icao24.db";
-    index_item_length = 7;
-    record_length = 146;
+void close_database(OpenDatabase& db) {
+    db.index.reset();
+    db.file.close();
+    db.path = {};
+}
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+} /* namespace */
 
-    return (result);
+int database::retrieve_mid_record(MidDBRecord* record, std::string search_term) {
+    return retrieve_record(ais_dir / u"mids.db", 4, 32, record, search_term);
 }
 
-int database::retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term) {
-    file_path = macaddress_dir / u"macaddress.db";
-    index_item_length = 7;
-    record_length = 64;
+int database::retrieve_airline_record(AirlinesDBRecord* record, std::string search_term) {
+    return retrieve_record(adsb_dir / u"airlines.db", 4, 64, record, search_term);
+}
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+int database::retrieve_aircraft_record(AircraftDBRecord* record, std::string search_term) {
+    return retrieve_record(adsb_dir / u"icao24.db", 7, 146, record, search_term);
+}
 
-    return (result);
+int database::retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term) {
+    return retrieve_record(macaddress_dir / u"macaddress.db", 7, 64, record, search_term);
+}
+
+void database::close_all() {
+    for (auto& db : open_databases) {
+        if (db.index)
+            close_database(db);
+    }
 }
 
 int database::retrieve_record(std::filesystem::path file_path, int index_item_length, int record_length, void* record, std::string search_term) {
     if (search_term.empty())
         return DATABASE_RECORD_NOT_FOUND;
 
-    auto result = db_file.open(file_path);
-    if (!result.is_valid()) {
-        number_of_records = (db_file.size() / (index_item_length + record_length));  // determine number of records in file
-                                                                                     // binary search tree
-        int first = 0,                                                               // First search element
-            last = number_of_records - 1,                                            // Last search element
-            middle,                                                                  // Mid point of search
-            position = -1;                                                           // Position of search value
-
-        while (!found && first <= last) {
-            middle = (first + last) / 2;  // Calculate mid point
-            db_file.seek(middle * index_item_length);
-            db_file.read(file_buffer, search_term.length());
-            if (file_buffer == search_term) {  // If value is found at mid
-                found = true;
-                position = middle;
-            } else if (file_buffer > search_term)  // If value is in lower half
-                last = middle - 1;
-            else
-                first = middle + 1;  // If value is in upper half
-        }
-
-        if (found == true) {
-            db_file.seek((number_of_records * index_item_length) + (position * record_length));  // seek starting after index
-            db_file.read(record, record_length);
-            return (DATABASE_RECORD_FOUND);
-        } else {
-            return (DATABASE_RECORD_NOT_FOUND);
-        }
-
-    } else
-        return (DATABASE_NOT_FOUND);
+    auto db = open_database(file_path, index_item_length, record_length);
+    if (!db)
+        return DATABASE_NOT_FOUND;
+
+    switch (db->index->find(search_term, record)) {
+        case Index::Lookup::Found:
+            return DATABASE_RECORD_FOUND;
+
+        case Index::Lookup::NotFound:
+            return DATABASE_RECORD_NOT_FOUND;
+
+        default:
+            // Card removed or file changed under us; reopen on the next lookup.
+            close_database(*db);
+            return DATABASE_NOT_FOUND;
+    }
 }
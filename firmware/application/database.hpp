@@ -67,20 +67,11 @@ class database {
 
     int retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term);
 
-   private:
-    std::filesystem::path file_path = "";  // path including filename
-    int index_item_length = 0;             // length of index item
-    int record_length = 0;                 // length of record
-
-    File db_file{};
-    int number_of_records = 0;
-    int position = 0;
-
-    char file_buffer[32]{0};
-    bool found = false;
-
-    int result = 0;
+    // Databases stay open with their index and lookup cache between lookups.
+    // Apps using them call this on exit to give the RAM back.
+    static void close_all();
 
+   private:
     int retrieve_record(std::filesystem::path file_path, int index_item_length, int record_length, void* record, std::string search_term);
 };
 
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DATABASE_INDEX_H__
+#define __DATABASE_INDEX_H__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/* Sparse-indexed, cached lookups in a sorted .db file.
+ *
+ * A .db file holds N fixed width keys in sorted order, followed by N fixed
+ * width records in the same order. Every Nth key is kept in RAM, so a lookup
+ * only has to search one short run of keys on disk: single key probes while
+ * the run is longer than a page, then one read for the rest. Recent results,
+ * misses included, are answered from a small LRU cache without touching
+ * the file.
+ *
+ * FileType requires the following members
+ * Size size()
+ * Result<Size> read(void* data, Size bytes_to_read)
+ * Result<Offset> seek(uint32_t offset)
+ */
+template <typename FileType>
+class DatabaseIndex {
+   public:
+    enum class Lookup : uint8_t {
+        Found,
+        NotFound,
+        ReadError,
+    };
+
+    static constexpr size_t sparse_index_bytes = 2048;
+    static constexpr size_t page_bytes = 512;
+    static constexpr size_t cache_size = 8;
+    static constexpr size_t key_length_max = 8;
+
+    DatabaseIndex(FileType& file, size_t key_length, size_t record_length)
+        : file_{file},
+          key_length_{key_length},
+          record_length_{record_length},
+          cache_records_(cache_size * record_length) {
+    }
+
+    /* Copies the record for key into record. Keys compare on the first
+     * key.size() bytes of the stored key, as the original lookup did. */
+    Lookup find(const std::string& key, void* record) {
+        if (key.empty() || key.size() > key_length_ || key.size() > key_length_max)
+            return Lookup::NotFound;
+
+        auto cached = cache_find(key);
+        if (cached != cache_.end()) {
+            cached->last_used = ++tick_;
+            if (!cached->found)
+                return Lookup::NotFound;
+
+            memcpy(record, cache_record(cached), record_length_);
+            return Lookup::Found;
+        }
+
+        if (!built_ && !build())
+            return Lookup::ReadError;
+
+        size_t position = 0;
+        auto result = search(key, position);
+        if (result == Lookup::Found) {
+            if (!read_at(count_ * key_length_ + position * record_length_, record, record_length_))
+                return Lookup::ReadError;
+        }
+
+        if (result != Lookup::ReadError)
+            cache_insert(key, result == Lookup::Found, record);
+
+        return result;
+    }
+
+    size_t count() const { return count_; }
+    size_t stride() const { return stride_; }
+
+    /* Number of file reads so far, including building the index. */
+    size_t reads() const { return reads_; }
+
+   private:
+    struct CacheEntry {
+        char key[key_length_max];
+        uint8_t key_size;
+        bool found;
+        uint32_t last_used;
+    };
+
+    FileType& file_;
+    const size_t key_length_;
+    const size_t record_length_;
+
+    size_t count_{0};
+    size_t stride_{1};
+    size_t sparse_count_{0};
+    bool built_{false};
+    std::vector<char> sparse_{};
+    std::vector<char> page_{};
+
+    std::array<CacheEntry, cache_size> cache_{};
+    std::vector<uint8_t> cache_records_;
+    uint32_t tick_{0};
+    size_t reads_{0};
+
+    bool read_at(size_t offset, void* data, size_t length) {
+        reads_++;
+        if (file_.seek(offset).is_error())
+            return false;
+
+        auto result = file_.read(data, length);
+        return result.is_ok() && *result == length;
+    }
+
+    const char* sparse_key(size_t index) const {
+        return &sparse_[index * key_length_];
+    }
+
+    /* Reads every stride'th key into the sparse index. Small stride reads the
+     * key table sequentially a page at a time; large stride seeks per key. */
+    bool build() {
+        const size_t max_keys = std::max<size_t>(1, sparse_index_bytes / key_length_);
+        count_ = file_.size() / (key_length_ + record_length_);
+        stride_ = std::max<size_t>(1, (count_ + max_keys - 1) / max_keys);
+        sparse_count_ = (count_ + stride_ - 1) / stride_;
+        sparse_.resize(sparse_count_ * key_length_);
+        page_.resize(std::max(page_bytes, key_length_));
+
+        const size_t stride_bytes = stride_ * key_length_;
+        if (stride_bytes <= page_bytes) {
+            const size_t strides_per_page = page_bytes / stride_bytes;
+            for (size_t i = 0; i < sparse_count_; i += strides_per_page) {
+                const size_t n = std::min(strides_per_page, sparse_count_ - i);
+                const size_t length = std::min((n - 1) * stride_bytes + key_length_, count_ * key_length_ - i * stride_bytes);
+                if (!read_at(i * stride_bytes, page_.data(), length))
+                    return false;
+
+                for (size_t j = 0; j < n; j++)
+                    memcpy(&sparse_[(i + j) * key_length_], &page_[j * stride_bytes], key_length_);
+            }
+        } else {
+            for (size_t i = 0; i < sparse_count_; i++) {
+                if (!read_at(i * stride_bytes, &sparse_[i * key_length_], key_length_))
+                    return false;
+            }
+        }
+
+        built_ = true;
+        return true;
+    }
+
+    Lookup search(const std::string& key, size_t& position) {
+        const char* const k = key.data();
+        const size_t n = key.size();
+
+        // First sparse key that sorts after the search key.
+        size_t lo = 0;
+        size_t hi = sparse_count_;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (memcmp(sparse_key(mid), k, n) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if (lo == 0)
+            return Lookup::NotFound;
+
+        const size_t block = lo - 1;
+        if (memcmp(sparse_key(block), k, n) == 0) {
+            position = block * stride_;
+            return Lookup::Found;
+        }
+
+        // The key can only be in the run between two sparse keys.
+        size_t first = block * stride_ + 1;
+        size_t last = std::min(first - 1 + stride_, count_);
+        const size_t page_keys = std::max<size_t>(1, page_bytes / key_length_);
+
+        while (last - first > page_keys) {
+            const size_t mid = first + (last - first) / 2;
+            if (!read_at(mid * key_length_, page_.data(), key_length_))
+                return Lookup::ReadError;
+
+            const int c = memcmp(page_.data(), k, n);
+            if (c == 0) {
+                position = mid;
+                return Lookup::Found;
+            } else if (c < 0) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+
+        if (first >= last)
+            return Lookup::NotFound;
+
+        if (!read_at(first * key_length_, page_.data(), (last - first) * key_length_))
+            return Lookup::ReadError;
+
+        size_t l = 0;
+        size_t h = last - first;
+        while (l < h) {
+            const size_t mid = (l + h) / 2;
+            const int c = memcmp(&page_[mid * key_length_], k, n);
+            if (c == 0) {
+                position = first + mid;
+                return Lookup::Found;
+            } else if (c < 0) {
+                l = mid + 1;
+            } else {
+                h = mid;
+            }
+        }
+
+        return Lookup::NotFound;
+    }
+
+    uint8_t* cache_record(typename std::array<CacheEntry, cache_size>::iterator entry) {
+        return &cache_records_[(entry - cache_.begin()) * record_length_];
+    }
+
+    typename std::array<CacheEntry, cache_size>::iterator cache_find(const std::string& key) {
+        return std::find_if(cache_.begin(), cache_.end(), [&key](const CacheEntry& e) {
+            return e.last_used && e.key_size == key.size() && memcmp(e.key, key.data(), key.size()) == 0;
+        });
+    }
+
+    void cache_insert(const std::string& key, bool found, const void* record) {
+        auto entry = std::min_element(cache_.begin(), cache_.end(), [](const CacheEntry& a, const CacheEntry& b) {
+            return a.last_used < b.last_used;
+        });
+
+        memcpy(entry->key, key.data(), key.size());
+        entry->key_size = key.size();
+        entry->found = found;
+        entry->last_used = ++tick_;
+        if (found)
+            memcpy(cache_record(entry), record, record_length_);
+    }
+};
+
+#endif /*__DATABASE_INDEX_H__*/
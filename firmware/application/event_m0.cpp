@@ -200,6 +200,11 @@ void EventDispatcher::handle_application_queue() {
     shared_memory.application_queue.handle([](Message* const message) {
         message_map.send(message);
     });
+
+    // Decoded packets, in one pass however many arrived since the last wakeup.
+    shared_memory.packet_batch.handle([](Message* const message) {
+        message_map.send(message);
+    });
 }
 
 void EventDispatcher::handle_local_queue() {
@@ -324,6 +329,10 @@ ui::Widget* EventDispatcher::getTopWidget() {
     return top_widget;
 }
 
+ui::Painter& EventDispatcher::getPainter() {
+    return painter;
+}
+
 ui::Widget* EventDispatcher::getFocusedWidget() {
     return context.focus_manager().focus_widget();
 }
@@ -336,6 +345,7 @@ void EventDispatcher::handle_lcd_frame_sync() {
 
     static_cast<ui::SystemView*>(top_widget)->paint_overlay();
     painter.paint_widget_tree(top_widget);
+    painter.end_frame();
 
     portapack::backlight()->on();
 
@@ -64,7 +64,7 @@ class EventDispatcher {
     static void set_display_sleep(const bool sleep);
 
     static inline void check_fifo_isr() {
-        if (!shared_memory.application_queue.is_empty()) {
+        if (!shared_memory.application_queue.is_empty() || !shared_memory.packet_batch.is_empty()) {
             events_flag_isr(EVT_MASK_APPLICATION);
         }
     }
@@ -96,6 +96,7 @@ class EventDispatcher {
 
     ui::Widget* getTopWidget();
     ui::Widget* getFocusedWidget();
+    ui::Painter& getPainter();
 
    private:
     static Thread* thread_event_loop;
@@ -38,6 +38,14 @@
 
 #include "tpms_packet.hpp"
 
+namespace tpms {
+
+inline uint32_t recent_entries_hash(const TransponderID& id) {
+    return ::recent_entries_hash(id.value());
+}
+
+} /* namespace tpms */
+
 namespace ui::external_app::tpmsrx {
 
 namespace format {
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __EXTERNAL_APP_MANIFEST_H__
+#define __EXTERNAL_APP_MANIFEST_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "file.hpp"
+
+/* RAM copy of the headers of the external apps on the SD card.
+ *
+ * Each entry is keyed by file name, size and FAT timestamp. A rebuild takes
+ * a plain directory listing (no files opened) and only reads the header of
+ * files that are new or whose size or timestamp changed; everything else is
+ * carried over. The whole list can be saved to and loaded from a small cache
+ * file so a cold start doesn't have to open every app either.
+ *
+ * FileType requires the following members
+ * Result<Size> read(void* data, Size bytes_to_read)
+ * Result<Size> write(const void* data, Size bytes_to_write)
+ */
+class ExternalAppManifest {
+   public:
+    enum class Kind : uint8_t {
+        External = 0,   // .ppma
+        Standalone = 1  // .ppmp
+    };
+
+    /* Serialized as is, followed by name_length UTF-16 code units. */
+    struct Record {
+        uint32_t file_size;
+        uint32_t file_time;  // FAT date << 16 | FAT time
+        uint32_t header_version;
+        uint32_t app_version;
+        uint32_t icon_color;
+        int32_t desired_position;
+        uint32_t menu_location;
+        uint32_t checksum;  // image checksum seen at the last launch
+        Kind kind;
+        uint8_t checksum_known;
+        uint16_t name_length;
+        uint8_t app_name[16];
+        uint8_t bitmap_data[32];
+    };
+
+    struct Entry {
+        std::filesystem::path file_name{};
+        Record record{};
+    };
+
+    /* One file from the directory listing. */
+    struct ScanItem {
+        std::filesystem::path file_name;
+        uint32_t file_size;
+        uint32_t file_time;
+        Kind kind;
+    };
+
+    static constexpr uint32_t magic = 0x4d415050;  // "PPAM"
+    static constexpr uint32_t format_version = 1;
+    static constexpr size_t name_length_max = 255;
+
+    static uint32_t pack_time(const uint16_t fat_date, const uint16_t fat_time) {
+        return (static_cast<uint32_t>(fat_date) << 16) | fat_time;
+    }
+
+    const std::vector<Entry>& entries() const { return entries_; }
+    bool dirty() const { return dirty_; }
+    size_t headers_read() const { return headers_read_; }
+
+    void clear() {
+        entries_.clear();
+        dirty_ = false;
+    }
+
+    /* Replaces the entry list with one entry per scanned file, in scan order.
+     * read_header(Entry&) is called with file_name, file_size, file_time and
+     * kind filled in, only for files with no matching cached entry, and
+     * returns false if the file should be left out. Returns true if anything
+     * changed. */
+    template <typename ReadHeader>
+    bool rebuild(const std::vector<ScanItem>& scan, ReadHeader read_header) {
+        std::vector<Entry> rebuilt;
+        rebuilt.reserve(scan.size());
+        bool changed = scan.size() != entries_.size();
+
+        for (const auto& item : scan) {
+            auto cached = std::find_if(entries_.begin(), entries_.end(), [&item](const Entry& entry) {
+                return entry.record.kind == item.kind &&
+                       entry.record.file_size == item.file_size &&
+                       entry.record.file_time == item.file_time &&
+                       entry.file_name == item.file_name;
+            });
+
+            if (cached != entries_.end()) {
+                rebuilt.push_back(std::move(*cached));
+                continue;
+            }
+
+            changed = true;
+            Entry entry{};
+            entry.file_name = item.file_name;
+            entry.record.file_size = item.file_size;
+            entry.record.file_time = item.file_time;
+            entry.record.kind = item.kind;
+            headers_read_++;
+            if (read_header(entry))
+                rebuilt.push_back(std::move(entry));
+        }
+
+        entries_ = std::move(rebuilt);
+        dirty_ |= changed;
+        return changed;
+    }
+
+    /* Remembers the checksum of a launched image, so a corrupt file can be
+     * flagged in the menu until it is replaced. */
+    void set_checksum(const std::filesystem::path& file_name, const uint32_t checksum) {
+        for (auto& entry : entries_) {
+            if (entry.file_name == file_name) {
+                if (!entry.record.checksum_known || entry.record.checksum != checksum) {
+                    entry.record.checksum = checksum;
+                    entry.record.checksum_known = 1;
+                    dirty_ = true;
+                }
+                return;
+            }
+        }
+    }
+
+    template <typename FileType>
+    bool save(FileType& file) {
+        const uint32_t header[3] = {magic, format_version, static_cast<uint32_t>(entries_.size())};
+        if (!write_all(file, header, sizeof(header)))
+            return false;
+
+        for (const auto& entry : entries_) {
+            Record record = entry.record;
+            record.name_length = entry.file_name.native().size();
+            if (!write_all(file, &record, sizeof(record)) ||
+                !write_all(file, entry.file_name.c_str(), record.name_length * sizeof(char16_t)))
+                return false;
+        }
+
+        dirty_ = false;
+        return true;
+    }
+
+    /* Replaces the entry list with the saved one. Leaves it empty and
+     * returns false if the file is missing, truncated, from another
+     * format version or claims more records than it can hold. */
+    template <typename FileType>
+    bool load(FileType& file) {
+        clear();
+
+        uint32_t header[3]{};
+        if (!read_all(file, header, sizeof(header)) ||
+            header[0] != magic || header[1] != format_version)
+            return false;
+
+        // Every record takes at least sizeof(Record), so a corrupt count
+        // can't make us reserve more than the file could describe.
+        const uint64_t file_size = file.size();
+        if (file_size < sizeof(header) ||
+            header[2] > (file_size - sizeof(header)) / sizeof(Record))
+            return false;
+
+        std::vector<Entry> loaded;
+        loaded.reserve(header[2]);
+        char16_t name[name_length_max];
+        for (uint32_t i = 0; i < header[2]; i++) {
+            Entry entry{};
+            if (!read_all(file, &entry.record, sizeof(entry.record)) ||
+                entry.record.name_length > name_length_max ||
+                !read_all(file, name, entry.record.name_length * sizeof(char16_t)))
+                return false;
+
+            entry.file_name = std::filesystem::path{name, name + entry.record.name_length};
+            loaded.push_back(std::move(entry));
+        }
+
+        entries_ = std::move(loaded);
+        return true;
+    }
+
+   private:
+    std::vector<Entry> entries_{};
+    bool dirty_{false};
+    size_t headers_read_{0};
+
+    template <typename FileType>
+    static bool read_all(FileType& file, void* data, const size_t length) {
+        if (length == 0)
+            return true;
+        auto result = file.read(data, length);
+        return !result.is_error() && *result == length;
+    }
+
+    template <typename FileType>
+    static bool write_all(FileType& file, const void* data, const size_t length) {
+        if (length == 0)
+            return true;
+        auto result = file.write(data, length);
+        return !result.is_error() && *result == length;
+    }
+};
+
+#endif /*__EXTERNAL_APP_MANIFEST_H__*/
@@ -32,7 +32,16 @@ namespace fs = std::filesystem;
 static const fs::path c8_ext{u".C8"};
 static const fs::path c16_ext{u".C16"};
 
+static uint32_t write_generation = 0;
+
+uint32_t file_write_generation() {
+    return write_generation;
+}
+
 Optional<File::Error> File::open_fatfs(const std::filesystem::path& filename, BYTE mode) {
+    if (mode & FA_WRITE)
+        write_generation++;
+
     auto result = f_open(&f, reinterpret_cast<const TCHAR*>(filename.c_str()), mode);
     if (result == FR_OK) {
         if (mode & FA_OPEN_ALWAYS) {
@@ -292,12 +301,14 @@ std::vector<std::filesystem::path> scan_root_directories(const std::filesystem::
 }
 
 std::filesystem::filesystem_error delete_file(const std::filesystem::path& file_path) {
+    write_generation++;
     return {f_unlink(reinterpret_cast<const TCHAR*>(file_path.c_str()))};
 }
 
 std::filesystem::filesystem_error rename_file(
     const std::filesystem::path& file_path,
     const std::filesystem::path& new_name) {
+    write_generation++;
     return {f_rename(reinterpret_cast<const TCHAR*>(file_path.c_str()), reinterpret_cast<const TCHAR*>(new_name.c_str()))};
 }
 
@@ -340,6 +351,7 @@ FATTimestamp file_created_date(const std::filesystem::path& file_path) {
 std::filesystem::filesystem_error file_update_date(const std::filesystem::path& file_path, FATTimestamp timestamp) {
     FILINFO filinfo{};
 
+    write_generation++;
     filinfo.fdate = timestamp.FAT_date;
     filinfo.ftime = timestamp.FAT_time;
     return f_utime(reinterpret_cast<const TCHAR*>(file_path.c_str()), &filinfo);
@@ -357,6 +369,7 @@ std::filesystem::filesystem_error make_new_file(
 
 std::filesystem::filesystem_error make_new_directory(
     const std::filesystem::path& dir_path) {
+    write_generation++;
     return {f_mkdir(reinterpret_cast<const TCHAR*>(dir_path.c_str()))};
 }
 
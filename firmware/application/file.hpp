@@ -198,6 +198,9 @@ struct directory_entry : public FILINFO {
         return fsize;
     };
 
+    uint16_t fat_date() const { return fdate; }
+    uint16_t fat_time() const { return ftime; }
+
     const std::filesystem::path path() const noexcept { return {fname}; };
 };
 
@@ -272,6 +275,10 @@ std::filesystem::filesystem_error rename_file(const std::filesystem::path& file_
 std::filesystem::filesystem_error copy_file(const std::filesystem::path& file_path, const std::filesystem::path& dest_path);
 
 FATTimestamp file_created_date(const std::filesystem::path& file_path);
+
+/* Bumped whenever a file is opened for writing, deleted, renamed or re-dated,
+ * or a directory is created, so directory caches can tell they may be stale. */
+uint32_t file_write_generation();
 std::filesystem::filesystem_error file_update_date(const std::filesystem::path& file_path, FATTimestamp timestamp);
 std::filesystem::filesystem_error make_new_file(const std::filesystem::path& file_path);
 std::filesystem::filesystem_error make_new_directory(const std::filesystem::path& dir_path);
@@ -26,11 +26,13 @@
 #include "file.hpp"
 #include "file_reader.hpp"
 #include "freqman_db.hpp"
+#include "freqman_index.hpp"
 #include "string_format.hpp"
 #include "tone_key.hpp"
 #include "utility.hpp"
 #include "file_path.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <string_view>
@@ -39,6 +41,7 @@
 namespace fs = std::filesystem;
 
 const std::filesystem::path freqman_extension{u".TXT"};
+const std::filesystem::path freqman_index_extension{u".IDX"};
 
 // NB: Don't include UI headers to keep this code unit testable.
 using option_t = std::pair<std::string_view, int32_t>;
@@ -248,7 +251,9 @@ bool load_freqman_file(const std::string& file_stem, freqman_db& db, freqman_loa
 }
 
 void delete_freqman_file(const std::string& file_stem) {
-    delete_file(get_freqman_path(file_stem));
+    auto path = get_freqman_path(file_stem);
+    delete_file(path);
+    delete_file(path.replace_extension(freqman_index_extension));
 }
 
 std::string pretty_string(const freqman_entry& entry, size_t max_length) {
@@ -413,44 +418,162 @@ bool parse_freqman_entry(std::string_view str, freqman_entry& entry) {
     return is_valid(entry);
 }
 
+void index_freqman_line(std::string_view line, uint32_t offset, freqman_index_record& record) {
+    record = {};
+    record.offset = offset;
+    record.length = std::min<size_t>(line.size(), UINT16_MAX);
+
+    freqman_entry entry{};
+    std::string_view value{};
+    if (parse_freqman_entry(line, entry)) {
+        record.frequency_a = entry.frequency_a;
+        record.frequency_b = entry.frequency_b;
+        record.flags = freqman_index_record::parsed_flag;
+        record.type = entry.type;
+        record.modulation = entry.modulation;
+        record.bandwidth = entry.bandwidth;
+        record.step = entry.step;
+        record.tone = entry.tone;
+
+        // Same column parse_freqman_entry() took the description from.
+        for (auto col : split_string(line, ',')) {
+            auto pair = split_string(col, '=');
+            if (pair.size() == 2 && pair[0] == "d")
+                value = pair[1];
+        }
+    } else {
+        // Raw lines use the whole line as the description.
+        record.type = freqman_type::Unknown;
+        value = line;
+    }
+
+    auto text = trim(value);
+    if (text.empty())
+        return;
+
+    record.description_column = std::min<size_t>(value.data() - line.data() + value.find(text), UINT16_MAX);
+    record.description_length = std::min(text.size(), freqman_max_desc_size);
+}
+
+bool freqman_entry_wanted(const freqman_entry& entry, const freqman_load_options& options) {
+    return !(entry.type == freqman_type::Unknown ||
+             (entry.type == freqman_type::Single && !options.load_freqs) ||
+             (entry.type == freqman_type::Range && !options.load_ranges) ||
+             (entry.type == freqman_type::HamRadio && !options.load_hamradios) ||
+             (entry.type == freqman_type::Repeater && !options.load_repeaters));
+}
+
 bool parse_freqman_file(const fs::path& path, freqman_db& db, freqman_load_options options) {
-    FreqmanDB freqman_db;
-    freqman_db.set_read_raw(false);  // Don't return malformed lines.
-    if (!freqman_db.open(path))
+    File file;
+    if (file.open(path))
         return false;
 
-    // Attempt to avoid a re-alloc if possible.
-    db.clear();
-    db.reserve(freqman_db.entry_count());
-
-    for (auto entry : freqman_db) {
-        // Filter by entry type.
-        if (entry.type == freqman_type::Unknown ||
-            (entry.type == freqman_type::Single && !options.load_freqs) ||
-            (entry.type == freqman_type::Range && !options.load_ranges) ||
-            (entry.type == freqman_type::HamRadio && !options.load_hamradios) ||
-            (entry.type == freqman_type::Repeater && !options.load_repeaters)) {
-            continue;
-        }
+    return parse_freqman_lines(file, db, options);
+}
 
-        // Use previous entry's mod/band if current's aren't set.
-        if (!db.empty()) {
-            if (is_invalid(entry.modulation))
-                entry.modulation = db.back()->modulation;
-            if (is_invalid(entry.bandwidth))
-                entry.bandwidth = db.back()->bandwidth;
-        }
+/* freqman_db ******************************************/
+
+void freqman_db::clear() {
+    blocks_.clear();
+    arena_.clear();
+    size_ = 0;
+    arena_used_ = arena_block_size;
+    interned_.fill({});
+}
 
-        // Move the entry onto the heap and push.
-        db.push_back(std::make_unique<freqman_entry>(std::move(entry)));
+void freqman_db::shrink_to_fit() {
+    blocks_.resize((size_ + block_records - 1) / block_records);
+    blocks_.shrink_to_fit();
+    arena_.shrink_to_fit();
+}
 
-        // Limit to max_entries when specified.
-        if (options.max_entries > 0 && db.size() >= options.max_entries)
-            break;
+std::string_view freqman_db::description(size_t index) const {
+    const auto& r = record(index);
+    if (r.description_length == 0)
+        return {};
+    return {&arena_[r.description_offset / arena_block_size][r.description_offset % arena_block_size], r.description_length};
+}
+
+freqman_entry freqman_db::entry(size_t index) const {
+    const auto& r = record(index);
+    return {
+        .frequency_a = r.frequency_a,
+        .frequency_b = r.frequency_b,
+        .description = std::string{description(index)},
+        .type = r.type,
+        .modulation = r.modulation,
+        .bandwidth = r.bandwidth,
+        .step = r.step,
+        .tone = r.tone,
+    };
+}
+
+void freqman_db::push_back(const freqman_entry& entry) {
+    if (size_ == blocks_.size() * block_records)
+        blocks_.push_back(std::make_unique<freqman_record[]>(block_records));
+
+    mutable_record(size_) = pack(entry);
+    size_++;
+}
+
+void freqman_db::set(size_t index, const freqman_entry& entry) {
+    // The old description stays in the arena until the next clear().
+    mutable_record(index) = pack(entry);
+}
+
+void freqman_db::erase(size_t index) {
+    for (size_t i = index; i + 1 < size_; i++)
+        mutable_record(i) = record(i + 1);
+    size_--;
+}
+
+size_t freqman_db::memory_used() const {
+    return blocks_.size() * block_records * sizeof(freqman_record) +
+           arena_.size() * arena_block_size +
+           blocks_.capacity() * sizeof(blocks_[0]) +
+           arena_.capacity() * sizeof(arena_[0]);
+}
+
+freqman_record freqman_db::pack(const freqman_entry& entry) {
+    const std::string_view text{entry.description.data(), std::min(entry.description.size(), freqman_max_desc_size)};
+    freqman_record r{
+        .frequency_a = entry.frequency_a,
+        .frequency_b = entry.frequency_b,
+        .description_offset = 0,
+        .description_length = static_cast<uint8_t>(text.size()),
+        .type = entry.type,
+        .modulation = entry.modulation,
+        .bandwidth = entry.bandwidth,
+        .step = entry.step,
+        .tone = entry.tone,
+    };
+
+    if (text.empty())
+        return r;
+
+    // FNV-1a, folded to a slot.
+    uint32_t hash = 2166136261u;
+    for (const auto c : text)
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    auto& slot = interned_[hash % interned_slots];
+
+    if (slot.length == text.size() &&
+        std::string_view{&arena_[slot.offset / arena_block_size][slot.offset % arena_block_size], slot.length} == text) {
+        r.description_offset = slot.offset;
+        return r;
     }
 
-    db.shrink_to_fit();
-    return true;
+    // Descriptions never straddle arena blocks.
+    if (arena_used_ + text.size() > arena_block_size) {
+        arena_.push_back(std::make_unique<char[]>(arena_block_size));
+        arena_used_ = 0;
+    }
+    std::copy(text.begin(), text.end(), &arena_.back()[arena_used_]);
+    r.description_offset = (arena_.size() - 1) * arena_block_size + arena_used_;
+    arena_used_ += text.size();
+
+    slot = {r.description_offset, r.description_length};
+    return r;
 }
 
 bool is_valid(const freqman_entry& entry) {
@@ -485,20 +608,69 @@ bool is_valid(const freqman_entry& entry) {
 
 /* FreqmanDB ***********************************/
 
+namespace {
+/* FatFs only keeps the last modified date and time. */
+uint32_t freqman_timestamp(const fs::path& path) {
+    auto timestamp = file_created_date(path);
+    return (static_cast<uint32_t>(timestamp.FAT_date) << 16) | timestamp.FAT_time;
+}
+}  // namespace
+
+FreqmanDB::FreqmanDB() = default;
+FreqmanDB::~FreqmanDB() = default;
+
 bool FreqmanDB::open(const std::filesystem::path& path, bool create) {
-    auto result = FileWrapper::open(path, create);
-    if (!result)
+    close();
+
+    auto file = std::make_unique<File>();
+    if (file->open(path, /*read_only*/ false, create))
         return false;
 
-    wrapper_ = *std::move(result);
-    return true;
+    path_ = path;
+    file_ = std::move(file);
+
+    // Without an index, fall back to scanning the file.
+    return open_index() || wrapper() != nullptr;
 }
 
 void FreqmanDB::close() {
+    index_.reset();
+    index_file_.reset();
     wrapper_.reset();
+    file_.reset();
+    path_ = {};
 }
 
 freqman_entry FreqmanDB::operator[](Index index) const {
+    if (index_) {
+        freqman_index_record record;
+        if (!index_->read(index, record) || (!record.parsed() && !read_raw_))
+            return {};
+
+        freqman_entry entry{};
+        if (record.parsed()) {
+            entry.frequency_a = record.frequency_a;
+            entry.frequency_b = record.frequency_b;
+            entry.type = record.type;
+            entry.modulation = record.modulation;
+            entry.bandwidth = record.bandwidth;
+            entry.step = record.step;
+            entry.tone = record.tone;
+        } else {
+            entry.type = freqman_type::Raw;
+        }
+
+        if (record.description_length > 0) {
+            auto& text = file();
+            entry.description.resize(record.description_length);
+            if (text.seek(record.offset + record.description_column).is_error() ||
+                text.read(&entry.description[0], record.description_length).is_error())
+                entry.description.clear();
+        }
+
+        return entry;
+    }
+
     auto length = wrapper_->line_length(index);
     auto line_text = wrapper_->get_text(index, 0, length);
 
@@ -517,8 +689,12 @@ freqman_entry FreqmanDB::operator[](Index index) const {
 }
 
 void FreqmanDB::insert_entry(Index index, const freqman_entry& entry) {
+    auto w = wrapper();
+    if (!w)
+        return;
+
     index = clip<uint32_t>(index, 0u, entry_count());
-    wrapper_->insert_line(index);
+    w->insert_line(index);
     replace_entry(index, entry);
 }
 
@@ -527,17 +703,31 @@ void FreqmanDB::append_entry(const freqman_entry& entry) {
 }
 
 void FreqmanDB::replace_entry(Index index, const freqman_entry& entry) {
-    auto range = wrapper_->line_range(index);
+    auto w = wrapper();
+    if (!w)
+        return;
+
+    auto range = w->line_range(index);
     if (!range)
         return;
 
     // Don't overwrite the '\n'.
     range->end--;
-    wrapper_->replace_range(*range, to_freqman_string(entry));
+    const auto line = to_freqman_string(entry);
+    w->replace_range(*range, line);
+
+    // An append, or an edit of the last line, leaves every other line where it was.
+    update_index(index, range->start + line.size() + 1 >= file().size());
 }
 
 void FreqmanDB::delete_entry(Index index) {
-    wrapper_->delete_line(index);
+    auto w = wrapper();
+    if (!w)
+        return;
+
+    auto range = w->line_range(index);
+    w->delete_line(index);
+    update_index(index, range && (range->start >= file().size()));
 }
 
 bool FreqmanDB::delete_entry(const freqman_entry& entry) {
@@ -550,6 +740,20 @@ bool FreqmanDB::delete_entry(const freqman_entry& entry) {
 }
 
 FreqmanDB::iterator FreqmanDB::find_entry(const freqman_entry& entry) {
+    if (index_) {
+        // Only read the description of entries that could match.
+        freqman_index_record record;
+        for (Index i = 0; i < entry_count() && index_->read(i, record); i++) {
+            if (record.parsed() && record.type == entry.type &&
+                record.frequency_a == entry.frequency_a &&
+                record.description_length == entry.description.size() &&
+                (*this)[i] == entry)
+                return {*this, i};
+        }
+
+        return end();
+    }
+
     return find_entry([&entry](const auto& other) {
         return entry == other;
     });
@@ -557,11 +761,68 @@ FreqmanDB::iterator FreqmanDB::find_entry(const freqman_entry& entry) {
 
 uint32_t FreqmanDB::entry_count() const {
     // FileWrapper always presents a single line even for empty files.
-    return empty() ? 0u : wrapper_->line_count();
+    if (empty())
+        return 0u;
+
+    return index_ ? index_->count() : wrapper_->line_count();
 }
 
 bool FreqmanDB::empty() const {
     // FileWrapper always presents a single line even for empty files.
     // A DB is only really empty if the file size is 0.
-    return !wrapper_ || wrapper_->size() == 0;
+    return (!file_ && !wrapper_) || file().size() == 0;
+}
+
+bool FreqmanDB::open_index() {
+    auto index_path = path_;
+    index_path.replace_extension(freqman_index_extension);
+
+    index_file_ = std::make_unique<File>();
+    if (index_file_->open(index_path, /*read_only*/ false, /*create*/ true)) {
+        index_file_.reset();
+        return false;
+    }
+
+    const auto timestamp = freqman_timestamp(path_);
+    index_ = std::make_unique<FreqmanIndex<File>>(*index_file_);
+    if (index_->load(file().size(), timestamp) || index_->build(file(), timestamp))
+        return true;
+
+    index_.reset();
+    index_file_.reset();
+    return false;
+}
+
+void FreqmanDB::update_index(Index first, bool tail_only) {
+    if (!index_)
+        return;
+
+    // The line before may have gained or lost its newline.
+    const auto timestamp = freqman_timestamp(path_);
+    if ((tail_only && (first > 0) && index_->update(file(), first - 1, timestamp)) ||
+        index_->build(file(), timestamp))
+        return;
+
+    index_.reset();
+    index_file_.reset();
+}
+
+FileWrapper* FreqmanDB::wrapper() {
+    if (!wrapper_ && file_) {
+        // Hand the file over, two handles on one file don't share a cache.
+        file_.reset();
+        auto result = FileWrapper::open(path_);
+        if (!result) {
+            close();
+            return nullptr;
+        }
+
+        wrapper_ = *std::move(result);
+    }
+
+    return wrapper_.get();
+}
+
+File& FreqmanDB::file() const {
+    return wrapper_ ? wrapper_->file() : *file_;
 }
@@ -26,6 +26,7 @@
 #define __FREQMAN_DB_H__
 
 #include "file.hpp"
+#include "file_reader.hpp"
 #include "file_wrapper.hpp"
 #include "utility.hpp"
 
@@ -37,6 +38,7 @@
 
 /* Defined in freqman_db.cpp */
 extern const std::filesystem::path freqman_extension;
+extern const std::filesystem::path freqman_index_extension;
 
 using freqman_index_t = uint8_t;
 constexpr freqman_index_t freqman_invalid_index = static_cast<freqman_index_t>(-1);
@@ -173,8 +175,78 @@ struct freqman_load_options {
     bool load_repeaters{true};
 };
 
-using freqman_entry_ptr = std::unique_ptr<freqman_entry>;
-using freqman_db = std::vector<freqman_entry_ptr>;
+/* The numeric fields of a freqman_entry, packed. The description is held
+ * in the owning freqman_db's string arena. */
+struct freqman_record {
+    int64_t frequency_a{0};
+    int64_t frequency_b{0};
+    uint32_t description_offset{0};
+    uint8_t description_length{0};
+    freqman_type type{freqman_type::Unknown};
+    freqman_index_t modulation{freqman_invalid_index};
+    freqman_index_t bandwidth{freqman_invalid_index};
+    freqman_index_t step{freqman_invalid_index};
+    freqman_index_t tone{freqman_invalid_index};
+};
+
+/* In-memory list of freqman entries, as loaded by load_freqman_file().
+ * Entries are fixed size records and descriptions are packed into a shared
+ * string arena, both in fixed size blocks. That is a few allocations per
+ * hundred entries instead of one or two per entry, and the list never has
+ * to copy itself to grow, so loading peaks at barely more than the list
+ * itself. Descriptions repeated in the file (and empty ones) are stored
+ * once. */
+class freqman_db {
+   public:
+    static constexpr size_t block_records = 32;
+    static constexpr size_t arena_block_size = 512;
+
+    freqman_db() = default;
+    freqman_db(freqman_db&&) = default;
+    freqman_db& operator=(freqman_db&&) = default;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear();
+    /* Frees blocks no longer in use, e.g. after erasing. */
+    void shrink_to_fit();
+
+    const freqman_record& record(size_t index) const {
+        return blocks_[index / block_records][index % block_records];
+    }
+    const freqman_record& back() const { return record(size_ - 1); }
+    std::string_view description(size_t index) const;
+
+    /* Unpacks an entry, e.g. for editing or saving. */
+    freqman_entry entry(size_t index) const;
+
+    void push_back(const freqman_entry& entry);
+    void set(size_t index, const freqman_entry& entry);
+    void erase(size_t index);
+
+    /* Bytes allocated for records and descriptions. */
+    size_t memory_used() const;
+
+   private:
+    /* Recently stored descriptions by hash, for interning. */
+    struct interned_t {
+        uint32_t offset;
+        uint8_t length;
+    };
+    static constexpr size_t interned_slots = 64;
+
+    std::vector<std::unique_ptr<freqman_record[]>> blocks_{};
+    std::vector<std::unique_ptr<char[]>> arena_{};
+    size_t size_{0};
+    size_t arena_used_{arena_block_size};  // In the last arena block.
+    std::array<interned_t, interned_slots> interned_{};
+
+    freqman_record& mutable_record(size_t index) {
+        return blocks_[index / block_records][index % block_records];
+    }
+    freqman_record pack(const freqman_entry& entry);
+};
 
 /* Gets the full path for a given file stem (no extension). */
 const std::filesystem::path get_freqman_path(const std::string& stem);
@@ -191,16 +263,64 @@ std::string to_freqman_string(const freqman_entry& entry);
 bool parse_freqman_entry(std::string_view str, freqman_entry& entry);
 bool parse_freqman_file(const std::filesystem::path& path, freqman_db& db, freqman_load_options options);
 
+/* Returns true if the entry passes the type filters in options. */
+bool freqman_entry_wanted(const freqman_entry& entry, const freqman_load_options& options);
+
+/* Loads db from freqman file content in one pass over the lines. */
+template <typename BufferType>
+bool parse_freqman_lines(BufferType& buffer, freqman_db& db, freqman_load_options options) {
+    BufferLineReader<BufferType> reader{buffer};
+    db.clear();
+
+    freqman_entry entry{};
+    for (const auto& line : reader) {
+        std::string_view text{line};
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+            text.remove_suffix(1);
+
+        if (!parse_freqman_entry(text, entry) || !freqman_entry_wanted(entry, options))
+            continue;
+
+        // Use previous entry's mod/band if current's aren't set.
+        if (!db.empty()) {
+            if (is_invalid(entry.modulation))
+                entry.modulation = db.back().modulation;
+            if (is_invalid(entry.bandwidth))
+                entry.bandwidth = db.back().bandwidth;
+        }
+
+        db.push_back(entry);
+
+        // Limit to max_entries when specified.
+        if (options.max_entries > 0 && db.size() >= options.max_entries)
+            break;
+    }
+
+    return true;
+}
+
 /* Returns true if the entry is well-formed. */
 bool is_valid(const freqman_entry& entry);
 
+template <typename FileType>
+class FreqmanIndex;
+
 /* API wrapper over a Freqman file. Provides CRUD operations
  * for freqman_entry instances that are read/written directly
- * to the underlying file. */
+ * to the underlying file.
+ * Reads go through a sidecar .IDX index when one can be used, see
+ * freqman_index.hpp. The line scanning FileWrapper is only opened
+ * for edits, or if there's no index. */
 class FreqmanDB {
    public:
     using Index = FileWrapper::Line;
 
+    FreqmanDB();
+    ~FreqmanDB();
+
+    FreqmanDB(const FreqmanDB&) = delete;
+    FreqmanDB& operator=(const FreqmanDB&) = delete;
+
     /* NB: This iterator is very basic: forward only, read-only. */
     class iterator {
        public:
@@ -277,7 +397,20 @@ class FreqmanDB {
     }
 
    private:
+    /* Opens the index next to the file, rebuilding it if stale. */
+    bool open_index();
+    /* Updates the index after an edit. Only the records from line 'first'
+     * on are redone if nothing after the edit moved, else it's rebuilt. */
+    void update_index(Index first, bool tail_only);
+    /* Opens the FileWrapper if needed, taking over the file. */
+    FileWrapper* wrapper();
+    File& file() const;
+
+    std::filesystem::path path_{};
+    std::unique_ptr<File> file_{};
     std::unique_ptr<FileWrapper> wrapper_{};
+    std::unique_ptr<File> index_file_{};
+    std::unique_ptr<FreqmanIndex<File>> index_{};
     bool read_raw_{true};
 };
 
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FREQMAN_INDEX_H__
+#define __FREQMAN_INDEX_H__
+
+#include "freqman_db.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Binary sidecar index for a freqman .TXT file.
+ *
+ * Without it, FreqmanDB has to scan the text to find line N and re-parse
+ * the line every time it's read. The index holds one fixed size record per
+ * line with the line's offset and its pre-parsed numeric fields, so reading
+ * entry N is one read of the index (none if N is in the cached window) and,
+ * only if the entry has a description, one short read of the text.
+ *
+ * The header holds the size and FAT timestamp of the text it was built
+ * from. If either no longer matches, the index is stale and is rebuilt.
+ *
+ * FileType requires the following members
+ * Size size()
+ * Result<Size> read(void* data, Size bytes_to_read)
+ * Result<Size> write(const void* data, Size bytes_to_write)
+ * Result<Offset> seek(uint32_t offset)
+ * Result<Offset> truncate()
+ * Optional<Error> sync()
+ */
+
+struct freqman_index_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t count;
+    uint32_t reserved;
+};
+static_assert(sizeof(freqman_index_header) == 24, "freqman_index_header layout changed");
+
+struct freqman_index_record {
+    static constexpr uint8_t parsed_flag = 0x01;
+
+    int64_t frequency_a;
+    int64_t frequency_b;
+    // Start of the line in the text and its length, including the newline.
+    uint32_t offset;
+    uint16_t length;
+    // Where the description is in the line, so it can be read on its own.
+    uint16_t description_column;
+    uint8_t description_length;
+    uint8_t flags;
+    freqman_type type;
+    freqman_index_t modulation;
+    freqman_index_t bandwidth;
+    freqman_index_t step;
+    freqman_index_t tone;
+    uint8_t reserved;
+
+    /* False if the line isn't a valid entry, e.g. a comment. */
+    bool parsed() const { return flags & parsed_flag; }
+};
+static_assert(sizeof(freqman_index_record) == 32, "freqman_index_record layout changed");
+
+/* Fills record from one line of a freqman file starting at offset. */
+void index_freqman_line(std::string_view line, uint32_t offset, freqman_index_record& record);
+
+template <typename FileType>
+class FreqmanIndex {
+   public:
+    static constexpr uint32_t magic = 0x58494D46;  // "FMIX"
+    static constexpr uint16_t version = 1;
+
+    /* Records read at a time, and kept for the next lookups. */
+    static constexpr size_t window_size = 16;
+
+    FreqmanIndex(FileType& file)
+        : file_{file} {
+    }
+
+    /* Reads the header. Returns true if the index is current for a text
+     * with the given size and timestamp. */
+    bool load(uint32_t source_size, uint32_t source_timestamp) {
+        valid_ = false;
+        window_count_ = 0;
+
+        freqman_index_header header{};
+        if (!read_at(0, &header, sizeof(header)))
+            return false;
+
+        if (header.magic != magic || header.version != version ||
+            header.record_size != sizeof(freqman_index_record) ||
+            header.source_size != source_size ||
+            header.source_timestamp != source_timestamp ||
+            file_.size() < record_offset(header.count))
+            return false;
+
+        count_ = header.count;
+        valid_ = true;
+        return true;
+    }
+
+    /* Rebuilds the index in one pass over the text. */
+    template <typename SourceType>
+    bool build(SourceType& source, uint32_t source_timestamp) {
+        return index_from(source, 0, 0, source_timestamp);
+    }
+
+    /* Re-indexes the text from line 'first' on, after an edit that left the
+     * lines before it in place (an append, or a change to the last line).
+     * Only the tail's records and the header are written. */
+    template <typename SourceType>
+    bool update(SourceType& source, uint32_t first, uint32_t source_timestamp) {
+        if (!valid_ || first > count_)
+            return false;
+
+        uint32_t line_offset = 0;
+        if (first > 0) {
+            freqman_index_record record{};
+            if (!read(first - 1, record))
+                return false;
+            line_offset = record.offset + record.length;
+        }
+
+        return index_from(source, first, line_offset, source_timestamp);
+    }
+
+    bool valid() const { return valid_; }
+    uint32_t count() const { return valid_ ? count_ : 0; }
+
+    /* Copies out the record for line index. */
+    bool read(uint32_t index, freqman_index_record& record) {
+        if (!valid_ || index >= count_)
+            return false;
+
+        if (index < window_start_ || index >= window_start_ + window_count_) {
+            // Align so scrolling either way stays in the window.
+            window_start_ = index - (index % window_size);
+            window_count_ = 0;
+
+            const size_t count = std::min<size_t>(window_size, count_ - window_start_);
+            if (!read_at(record_offset(window_start_), window_.data(), count * sizeof(freqman_index_record)))
+                return false;
+
+            window_count_ = count;
+        }
+
+        record = window_[index - window_start_];
+        return true;
+    }
+
+   private:
+    FileType& file_;
+    uint32_t count_{0};
+    bool valid_{false};
+
+    std::array<freqman_index_record, window_size> window_{};
+    uint32_t window_start_{0};
+    size_t window_count_{0};
+
+    static uint32_t record_offset(uint32_t index) {
+        return sizeof(freqman_index_header) + index * sizeof(freqman_index_record);
+    }
+
+    /* Indexes the text from line 'first', which starts at 'line_offset', to
+     * its end, then drops any records past it and rewrites the header. */
+    template <typename SourceType>
+    bool index_from(SourceType& source, uint32_t first, uint32_t line_offset, uint32_t source_timestamp) {
+        valid_ = false;
+        window_count_ = 0;
+        count_ = first;
+
+        if (source.seek(line_offset).is_error() || file_.seek(record_offset(first)).is_error())
+            return false;
+
+        // Batch writes through the window, it's invalid until the next read.
+        std::string line{};
+        uint32_t offset = line_offset;
+        char buffer[512];
+
+        while (true) {
+            auto result = source.read(buffer, sizeof(buffer));
+            if (result.is_error())
+                return false;
+
+            const size_t length = *result;
+            for (size_t i = 0; i < length; i++) {
+                line.push_back(buffer[i]);
+                if (buffer[i] == '\n' && !add_line(line, line_offset))
+                    return false;
+            }
+            offset += length;
+
+            if (length < sizeof(buffer))
+                break;
+        }
+
+        // Last line without a newline.
+        if (!line.empty() && !add_line(line, line_offset))
+            return false;
+
+        if (!flush_window())
+            return false;
+        window_count_ = 0;
+
+        const freqman_index_header header{
+            .magic = magic,
+            .version = version,
+            .record_size = sizeof(freqman_index_record),
+            .source_size = offset,
+            .source_timestamp = source_timestamp,
+            .count = count_,
+            .reserved = 0,
+        };
+
+        if (file_.truncate().is_error() || !write_at(0, &header, sizeof(header)) || file_.sync())
+            return false;
+
+        valid_ = true;
+        return true;
+    }
+
+    bool add_line(std::string& line, uint32_t& line_offset) {
+        if (window_count_ == window_size && !flush_window())
+            return false;
+
+        index_freqman_line(line, line_offset, window_[window_count_++]);
+        count_++;
+        line_offset += line.size();
+        line.clear();
+        return true;
+    }
+
+    bool flush_window() {
+        const size_t length = window_count_ * sizeof(freqman_index_record);
+        window_count_ = 0;
+        if (length == 0)
+            return true;
+
+        auto result = file_.write(window_.data(), length);
+        return result.is_ok() && *result == length;
+    }
+
+    bool read_at(uint32_t offset, void* data, size_t length) {
+        if (file_.seek(offset).is_error())
+            return false;
+
+        auto result = file_.read(data, length);
+        return result.is_ok() && *result == length;
+    }
+
+    bool write_at(uint32_t offset, const void* data, size_t length) {
+        if (file_.seek(offset).is_error())
+            return false;
+
+        auto result = file_.write(data, length);
+        return result.is_ok() && *result == length;
+    }
+};
+
+#endif /*__FREQMAN_INDEX_H__*/
@@ -22,6 +22,7 @@
 #ifndef __RECENT_ENTRIES_H__
 #define __RECENT_ENTRIES_H__
 
+#include "recent_entries_pool.hpp"
 #include "ui_widget.hpp"
 
 #include <algorithm>
@@ -29,11 +30,20 @@
 #include <cstdint>
 #include <functional>
 #include <iterator>
-#include <list>
 #include <utility>
 
 template <class Entry>
-using RecentEntries = std::list<Entry>;
+using RecentEntries = RecentEntriesPool<Entry, 64>;
+
+template <class Entry, size_t Capacity, typename Key>
+typename RecentEntriesPool<Entry, Capacity>::const_iterator find(const RecentEntriesPool<Entry, Capacity>& entries, const Key key) {
+    return entries.find(key);
+}
+
+template <class Entry, size_t Capacity, typename Key>
+typename RecentEntriesPool<Entry, Capacity>::iterator find(RecentEntriesPool<Entry, Capacity>& entries, const Key key) {
+    return entries.find(key);
+}
 
 template <typename ContainerType, typename Key>
 typename ContainerType::const_iterator find(const ContainerType& entries, const Key key) {
@@ -71,6 +81,11 @@ typename ContainerType::reference on_packet(ContainerType& entries, const Key ke
     return entries.front();
 }
 
+template <class Entry, size_t Capacity, typename Key>
+Entry& on_packet(RecentEntriesPool<Entry, Capacity>& entries, const Key key) {
+    return entries.touch(key);
+}
+
 template <typename ContainerType>
 static std::pair<typename ContainerType::const_iterator, typename ContainerType::const_iterator> range_around(
     const ContainerType& entries,
@@ -107,10 +122,10 @@ void resetFilteredEntries(ContainerType& entries, KeySelector keySelector) {
     // Clear the filteredEntries container
     auto it = entries.begin();
     while (it != entries.end()) {
-        if (keySelector(*it)) {
-            entries.erase(it);  // Add a new entry to filteredEntries
-        }
-        ++it;  // Move to the next element, outside of the if block
+        if (keySelector(*it))
+            it = entries.erase(it);
+        else
+            ++it;
     }
 }
 
@@ -0,0 +1,401 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RECENT_ENTRIES_POOL_H__
+#define __RECENT_ENTRIES_POOL_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Key hashes for the recent entries index. Entry keys that aren't integers
+ * provide a recent_entries_hash() overload next to their type (found by ADL).
+ */
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, uint32_t>::type
+recent_entries_hash(const T key) {
+    const uint64_t v = static_cast<uint64_t>(key);
+    const uint32_t h = (static_cast<uint32_t>(v) ^ static_cast<uint32_t>(v >> 32)) * 0x9e3779b1u;
+    return h ^ (h >> 15);
+}
+
+template <typename A, typename B>
+inline uint32_t recent_entries_hash(const std::pair<A, B>& key) {
+    return recent_entries_hash(key.first) * 31u + recent_entries_hash(key.second);
+}
+
+/* Most recently used list of Entry, keyed by Entry::key().
+ *
+ * Behaves like the std::list it replaces (bidirectional iterators, references
+ * stay valid until the entry is erased) but never allocates per entry: all
+ * Capacity nodes come from one pool allocated on first insert, an open
+ * addressing hash table maps keys to nodes, and moving an entry to the front
+ * relinks it instead of copying it. Inserting into a full pool evicts the
+ * back (least recently used) entry.
+ *
+ * Keys are expected to be unique. If an entry is inserted with the key of an
+ * existing one, find() returns the newer one.
+ */
+template <class Entry, size_t Capacity>
+class RecentEntriesPool {
+    static_assert(Capacity > 0 && Capacity < 0xffff, "capacity must fit a 16-bit index");
+
+    using Index = typename std::conditional<(Capacity < 0xff), uint8_t, uint16_t>::type;
+    static constexpr Index npos = static_cast<Index>(-1);
+
+    static constexpr size_t table_size() {
+        size_t n = 1;
+        while (n < Capacity * 2) n <<= 1;
+        return n;
+    }
+    static constexpr size_t table_mask = table_size() - 1;
+
+    struct Node {
+        Entry entry;
+        Index prev;
+        Index next;
+    };
+    using Storage = typename std::aligned_storage<sizeof(Node), alignof(Node)>::type;
+
+   public:
+    using value_type = Entry;
+    using reference = Entry&;
+    using const_reference = const Entry&;
+    using size_type = size_t;
+    using Key = typename Entry::Key;
+
+    template <bool IsConst>
+    class basic_iterator {
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Entry;
+        using difference_type = ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const Entry*, Entry*>::type;
+        using reference = typename std::conditional<IsConst, const Entry&, Entry&>::type;
+        using Owner = typename std::conditional<IsConst, const RecentEntriesPool, RecentEntriesPool>::type;
+
+        basic_iterator() = default;
+        basic_iterator(Owner* owner, Index index)
+            : owner_{owner}, index_{index} {}
+
+        template <bool WasConst, typename = typename std::enable_if<IsConst && !WasConst>::type>
+        basic_iterator(const basic_iterator<WasConst>& other)
+            : owner_{other.owner_}, index_{other.index_} {}
+
+        reference operator*() const { return owner_->node(index_).entry; }
+        pointer operator->() const { return &owner_->node(index_).entry; }
+
+        basic_iterator& operator++() {
+            index_ = owner_->node(index_).next;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+        basic_iterator& operator--() {
+            index_ = (index_ == npos) ? owner_->tail_ : owner_->node(index_).prev;
+            return *this;
+        }
+        basic_iterator operator--(int) {
+            auto previous = *this;
+            --*this;
+            return previous;
+        }
+
+        bool operator==(const basic_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const basic_iterator& other) const { return index_ != other.index_; }
+
+       private:
+        Owner* owner_{nullptr};
+        Index index_{npos};
+
+        friend class RecentEntriesPool;
+        friend class basic_iterator<!IsConst>;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    RecentEntriesPool() = default;
+
+    RecentEntriesPool(const RecentEntriesPool& other) {
+        for (const auto& entry : other)
+            emplace_back(entry);
+    }
+
+    RecentEntriesPool& operator=(const RecentEntriesPool& other) {
+        if (this != &other) {
+            clear();
+            for (const auto& entry : other)
+                emplace_back(entry);
+        }
+        return *this;
+    }
+
+    ~RecentEntriesPool() {
+        clear();
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return {this, head_}; }
+    iterator end() { return {this, npos}; }
+    const_iterator begin() const { return {this, head_}; }
+    const_iterator end() const { return {this, npos}; }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+
+    reference front() { return node(head_).entry; }
+    reference back() { return node(tail_).entry; }
+    const_reference front() const { return node(head_).entry; }
+    const_reference back() const { return node(tail_).entry; }
+
+    iterator find(const Key& key) {
+        const auto slot = find_slot(key);
+        return {this, table_[slot] ? static_cast<Index>(table_[slot] - 1) : npos};
+    }
+
+    const_iterator find(const Key& key) const {
+        const auto slot = find_slot(key);
+        return {this, table_[slot] ? static_cast<Index>(table_[slot] - 1) : npos};
+    }
+
+    template <typename... Args>
+    reference emplace_front(Args&&... args) {
+        const auto index = construct(std::forward<Args>(args)...);
+        link_front(index);
+        return node(index).entry;
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        const auto index = construct(std::forward<Args>(args)...);
+        link_back(index);
+        return node(index).entry;
+    }
+
+    void push_front(const Entry& entry) { emplace_front(entry); }
+    void push_back(const Entry& entry) { emplace_back(entry); }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator{this, tail_}); }
+
+    /* Moves an entry to the front without copying it. */
+    void move_to_front(const_iterator it) {
+        if (it.index_ == head_)
+            return;
+
+        unlink(it.index_);
+        link_front(it.index_);
+    }
+
+    /* The on_packet() step: finds the entry for key and moves it to the front,
+     * or constructs a new one there. */
+    reference touch(const Key& key) {
+        auto it = find(key);
+        if (it == end())
+            return emplace_front(key);
+
+        move_to_front(it);
+        return *it;
+    }
+
+    iterator erase(const_iterator it) {
+        const Index index = it.index_;
+        const Index next = node(index).next;
+        unindex(index);
+        unlink(index);
+        destroy(index);
+        return {this, next};
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last)
+            first = erase(first);
+        return {this, last.index_};
+    }
+
+    void clear() {
+        while (head_ != npos) {
+            const Index index = head_;
+            head_ = node(index).next;
+            destroy(index);
+        }
+        tail_ = npos;
+        table_.fill(0);
+        shadowed_ = false;
+    }
+
+    /* Stable sort, like std::list::sort(). Relinks nodes, entries don't move. */
+    template <typename Compare>
+    void sort(Compare compare) {
+        std::array<Index, Capacity> order;
+        size_t n = 0;
+        for (Index i = head_; i != npos; i = node(i).next)
+            order[n++] = i;
+
+        std::stable_sort(order.begin(), order.begin() + n, [this, &compare](const Index a, const Index b) {
+            return compare(node(a).entry, node(b).entry);
+        });
+
+        head_ = tail_ = npos;
+        for (size_t i = 0; i < n; i++)
+            link_back(order[i]);
+    }
+
+   private:
+    std::unique_ptr<Storage[]> pool_{};
+    std::array<Index, table_size()> table_{};  // Node index + 1, 0 is empty.
+    Index head_{npos};
+    Index tail_{npos};
+    Index free_{npos};
+    Index next_unused_{0};
+    Index size_{0};
+    bool shadowed_{false};  // Some key was inserted twice.
+
+    Node& node(const Index index) { return *reinterpret_cast<Node*>(&pool_[index]); }
+    const Node& node(const Index index) const { return *reinterpret_cast<const Node*>(&pool_[index]); }
+
+    // Free nodes are chained through their first bytes.
+    Index& free_link(const Index index) { return *reinterpret_cast<Index*>(&pool_[index]); }
+
+    size_t home(const Key& key) const {
+        return recent_entries_hash(key) & table_mask;
+    }
+
+    /* Slot holding key, or the empty slot where it would go. */
+    size_t find_slot(const Key& key) const {
+        size_t slot = home(key);
+        while (table_[slot] && !(node(table_[slot] - 1).entry.key() == key))
+            slot = (slot + 1) & table_mask;
+        return slot;
+    }
+
+    template <typename... Args>
+    Index construct(Args&&... args) {
+        if (!pool_)
+            pool_.reset(new Storage[Capacity]);
+
+        if (size_ == Capacity)
+            pop_back();
+
+        Index index;
+        if (free_ != npos) {
+            index = free_;
+            free_ = free_link(index);
+        } else {
+            index = next_unused_++;
+        }
+
+        new (&node(index).entry) Entry(std::forward<Args>(args)...);
+        size_++;
+
+        const auto slot = find_slot(node(index).entry.key());
+        shadowed_ |= (table_[slot] != 0);
+        table_[slot] = index + 1;
+        return index;
+    }
+
+    void destroy(const Index index) {
+        node(index).entry.~Entry();
+        free_link(index) = free_;
+        free_ = index;
+        size_--;
+    }
+
+    /* Removes the table slot for a node, shifting later entries of the probe
+     * run back so lookups never stop early at the hole. */
+    void unindex(const Index index) {
+        const auto& key = node(index).entry.key();
+        size_t hole = find_slot(key);
+        if (table_[hole] != index + 1)
+            return;
+
+        table_[hole] = 0;
+        for (size_t slot = (hole + 1) & table_mask; table_[slot]; slot = (slot + 1) & table_mask) {
+            const size_t want = home(node(table_[slot] - 1).entry.key());
+            const bool stays = (hole < slot) ? (want > hole && want <= slot) : (want > hole || want <= slot);
+            if (!stays) {
+                table_[hole] = table_[slot];
+                table_[slot] = 0;
+                hole = slot;
+            }
+        }
+
+        // An older entry with the same key becomes reachable again.
+        if (shadowed_) {
+            for (Index i = head_; i != npos; i = node(i).next) {
+                if (i != index && node(i).entry.key() == key) {
+                    table_[find_slot(key)] = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    void link_front(const Index index) {
+        node(index).prev = npos;
+        node(index).next = head_;
+        if (head_ != npos)
+            node(head_).prev = index;
+        else
+            tail_ = index;
+        head_ = index;
+    }
+
+    void link_back(const Index index) {
+        node(index).prev = tail_;
+        node(index).next = npos;
+        if (tail_ != npos)
+            node(tail_).next = index;
+        else
+            head_ = index;
+        tail_ = index;
+    }
+
+    void unlink(const Index index) {
+        const Index prev = node(index).prev;
+        const Index next = node(index).next;
+        if (prev != npos)
+            node(prev).next = next;
+        else
+            head_ = next;
+        if (next != npos)
+            node(next).prev = prev;
+        else
+            tail_ = prev;
+    }
+};
+
+#endif /*__RECENT_ENTRIES_POOL_H__*/
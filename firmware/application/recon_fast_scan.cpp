@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "recon_fast_scan.hpp"
+
+#include <algorithm>
+#include <utility>
+
+void ReconFastScan::build(const freqman_db& db, const uint32_t sampling_rate) {
+    clusters_.clear();
+    members_.clear();
+    covered_.assign(db.size(), false);
+    valid_ = true;
+
+    const int64_t channel_width = sampling_rate / channel_count;
+    if (channel_width == 0) {
+        position_ = 0;
+        return;
+    }
+    const int64_t max_span = static_cast<int64_t>(channel_count - 2 * guard_channels - 2) * channel_width;
+
+    std::vector<std::pair<int64_t, size_t>> singles{};
+    for (size_t i = 0; i < db.size(); i++) {
+        const auto& entry = db.record(i);
+        if (entry.type == freqman_type::Single || entry.type == freqman_type::Repeater) {
+            singles.emplace_back(entry.frequency_a, i);
+        }
+    }
+    std::sort(singles.begin(), singles.end());
+
+    const auto channel_of = [channel_width](const int64_t offset) {
+        const int64_t rounded = (offset >= 0) ? (offset + channel_width / 2) : (offset - channel_width / 2);
+        return static_cast<int64_t>(channel_count / 2) + rounded / channel_width;
+    };
+    const auto usable = [](const int64_t channel) {
+        return (channel >= static_cast<int64_t>(guard_channels)) &&
+               (channel < static_cast<int64_t>(channel_count - guard_channels));
+    };
+
+    size_t first = 0;
+    while (first < singles.size()) {
+        size_t last = first;
+        while ((last + 1 < singles.size()) && (singles[last + 1].first - singles[first].first <= max_span)) {
+            last++;
+        }
+
+        /* The midpoint puts a lone entry on the DC channel, so try moving
+         * the tuning by up to a channel either way to clear it. */
+        const int64_t middle = (singles[first].first + singles[last].first) / 2;
+        const int64_t shifts[] = {0, channel_width, -channel_width, channel_width / 2, -channel_width / 2};
+        int64_t center = middle;
+        for (const auto shift : shifts) {
+            bool fits = true;
+            for (size_t i = first; fits && (i <= last); i++) {
+                const auto channel = channel_of(singles[i].first - (middle + shift));
+                fits = usable(channel) && (channel != static_cast<int64_t>(ChannelizerActivityMessage::dc_channel));
+            }
+            if (fits) {
+                center = middle + shift;
+                break;
+            }
+        }
+
+        /* Entries closer than a channel, or left on DC, can't be told apart
+         * and stay with the normal stepping. */
+        const size_t cluster_first = members_.size();
+        for (size_t i = first; i <= last; i++) {
+            const auto channel = channel_of(singles[i].first - center);
+            const bool shared = ((i > first) && (channel_of(singles[i - 1].first - center) == channel)) ||
+                                ((i < last) && (channel_of(singles[i + 1].first - center) == channel));
+            if (!shared && usable(channel) && (channel != static_cast<int64_t>(ChannelizerActivityMessage::dc_channel))) {
+                members_.push_back({singles[i].second, static_cast<uint8_t>(channel), 0});
+                covered_[singles[i].second] = true;
+            }
+        }
+        if (members_.size() > cluster_first) {
+            clusters_.push_back({center, cluster_first, members_.size() - cluster_first});
+        }
+        first = last + 1;
+    }
+
+    if (position_ >= clusters_.size()) {
+        position_ = 0;
+    }
+}
+
+bool ReconFastScan::covers(const size_t index) const {
+    return (index < covered_.size()) && covered_[index];
+}
+
+size_t ReconFastScan::covered_count() const {
+    return members_.size();
+}
+
+bool ReconFastScan::next() {
+    if (clusters_.empty()) {
+        return false;
+    }
+    position_++;
+    const bool wrapped = (position_ >= clusters_.size());
+    if (wrapped) {
+        position_ = 0;
+    }
+    clear_matches();
+    return wrapped;
+}
+
+int32_t ReconFastScan::on_activity(const ChannelizerActivityMessage& message, const uint32_t nb_match, const bool continuous) {
+    if (clusters_.empty()) {
+        return -1;
+    }
+
+    const auto& cluster = current();
+    int32_t locked = -1;
+    for (size_t i = cluster.first; i < cluster.first + cluster.count; i++) {
+        auto& member = members_[i];
+        if (message.is_open(member.channel)) {
+            if (member.matches < UINT8_MAX) {
+                member.matches++;
+            }
+        } else if (continuous) {
+            member.matches = 0;
+        }
+
+        if ((locked < 0) && (member.matches >= nb_match)) {
+            locked = member.index;
+        }
+    }
+    return locked;
+}
+
+int8_t ReconFastScan::peak_db(const ChannelizerActivityMessage& message) const {
+    int8_t peak = INT8_MIN;
+    if (!clusters_.empty()) {
+        const auto& cluster = current();
+        for (size_t i = cluster.first; i < cluster.first + cluster.count; i++) {
+            peak = std::max(peak, message.power_db[members_[i].channel]);
+        }
+    }
+    return peak;
+}
+
+void ReconFastScan::clear_matches() {
+    for (auto& member : members_) {
+        member.matches = 0;
+    }
+}
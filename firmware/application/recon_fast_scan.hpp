@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RECON_FAST_SCAN_H__
+#define __RECON_FAST_SCAN_H__
+
+#include "freqman_db.hpp"
+#include "message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Groups the Single and Repeater entries of a freqman list into clusters
+ * that each fit inside one channelizer capture, so Recon can watch every
+ * entry of a cluster from one tuning and only retune when moving on.
+ * Range and HamRadio entries, and entries sharing a channel, still need
+ * stepping and are left out; covers() tells them apart.
+ */
+class ReconFastScan {
+   public:
+    static constexpr size_t channel_count = ChannelizerActivityMessage::channel_count;
+    /* Channels left unused at each edge, where the baseband filter rolls off. */
+    static constexpr size_t guard_channels = 4;
+
+    struct Member {
+        size_t index;      // Into the freqman list.
+        uint8_t channel;   // Channelizer channel.
+        uint8_t matches;   // Squelch opens counted towards a lock.
+    };
+
+    struct Cluster {
+        int64_t center;
+        size_t first;  // Into members().
+        size_t count;
+    };
+
+    /* Rebuilds the clusters. The current position is kept if still valid.
+     * Reads every entry and sorts a local copy; db itself is not changed. */
+    void build(const freqman_db& db, const uint32_t sampling_rate);
+    /* Marks the clusters stale after the freqman list changed. */
+    void invalidate() { valid_ = false; }
+    bool valid() const { return valid_; }
+
+    /* True if the channelizer watches this freqman entry. */
+    bool covers(const size_t index) const;
+    size_t covered_count() const;
+
+    bool empty() const { return clusters_.empty(); }
+    size_t size() const { return clusters_.size(); }
+    size_t position() const { return position_; }
+    const Cluster& current() const { return clusters_[position_]; }
+    const std::vector<Member>& members() const { return members_; }
+
+    /* Moves to the next cluster and clears its matches. Returns true when
+     * wrapping around to the first cluster. */
+    bool next();
+
+    /* Counts one activity report against the current cluster's entries.
+     * Returns the freqman index of the first entry to reach nb_match, or -1.
+     * When 'continuous' is set a closed squelch resets an entry's count. */
+    int32_t on_activity(const ChannelizerActivityMessage& message, const uint32_t nb_match, const bool continuous);
+
+    /* Strongest channel power among the current cluster's entries. */
+    int8_t peak_db(const ChannelizerActivityMessage& message) const;
+
+    void clear_matches();
+
+   private:
+    std::vector<Cluster> clusters_{};
+    std::vector<Member> members_{};
+    std::vector<bool> covered_{};
+    size_t position_{0};
+    bool valid_{false};
+};
+
+#endif /*__RECON_FAST_SCAN_H__*/
@@ -110,17 +110,10 @@ std::string tone_key_value_string(tone_index index) {
 // Value is in 0.01 Hz units
 std::string tone_key_string_by_value(uint32_t value, size_t max_length) {
     static uint8_t tone_display_toggle{0};
-    static uint32_t last_value;
     tone_index idx;
     std::string freq_str;
 
-    // If >10Hz difference between consecutive samples, it's probably noise, so ignore
-    if (abs(value - last_value) > 10 * 100) {
-        last_value = value;
-        tone_display_toggle = 0;
-        return "        ";
-    }
-    last_value = value;
+    // The baseband only reports tones it is confident of, so no noise filtering here
 
     // Only display 1/10 Hz accuracy if <1000 Hz; max 5 characters
     if (value < 1000 * 100)
@@ -257,9 +257,34 @@ void GeoMap::map_read_line(ui::Color* buffer, uint16_t pixels) {
 void GeoMap::draw_markers(Painter& painter) {
     for (int i = 0; i < markerListLen; ++i) {
         draw_marker_item(painter, markerList[i], Color::blue(), Color::blue(), Color::magenta());
+        drawn_markers[i] = place_marker_item(markerList[i]);
     }
 }
 
+GeoMap::DrawnMarker GeoMap::place_marker_item(GeoMarker& item) {
+    const auto r = screen_rect();
+    const ui::Point itemPoint = item_rect_pixel(item);
+    DrawnMarker marker{};
+
+    if ((itemPoint.x() >= 0) && (itemPoint.x() < r.width()) &&
+        (itemPoint.y() > 10) && (itemPoint.y() < r.height()))  // Same test as draw_marker_item()
+    {
+        marker.point = {itemPoint.x(), itemPoint.y() + r.top()};
+        marker.angle = item.angle;
+        marker.tag_hash = 2166136261u;  // FNV-1a
+        for (const auto c : item.tag) {
+            marker.tag_hash = (marker.tag_hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+
+        // Symbols reach at most 16 pixels from the point, the tag sits up to 30 above it.
+        marker.bounds = {marker.point - Point(16, 16), {33, 33}};
+        const int tag_width = (int)item.tag.length() * 8;
+        marker.bounds += Rect{marker.point - Point(tag_width / 2, 30), {tag_width, 24}};
+        marker.valid = true;
+    }
+    return marker;
+}
+
 void GeoMap::draw_marker_item(Painter& painter, GeoMarker& item, const Color color, const Color fontColor, const Color backColor) {
     const auto r = screen_rect();
     const ui::Point itemPoint = item_rect_pixel(item);
@@ -271,6 +296,66 @@ void GeoMap::draw_marker_item(Painter& painter, GeoMarker& item, const Color col
     }
 }
 
+// Repaints the map under markers that moved or went away, then redraws the
+// markers that are new, moved or were touched by that repaint.
+void GeoMap::update_markers(Painter& painter) {
+    const auto r = screen_rect();
+    const size_t my_pos_index = drawn_markers.size() - 1;
+    const bool my_pos_valid = (my_pos.lat < INVALID_LAT_LON) && (my_pos.lon < INVALID_LAT_LON);
+
+    std::array<DrawnMarker, NumMarkerListElements + 1> next{};
+    for (int i = 0; i < markerListLen; ++i) {
+        next[i] = place_marker_item(markerList[i]);
+    }
+    if (my_pos_valid)
+        next[my_pos_index] = place_marker_item(my_pos);
+
+    auto unchanged_in = [](const DrawnMarker& m, const std::array<DrawnMarker, NumMarkerListElements + 1>& list) {
+        for (const auto& other : list) {
+            if (m.same_as(other))
+                return true;
+        }
+        return false;
+    };
+
+    std::array<Rect, NumMarkerListElements + 1> repainted{};
+    size_t repainted_count = 0;
+    for (const auto& old : drawn_markers) {
+        if (old.valid && !unchanged_in(old, next)) {
+            const auto area = old.bounds.intersect(r);
+            if (area) {
+                draw_map_area(area);
+                repainted[repainted_count++] = area;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < next.size(); i++) {
+        const auto& m = next[i];
+        if (!m.valid)
+            continue;
+
+        bool draw = !unchanged_in(m, drawn_markers);
+        for (size_t j = 0; !draw && j < repainted_count; j++) {
+            draw = (bool)m.bounds.intersect(repainted[j]);
+        }
+        if (!draw)
+            continue;
+
+        if (i == my_pos_index)
+            draw_marker_item(painter, my_pos, Color::yellow());
+        else
+            draw_marker_item(painter, markerList[i], Color::blue(), Color::blue(), Color::magenta());
+    }
+    drawn_markers = next;
+
+    if (repainted_count) {
+        if (manual_panning_)
+            draw_crosshair();
+        draw_scale(painter);
+    }
+}
+
 // Calculate screen position of item, adjusted for zoom factor.
 ui::Point GeoMap::item_rect_pixel(GeoMarker& item) {
     const auto r = screen_rect();
@@ -331,11 +416,74 @@ void GeoMap::draw_map_grid() {
     }
 }
 
+// Draws the map pixels for part of the screen rect from the tile set.
+void GeoMap::draw_map_area(const Rect area) {
+    constexpr int32_t T = MapTileIndex::tile_size;
+    const auto r = screen_rect();
+    const int32_t zoom_out = (map_zoom < 0) ? -map_zoom : 1;
+    const int32_t zoom_in = (map_zoom > 1) ? map_zoom : 1;
+    const uint8_t l = tile_index.level_for_zoom_out(zoom_out);
+    const auto& level = tile_index.level(l);
+
+    std::array<ui::Color, geomap_rect_width> line;
+    int32_t prev_y_l = INT32_MIN;
+
+    for (int y = area.top(); y < area.bottom(); y++) {
+        const int32_t y0 = map_seek_y + (y - r.top()) * zoom_out / zoom_in;
+        const int32_t y_l = (y0 < 0) ? -1 : (y0 >> l);
+
+        // Zoomed in, neighbouring rows repeat the same map line.
+        if (y_l != prev_y_l) {
+            prev_y_l = y_l;
+            const bool row_valid = (y_l >= 0) && (y_l < level.height);
+            const Color* tile = nullptr;
+            int32_t tile_tx = -1;
+
+            for (int x = area.left(); x < area.right(); x++) {
+                const int32_t x0 = map_seek_x + (x - r.left()) * zoom_out / zoom_in;
+                const int32_t x_l = (x0 < 0) ? -1 : (x0 >> l);
+                Color& pixel = line[x - area.left()];
+
+                if (!row_valid || (x_l < 0) || (x_l >= level.width)) {
+                    pixel = Color::black();
+                    continue;
+                }
+                if (x_l / T != tile_tx) {
+                    tile_tx = x_l / T;
+                    tile = map_tile({l, static_cast<uint16_t>(tile_tx), static_cast<uint16_t>(y_l / T)});
+                }
+                pixel = tile ? tile[(y_l % T) * T + (x_l % T)] : Color::black();
+            }
+        }
+
+        display.draw_pixels({area.left(), y, area.width(), 1}, line.data(), area.width());
+    }
+}
+
+const Color* GeoMap::map_tile(const MapTileKey key) {
+    return tile_cache->get(key, [this](const MapTileKey k, Color* dst) {
+        if (tile_file.seek(tile_index.tile_offset(k)).is_error())
+            return false;
+        const auto result = tile_file.read(dst, MapTileIndex::tile_bytes);
+        return !result.is_error() && (*result == MapTileIndex::tile_bytes);
+    });
+}
+
+void GeoMap::draw_crosshair() {
+    const auto r = screen_rect();
+    display.fill_rectangle({r.center() - Point(16, 1) + Point(zoom_pixel_offset, zoom_pixel_offset), {32, 2}}, Color::red());
+    display.fill_rectangle({r.center() - Point(1, 16) + Point(zoom_pixel_offset, zoom_pixel_offset), {2, 32}}, Color::red());
+}
+
 void GeoMap::paint(Painter& painter) {
     const auto r = screen_rect();
     std::array<ui::Color, geomap_rect_width> map_line_buffer;
     int16_t zoom_seek_x, zoom_seek_y;
 
+    // Marker changes are patched in over the tile set; otherwise they need a full redraw.
+    if (markers_changed && !(tiles_opened && map_visible))
+        redraw_map = true;
+
     // Ony redraw map if it moved by at least 1 pixel or the markers list was updated
     if (map_zoom <= 1) {
         // Zooming out, or no zoom
@@ -368,7 +516,12 @@ void GeoMap::paint(Painter& painter) {
             zoom_seek_y = y_pos - (r.height() * abs(map_zoom)) / 2;
         }
 
-        if (map_visible) {
+        map_seek_x = zoom_seek_x;
+        map_seek_y = zoom_seek_y;
+
+        if (map_visible && tiles_opened) {
+            draw_map_area(r);
+        } else if (map_visible) {
             // Read from map file and display to zoomed scale
             int duplicate_lines = (map_zoom < 0) ? 1 : map_zoom;
             for (uint16_t line = 0; line < (r.height() / duplicate_lines); line++) {
@@ -387,15 +540,19 @@ void GeoMap::paint(Painter& painter) {
 
         // Draw crosshairs in center in manual panning mode
         if (manual_panning_) {
-            display.fill_rectangle({r.center() - Point(16, 1) + Point(zoom_pixel_offset, zoom_pixel_offset), {32, 2}}, Color::red());
-            display.fill_rectangle({r.center() - Point(1, 16) + Point(zoom_pixel_offset, zoom_pixel_offset), {2, 32}}, Color::red());
+            draw_crosshair();
         }
 
         // Draw the other markers
+        drawn_markers.fill({});
         draw_markers(painter);
         draw_scale(painter);
         draw_mypos(painter);
+        markers_changed = false;
         set_clean();
+    } else if (markers_changed) {
+        markers_changed = false;
+        update_markers(painter);
     }
 
     // Draw the marker in the center
@@ -446,14 +603,37 @@ void GeoMap::move(const float lon, const float lat) {
     pixels_per_km = (r.width() / 2) / km_per_deg_lon;
 }
 
-bool GeoMap::init() {
-    auto result = map_file.open(adsb_dir / u"world_map.bin");
-    map_opened = !result.is_valid();
+bool GeoMap::init_tiles() {
+    if (tile_file.open(adsb_dir / u"world_map.tiles"))
+        return false;
+
+    std::array<uint8_t, MapTileIndex::max_header_size> header{};
+    const auto result = tile_file.read(header.data(), header.size());
+    if (result.is_error() || !tile_index.parse(header.data(), *result))
+        return false;
+
+    tile_cache = std::make_unique<MapTileCache>();
+    map_width = tile_index.level(0).width;
+    map_height = tile_index.level(0).height;
+    return true;
+}
 
-    if (map_opened) {
-        map_file.read(&map_width, 2);
-        map_file.read(&map_height, 2);
+bool GeoMap::init() {
+    // Prefer the tiled map, with its zoom levels; fall back to the plain bitmap.
+    // (init_tiles() sets map_width/map_height from the tile set's full resolution level.)
+    tiles_opened = init_tiles();
+    if (tiles_opened) {
+        map_opened = true;
     } else {
+        auto result = map_file.open(adsb_dir / u"world_map.bin");
+        map_opened = !result.is_valid();
+        if (map_opened) {
+            map_file.read(&map_width, 2);
+            map_file.read(&map_height, 2);
+        }
+    }
+
+    if (!map_opened) {
         map_width = 32768;
         map_height = 32768;
     }
@@ -561,12 +741,15 @@ void GeoMap::draw_marker(Painter& painter, const ui::Point itemPoint, const uint
 }
 
 void GeoMap::draw_mypos(Painter& painter) {
-    if ((my_pos.lat < INVALID_LAT_LON) && (my_pos.lon < INVALID_LAT_LON))
+    if ((my_pos.lat < INVALID_LAT_LON) && (my_pos.lon < INVALID_LAT_LON)) {
         draw_marker_item(painter, my_pos, Color::yellow());
+        drawn_markers.back() = place_marker_item(my_pos);
+    }
 }
 
 void GeoMap::clear_markers() {
     markerListLen = 0;
+    markers_changed = true;
 }
 
 MapMarkerStored GeoMap::store_marker(GeoMarker& marker) {
@@ -585,7 +768,7 @@ MapMarkerStored GeoMap::store_marker(GeoMarker& marker) {
     } else if (markerListLen < NumMarkerListElements) {
         markerList[markerListLen] = marker;
         markerListLen++;
-        redraw_map = true;
+        markers_changed = true;
         ret = MARKER_STORED;
     } else {
         ret = MARKER_LIST_FULL;
@@ -597,14 +780,14 @@ void GeoMap::update_my_position(float lat, float lon, int32_t altitude) {
     my_pos.lat = lat;
     my_pos.lon = lon;
     my_altitude = altitude;
-    redraw_map = true;
+    markers_changed = true;
     set_dirty();
 }
 
 void GeoMap::update_my_orientation(uint16_t angle, bool refresh) {
     my_pos.angle = angle;
     if (refresh) {
-        redraw_map = true;
+        markers_changed = true;
         set_dirty();
     }
 }
@@ -27,6 +27,7 @@
 #include "ui.hpp"
 #include "file.hpp"
 #include "ui_navigation.hpp"
+#include "ui_geomap_tiles.hpp"
 
 #include "portapack.hpp"
 
@@ -237,9 +238,26 @@ class GeoMap : public Widget {
     static const Dim geomap_rect_height = GEOMAP_RECT_HEIGHT;
 
    private:
+    /* Where a marker was last drawn, so a marker update can repaint just
+     * the map under the ones that moved. */
+    struct DrawnMarker {
+        Rect bounds{};
+        Point point{};
+        uint16_t angle{};
+        uint32_t tag_hash{};
+        bool valid{false};
+
+        bool same_as(const DrawnMarker& other) const {
+            return valid && other.valid &&
+                   point.x() == other.point.x() && point.y() == other.point.y() &&
+                   angle == other.angle && tag_hash == other.tag_hash;
+        }
+    };
+
     void draw_scale(Painter& painter);
     ui::Point item_rect_pixel(GeoMarker& item);
     GeoPoint lat_lon_to_map_pixel(float lat, float lon);
+    DrawnMarker place_marker_item(GeoMarker& item);
     void draw_marker_item(Painter& painter, GeoMarker& item, const Color color, const Color fontColor = Color::white(), const Color backColor = Color::black());
     void draw_marker(Painter& painter, const ui::Point itemPoint, const uint16_t itemAngle, const std::string itemTag, const Color color = Color::red(), const Color fontColor = Color::white(), const Color backColor = Color::black());
     void draw_markers(Painter& painter);
@@ -247,11 +265,20 @@ class GeoMap : public Widget {
     void draw_bearing(const Point origin, const uint16_t angle, uint32_t size, const Color color);
     void draw_map_grid();
     void map_read_line(ui::Color* buffer, uint16_t pixels);
+    bool init_tiles();
+    const Color* map_tile(const MapTileKey key);
+    void draw_map_area(const Rect area);
+    void draw_crosshair();
+    void update_markers(Painter& painter);
 
     bool manual_panning_{false};
     bool hide_center_marker_{false};
     GeoMapMode mode_{};
     File map_file{};
+    File tile_file{};
+    MapTileIndex tile_index{};
+    std::unique_ptr<MapTileCache> tile_cache{};
+    bool tiles_opened{false};
     bool map_opened{};
     bool map_visible{};
     uint16_t map_width{}, map_height{};
@@ -278,6 +305,12 @@ class GeoMap : public Widget {
     int markerListLen{0};
     GeoMarker markerList[NumMarkerListElements];
     bool redraw_map{false};
+    bool markers_changed{false};
+
+    // Map pixel (level 0) at the top left of the screen rect, as last drawn.
+    int32_t map_seek_x{0}, map_seek_y{0};
+    // The list markers, then my_pos.
+    std::array<DrawnMarker, NumMarkerListElements + 1> drawn_markers{};
 };
 
 class GeoMapView : public View {
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_GEOMAP_TILES_H__
+#define __UI_GEOMAP_TILES_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ui.hpp"
+
+namespace ui {
+
+/* Pre-tiled world map, as written by tools/generate_world_map.bin.py --tiles.
+ *
+ * All values little endian:
+ *   0  char[4]  "PPMT"
+ *   4  uint16   format version (1)
+ *   6  uint16   tile size in pixels (square)
+ *   8  uint16   level count
+ *   10 uint16   reserved
+ *   12 level table, one 12 byte entry per level:
+ *        uint16 width, uint16 height, uint16 tiles_x, uint16 tiles_y,
+ *        uint32 file offset of the level's first tile
+ * Level 0 is full resolution and each further level halves both axes. A
+ * level's tiles are stored row major as RGB565, edge tiles padded; with 16
+ * pixel tiles every tile is one 512 byte sector.
+ */
+struct MapTileLevel {
+    uint16_t width;
+    uint16_t height;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    uint32_t offset;
+};
+
+struct MapTileKey {
+    uint8_t level;
+    uint16_t tx;
+    uint16_t ty;
+
+    bool operator==(const MapTileKey& other) const {
+        return level == other.level && tx == other.tx && ty == other.ty;
+    }
+};
+
+class MapTileIndex {
+   public:
+    static constexpr uint32_t magic = 0x544d5050;  // "PPMT"
+    static constexpr uint16_t version = 1;
+    static constexpr size_t tile_size = 16;
+    static constexpr size_t tile_pixels = tile_size * tile_size;
+    static constexpr size_t tile_bytes = tile_pixels * sizeof(Color);
+    static constexpr size_t max_levels = 8;
+    static constexpr size_t header_size = 12;
+    static constexpr size_t level_entry_size = 12;
+    static constexpr size_t max_header_size = header_size + max_levels * level_entry_size;
+
+    /* Reads the header and level table; false if this isn't a tile set this
+     * code can draw. */
+    bool parse(const uint8_t* const data, const size_t size) {
+        levels_ = 0;
+        if (size < header_size)
+            return false;
+
+        if (u32(data) != magic || u16(data + 4) != version || u16(data + 6) != tile_size)
+            return false;
+
+        const size_t count = u16(data + 8);
+        if (count == 0 || count > max_levels || size < header_size + count * level_entry_size)
+            return false;
+
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t* const e = data + header_size + i * level_entry_size;
+            level_[i] = {u16(e), u16(e + 2), u16(e + 4), u16(e + 6), u32(e + 8)};
+            if (level_[i].tiles_x * tile_size < level_[i].width ||
+                level_[i].tiles_y * tile_size < level_[i].height)
+                return false;
+        }
+        levels_ = count;
+        return true;
+    }
+
+    size_t levels() const { return levels_; }
+    const MapTileLevel& level(const size_t l) const { return level_[l]; }
+
+    uint32_t tile_offset(const MapTileKey key) const {
+        const auto& l = level_[key.level];
+        return l.offset + (static_cast<uint32_t>(key.ty) * l.tiles_x + key.tx) * tile_bytes;
+    }
+
+    /* Level to sample for a zoom out factor: the first one at least as
+     * coarse as the screen, so a redraw never reads more tiles than the
+     * screen holds and each map pixel is an average rather than a point. */
+    size_t level_for_zoom_out(const uint32_t factor) const {
+        size_t l = 0;
+        while ((1U << l) < factor && l + 1 < levels_)
+            l++;
+        return l;
+    }
+
+   private:
+    std::array<MapTileLevel, max_levels> level_{};
+    size_t levels_{0};
+
+    static uint16_t u16(const uint8_t* p) {
+        return p[0] | (p[1] << 8);
+    }
+
+    static uint32_t u32(const uint8_t* p) {
+        return u16(p) | (static_cast<uint32_t>(u16(p + 2)) << 16);
+    }
+};
+
+/* Least recently used set of decoded map tiles. Sized so one screen row at
+ * any zoom (at most 16 tiles wide) stays resident while the rows of a tile
+ * band are drawn, so each tile is read once per full redraw and small
+ * repaints (markers, pans within a tile) mostly hit.
+ */
+class MapTileCache {
+   public:
+    static constexpr size_t capacity = 20;
+
+    MapTileCache()
+        : pixels_{std::make_unique<Color[]>(capacity * MapTileIndex::tile_pixels)} {
+    }
+
+    /* Returns the tile's pixels, calling load(key, dst) on a miss; nullptr
+     * if the load fails. */
+    template <typename Loader>
+    const Color* get(const MapTileKey key, Loader&& load) {
+        clock_++;
+        size_t victim = 0;
+        for (size_t i = 0; i < capacity; i++) {
+            if (entry_[i].used && entry_[i].key == key) {
+                entry_[i].last_use = clock_;
+                hits_++;
+                return tile(i);
+            }
+            if (!entry_[i].used || (entry_[victim].used && entry_[i].last_use < entry_[victim].last_use))
+                victim = i;
+        }
+
+        misses_++;
+        auto& e = entry_[victim];
+        e.used = false;
+        if (!load(key, tile(victim)))
+            return nullptr;
+
+        e = {key, clock_, true};
+        return tile(victim);
+    }
+
+    void clear() {
+        for (auto& e : entry_)
+            e.used = false;
+    }
+
+    uint32_t hits() const { return hits_; }
+    uint32_t misses() const { return misses_; }
+
+   private:
+    struct Entry {
+        MapTileKey key{};
+        uint32_t last_use{0};
+        bool used{false};
+    };
+
+    std::unique_ptr<Color[]> pixels_;
+    std::array<Entry, capacity> entry_{};
+    uint32_t clock_{0};
+    uint32_t hits_{0};
+    uint32_t misses_{0};
+
+    Color* tile(const size_t i) {
+        return &pixels_[i * MapTileIndex::tile_pixels];
+    }
+};
+
+} /* namespace ui */
+
+#endif /*__UI_GEOMAP_TILES_H__*/
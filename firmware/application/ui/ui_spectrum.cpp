@@ -31,6 +31,8 @@ using namespace portapack;
 
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <cstdlib>
 
 namespace ui {
 namespace spectrum {
@@ -110,6 +112,17 @@ void FrequencyScale::set_cursor_position(const int32_t position) {
     set_dirty();
 }
 
+void FrequencyScale::set_center_offset(const int32_t offset) {
+    if (offset != center_offset) {
+        center_offset = offset;
+        set_dirty();
+    }
+}
+
+int32_t FrequencyScale::cursor_offset() const {
+    return center_offset + (cursor_position * spectrum_sampling_rate) / 240;
+}
+
 void FrequencyScale::paint(Painter& painter) {
     const auto r = screen_rect();
 
@@ -156,31 +169,36 @@ void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
         magnitude_n += 1;
     }
     const int tick_interval = std::ceil(rough_tick_interval);
+    const int64_t tick_step = int64_t(tick_interval) * magnitude;
 
-    auto tick_offset = tick_interval;
-    while ((tick_offset * magnitude) < spectrum_sampling_rate / 2) {
-        const Dim pixel_offset = tick_offset * magnitude * spectrum_bins / spectrum_sampling_rate;
-
-        const std::string zero_pad =
-            ((magnitude_n % 3) == 0) ? "" : ((magnitude_n % 3) == 1) ? "0"
-                                                                     : "00";
-        const std::string unit =
-            (magnitude_n >= 6) ? "M" : (magnitude_n >= 3) ? "k"
-                                                          : "";
-        const std::string label = to_string_dec_uint(tick_offset) + zero_pad + unit;
-        const auto label_width = style().font.size_of(label).width();
-
-        const Coord offset_low = r.left() + x_center - pixel_offset;
-        const Rect tick_low{offset_low, r.top(), 1, r.height()};
-        painter.fill_rectangle(tick_low, Theme::getInstance()->bg_darkest->foreground);
-        painter.draw_string({offset_low + 2, r.top()}, style(), label);
-
-        const Coord offset_high = r.left() + x_center + pixel_offset;
-        const Rect tick_high{offset_high, r.top(), 1, r.height()};
-        painter.fill_rectangle(tick_high, Theme::getInstance()->bg_darkest->foreground);
-        painter.draw_string({offset_high - 2 - label_width, r.top()}, style(), label);
-
-        tick_offset += tick_interval;
+    const std::string zero_pad =
+        ((magnitude_n % 3) == 0) ? "" : ((magnitude_n % 3) == 1) ? "0"
+                                                                 : "00";
+    const std::string unit =
+        (magnitude_n >= 6) ? "M" : (magnitude_n >= 3) ? "k"
+                                                      : "";
+
+    /* Ticks sit on multiples of the interval from the channel centre, so a
+     * zoomed scale labels the same frequencies as the full one would.
+     */
+    const int64_t f_low = center_offset - spectrum_sampling_rate / 2;
+    const int64_t f_high = center_offset + spectrum_sampling_rate / 2;
+    int64_t f_tick = (f_low / tick_step) * tick_step;
+    for (; f_tick < f_high; f_tick += tick_step) {
+        if ((f_tick <= f_low) || (f_tick == center_offset))
+            continue;
+
+        const Coord offset = r.left() + x_center + (f_tick - center_offset) * spectrum_bins / spectrum_sampling_rate;
+        const Rect tick_f{offset, r.top(), 1, r.height()};
+        painter.fill_rectangle(tick_f, Theme::getInstance()->bg_darkest->foreground);
+
+        const std::string label = to_string_dec_uint(std::abs(f_tick) / magnitude) + zero_pad + unit;
+        if (f_tick < center_offset) {
+            painter.draw_string({offset + 2, r.top()}, style(), label);
+        } else {
+            const auto label_width = style().font.size_of(label).width();
+            painter.draw_string({offset - 2 - label_width, r.top()}, style(), label);
+        }
     }
 }
 
@@ -212,6 +230,9 @@ void FrequencyScale::draw_filter_ranges(Painter& painter, const Rect r) {
 }
 
 void FrequencyScale::on_focus() {
+    if (on_show_options) {
+        on_show_options();
+    }
     set_dirty();
 }
 
@@ -233,7 +254,7 @@ bool FrequencyScale::on_encoder(const EncoderEvent delta) {
 bool FrequencyScale::on_key(const KeyEvent key) {
     if (key == KeyEvent::Select) {
         if (on_select) {
-            on_select((cursor_position * spectrum_sampling_rate) / 240);
+            on_select(cursor_offset());
             cursor_position = 0;
             set_dirty();
             return true;
@@ -246,7 +267,7 @@ bool FrequencyScale::on_key(const KeyEvent key) {
 bool FrequencyScale::on_touch(const TouchEvent touch) {
     if (touch.type == TouchEvent::Type::Start) {
         if (on_select) {
-            on_select((touch.point.x() * spectrum_sampling_rate) / 240);
+            on_select(center_offset + (touch.point.x() * spectrum_sampling_rate) / 240);
         }
     }
     return true;
@@ -261,6 +282,11 @@ void WaterfallWidget::on_show() {
 
     const auto screen_r = screen_rect();
     display.scroll_set_area(screen_r.top(), screen_r.bottom());
+
+    bin_map.configure(bin_reducer, screen_r.width());
+    if (!batch)
+        batch = std::make_unique<Color[]>(batch_lines * max_width);
+    batch_count = 0;
 }
 
 void WaterfallWidget::on_hide() {
@@ -268,28 +294,67 @@ void WaterfallWidget::on_hide() {
      * position?
      */
     display.scroll_disable();
+    batch.reset();
+    batch_count = 0;
+}
+
+void WaterfallWidget::set_bin_reducer(const BinReducer reducer) {
+    bin_reducer = reducer;
+    bin_map.configure(bin_reducer, screen_rect().width());
+    batch_count = 0;
 }
 
 void WaterfallWidget::on_channel_spectrum(
     const ChannelSpectrum& spectrum) {
-    /* TODO: static_assert that message.spectrum.db.size() >= pixel_row.size() */
+    if (!batch)
+        return;
 
-    std::array<Color, 240> pixel_row;
-    for (size_t i = 0; i < 120; i++) {
-        const auto pixel_color = gradient.lut[spectrum.db[256 - 120 + i]];
-        pixel_row[i] = pixel_color;
+    if (bin_map.width() != static_cast<size_t>(screen_rect().width())) {
+        bin_map.configure(bin_reducer, screen_rect().width());
+        batch_count = 0;
     }
 
-    for (size_t i = 120; i < 240; i++) {
-        const auto pixel_color = gradient.lut[spectrum.db[i - 120]];
-        pixel_row[i] = pixel_color;
+    if (batch_count == batch_lines)
+        flush();
+
+    // Reduce first so the colour lookup runs once per column, not per bin.
+    std::array<uint8_t, max_width> levels;
+    bin_map.reduce(spectrum.db, levels.data());
+
+    const size_t width = bin_map.width();
+    Color* const line = &batch[batch_count * width];
+    for (size_t i = 0; i < width; i++) {
+        line[i] = gradient.lut[levels[i]];
     }
+    batch_count++;
+}
+
+void WaterfallWidget::flush() {
+    if (batch_count == 0)
+        return;
+
+    const auto screen_r = screen_rect();
+    const size_t width = bin_map.width();
+    const auto lines = static_cast<int32_t>(batch_count);
+    batch_count = 0;
 
-    const auto draw_y = display.scroll(1);
+    /* One scroll for the whole batch. The newest line lands at the top of the
+     * visible area, so the batch is drawn newest first, in at most two
+     * windows if it wraps past the bottom of the scroll area.
+     */
+    const auto top_y = display.scroll(lines);
+    const auto area_bottom = screen_r.bottom();
+    const auto first_rows = std::min<int32_t>(lines, area_bottom - top_y);
+
+    // Lines were queued oldest first.
+    for (int32_t a = 0, b = lines - 1; a < b; a++, b--) {
+        std::swap_ranges(&batch[a * width], &batch[a * width] + width, &batch[b * width]);
+    }
 
-    display.draw_pixels(
-        {{0, draw_y}, {pixel_row.size(), 1}},
-        pixel_row);
+    display.render_box({screen_r.left(), top_y}, {static_cast<int>(width), first_rows}, &batch[0]);
+    if (first_rows < lines) {
+        display.render_box({screen_r.left(), screen_r.top()}, {static_cast<int>(width), lines - first_rows}, &batch[first_rows * width]);
+    }
 }
 
 bool WaterfallWidget::on_touch(const TouchEvent event) {
@@ -319,6 +384,9 @@ WaterfallView::WaterfallView(const bool cursor) {
     frequency_scale.on_select = [this](int32_t offset) {
         if (on_select) on_select(offset);
     };
+    frequency_scale.on_show_options = [this]() {
+        if (on_show_options) on_show_options();
+    };
 
     waterfall_widget.on_touch_select = [this](int32_t x, int32_t y) {
         if (y > screen_height - screen_height * 0.1) return;  // prevent ghost touch
@@ -347,11 +415,40 @@ void WaterfallView::on_hide() {
 
 void WaterfallView::start() {
     if (!running_) {
-        baseband::spectrum_streaming_start();
+        if (zoom_decimation > 1) {
+            baseband::spectrum_streaming_zoom(zoom_offset, zoom_decimation);
+        } else {
+            baseband::spectrum_streaming_start();
+        }
         running_ = true;
     }
 }
 
+void WaterfallView::set_zoom(const int32_t offset, const uint32_t decimation) {
+    zoom_offset = (decimation > 1) ? offset : 0;
+    zoom_decimation = decimation;
+    frequency_scale.set_center_offset(zoom_offset);
+    if (running_) {
+        // Restart streaming with the new slice.
+        running_ = false;
+        start();
+    }
+}
+
+void WaterfallView::set_zoom_factor(const uint32_t decimation) {
+    if (decimation == zoom_decimation)
+        return;
+
+    // Keep the slice inside the channel: the centre may move at most (1 - 1/d) / 2 of it.
+    int32_t offset = (decimation > 1) ? frequency_scale.cursor_offset() : 0;
+    if (sampling_rate) {
+        const int32_t max_offset = int64_t(sampling_rate) * zoom_decimation * (decimation - 1) / (2 * decimation);
+        offset = std::clamp(offset, -max_offset, max_offset);
+    }
+    frequency_scale.set_cursor_position(0);
+    set_zoom(offset, decimation);
+}
+
 void WaterfallView::stop() {
     if (running_) {
         baseband::spectrum_streaming_stop();
@@ -394,6 +491,10 @@ void WaterfallView::set_parent_rect(const Rect new_parent_rect) {
     update_widgets_rect();
 }
 
+void WaterfallView::set_bin_reducer(const BinReducer reducer) {
+    waterfall_widget.set_bin_reducer(reducer);
+}
+
 void WaterfallView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
     waterfall_widget.on_channel_spectrum(spectrum);
     sampling_rate = spectrum.sampling_rate;
@@ -408,6 +509,41 @@ void WaterfallView::on_audio_spectrum() {
     audio_spectrum_view->on_audio_spectrum(audio_spectrum_data);
 }
 
+/* WaterfallOptionsView ************************************************/
+
+WaterfallOptionsView::WaterfallOptionsView(
+    WaterfallView& waterfall,
+    const Rect parent_rect,
+    const Style* const style)
+    : View{parent_rect} {
+    set_style(style);
+
+    add_children({
+        &label_zoom,
+        &field_zoom,
+        &label_bins,
+        &field_bins,
+    });
+
+    field_zoom.set_by_value(waterfall.zoom_factor());
+    field_zoom.on_change = [this, &waterfall](size_t, OptionsField::value_t v) {
+        waterfall.set_zoom_factor(v);
+        if (on_zoom_change) on_zoom_change(v);
+    };
+
+    field_bins.set_by_value(toUType(waterfall.bin_reducer()));
+    field_bins.on_change = [this, &waterfall](size_t, OptionsField::value_t v) {
+        const auto reducer = static_cast<BinReducer>(v);
+        waterfall.set_bin_reducer(reducer);
+        if (on_bin_reducer_change) on_bin_reducer_change(reducer);
+    };
+}
+
+void WaterfallOptionsView::set_zoom_visible(const bool visible) {
+    label_zoom.hidden(!visible);
+    field_zoom.hidden(!visible);
+}
+
 } /* namespace spectrum */
 
 uint32_t filter_bandwidth_for_sampling_rate(int32_t sampling_rate) {
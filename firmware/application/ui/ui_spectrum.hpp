@@ -25,6 +25,7 @@
 
 #include "ui.hpp"
 #include "ui_widget.hpp"
+#include "ui_spectrum_bins.hpp"
 #include "gradient.hpp"
 
 #include "event_m0.hpp"
@@ -33,6 +34,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <memory>
 
 namespace ui {
 namespace spectrum {
@@ -73,6 +75,7 @@ class AudioSpectrumView : public View {
 class FrequencyScale : public Widget {
    public:
     std::function<void(int32_t offset)> on_select{};
+    std::function<void(void)> on_show_options{};
 
     void on_show() override;
     void on_focus() override;
@@ -85,6 +88,10 @@ class FrequencyScale : public Widget {
     void set_spectrum_sampling_rate(const int new_sampling_rate);
     void set_channel_filter(const int low_frequency, const int high_frequency, const int transition);
     void set_cursor_position(const int32_t position);
+    /* Frequency (Hz from the channel centre) shown at the middle of the scale. */
+    void set_center_offset(const int32_t offset);
+    /* Frequency under the cursor, Hz from the channel centre. */
+    int32_t cursor_offset() const;
 
     void paint(Painter& painter) override;
 
@@ -92,6 +99,7 @@ class FrequencyScale : public Widget {
     static constexpr int filter_band_height = 4;
 
     int32_t cursor_position{0};
+    int32_t center_offset{0};
     int spectrum_sampling_rate{0};
     const int spectrum_bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
     int channel_filter_low_frequency{0};
@@ -111,6 +119,11 @@ class FrequencyScale : public Widget {
 
 class WaterfallWidget : public Widget {
    public:
+    /* Lines queued before they are drawn; matches the ChannelSpectrum FIFO
+     * depth so a whole frame's worth goes out in one transfer. */
+    static constexpr size_t batch_lines = 1 << ChannelSpectrumConfigMessage::fifo_k;
+    static constexpr size_t max_width = 320;
+
     std::function<void(int32_t offset, int32_t y)> on_touch_select{};
 
     Gradient gradient{};
@@ -120,15 +133,28 @@ class WaterfallWidget : public Widget {
     void paint(Painter&) override {}
     bool on_touch(const TouchEvent event) override;
 
+    void set_bin_reducer(const BinReducer reducer);
+    BinReducer get_bin_reducer() const { return bin_reducer; }
+
+    /* Queues one line, drawing the batch if it is full. */
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
+    /* Scrolls by the number of queued lines and draws them all. */
+    void flush();
 
    private:
+    SpectrumBinMap<std::tuple_size<decltype(ChannelSpectrum::db)>::value, max_width> bin_map{};
+    BinReducer bin_reducer{BinReducer::Crop};
+    std::unique_ptr<Color[]> batch{};
+    size_t batch_count{0};
+
     void clear();
 };
 
 class WaterfallView : public View {
    public:
     std::function<void(int32_t offset)> on_select{};
+    /* Called when the frequency scale gets focus, to show WaterfallOptionsView. */
+    std::function<void(void)> on_show_options{};
 
     WaterfallView(const bool cursor = false);
 
@@ -144,8 +170,17 @@ class WaterfallView : public View {
     void start();
     void stop();
 
+    /* Narrows the waterfall to sampling_rate / decimation around 'offset'
+     * (Hz from the channel centre). A decimation of 1 shows the full channel. */
+    void set_zoom(const int32_t offset, const uint32_t decimation);
+    /* Zooms around the cursor, or back out to the full channel for 1. */
+    void set_zoom_factor(const uint32_t decimation);
+    uint32_t zoom_factor() const { return zoom_decimation; }
+
     void set_parent_rect(const Rect new_parent_rect) override;
     void show_audio_spectrum_view(const bool show);
+    void set_bin_reducer(const BinReducer reducer);
+    BinReducer bin_reducer() const { return waterfall_widget.get_bin_reducer(); }
 
    private:
     void update_widgets_rect();
@@ -157,6 +192,8 @@ class WaterfallView : public View {
     WaterfallWidget waterfall_widget{};
     FrequencyScale frequency_scale{};
     bool running_{false};
+    int32_t zoom_offset{0};
+    uint32_t zoom_decimation{1};
 
     ChannelSpectrumFIFO* channel_fifo{nullptr};
     AudioSpectrum* audio_spectrum_data{nullptr};
@@ -190,6 +227,7 @@ class WaterfallView : public View {
                 while (channel_fifo->out(channel_spectrum)) {
                     this->on_channel_spectrum(channel_spectrum);
                 }
+                this->waterfall_widget.flush();
             }
             if (this->audio_spectrum_update) {
                 this->audio_spectrum_update = false;
@@ -201,6 +239,45 @@ class WaterfallView : public View {
     void on_audio_spectrum();
 };
 
+class WaterfallOptionsView : public View {
+   public:
+    WaterfallOptionsView(WaterfallView& waterfall, const Rect parent_rect, const Style* const style);
+
+    std::function<void(uint32_t decimation)> on_zoom_change{};
+    std::function<void(BinReducer reducer)> on_bin_reducer_change{};
+
+    /* Wideband spectrum has no zoom path. */
+    void set_zoom_visible(const bool visible);
+
+   private:
+    Text label_zoom{
+        {0 * 8, 0 * 16, 4 * 8, 1 * 16},
+        "ZOOM"};
+
+    OptionsField field_zoom{
+        {5 * 8, 0 * 16},
+        2,
+        {
+            {"x1", 1},
+            {"x2", 2},
+            {"x4", 4},
+            {"x8", 8},
+        }};
+
+    Text label_bins{
+        {9 * 8, 0 * 16, 4 * 8, 1 * 16},
+        "BINS"};
+
+    OptionsField field_bins{
+        {14 * 8, 0 * 16},
+        4,
+        {
+            {"Crop", toUType(BinReducer::Crop)},
+            {"Dec", toUType(BinReducer::Decimate)},
+            {"Max", toUType(BinReducer::MaxPool)},
+        }};
+};
+
 } /* namespace spectrum */
 
 /* Calculates the best anti_alias_baseband_bandwidth_filter for the given sampling rate. */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_SPECTRUM_BINS_H__
+#define __UI_SPECTRUM_BINS_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+namespace spectrum {
+
+/* How the FFT bins of a spectrum line are fitted to the screen width. */
+enum class BinReducer : uint8_t {
+    Crop,      // one bin per column, the band edges beyond the width are cut off
+    Decimate,  // full span, the nearest bin for each column
+    MaxPool,   // full span, the strongest of the bins under each column
+};
+
+/* Column to bin mapping for one reducer and width, worked out once so each
+ * line is a table walk. Input bins are in FFT order (DC first, negative
+ * frequencies in the upper half); output columns run from the lowest
+ * frequency to the highest.
+ */
+template <size_t Bins, size_t MaxWidth>
+class SpectrumBinMap {
+   public:
+    void configure(const BinReducer reducer, const size_t width) {
+        reducer_ = reducer;
+        width_ = std::min(width, MaxWidth);
+        if (width_ == 0)
+            return;  // Not laid out yet; configured again once the width is known.
+
+        for (size_t c = 0; c <= width_; c++) {
+            size_t start;
+            if (reducer_ == BinReducer::Crop && width_ <= Bins) {
+                start = c + (Bins - width_) / 2;
+            } else {
+                start = c * Bins / width_;
+            }
+            start_[c] = start;
+        }
+    }
+
+    size_t width() const { return width_; }
+    BinReducer reducer() const { return reducer_; }
+
+    void reduce(const std::array<uint8_t, Bins>& db, uint8_t* const out) const {
+        constexpr size_t half = Bins / 2;
+        if (reducer_ != BinReducer::MaxPool) {
+            for (size_t c = 0; c < width_; c++) {
+                out[c] = db[(start_[c] + half) % Bins];
+            }
+            return;
+        }
+
+        for (size_t c = 0; c < width_; c++) {
+            const size_t end = std::max<size_t>(start_[c + 1], start_[c] + 1);
+            uint8_t peak = 0;
+            for (size_t i = start_[c]; i < end; i++) {
+                peak = std::max(peak, db[(i + half) % Bins]);
+            }
+            out[c] = peak;
+        }
+    }
+
+   private:
+    std::array<uint16_t, MaxWidth + 1> start_{};
+    size_t width_{0};
+    BinReducer reducer_{BinReducer::Crop};
+};
+
+} /* namespace spectrum */
+} /* namespace ui */
+
+#endif /*__UI_SPECTRUM_BINS_H__*/
@@ -27,6 +27,8 @@
 #include "hackrf_hal.hpp"
 using namespace hackrf::one;
 
+#include "portapack_shared_memory.hpp"
+#include "rtc_time.hpp"
 #include "string_format.hpp"
 
 namespace ui {
@@ -36,7 +38,17 @@ namespace ui {
 BasebandStatsView::BasebandStatsView() {
     add_children({
         &text_stats,
+        &text_packets,
     });
+
+    last_packets_delivered = shared_memory.packet_batch.delivered() + shared_memory.packet_batch.overflowed();
+    signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+        this->on_tick_second();
+    };
+}
+
+BasebandStatsView::~BasebandStatsView() {
+    rtc_time::signal_tick_second -= signal_token_tick_second;
 }
 
 static std::string ticks_to_percent_string(const uint32_t ticks) {
@@ -55,4 +67,12 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
     text_stats.set(message);
 }
 
+void BasebandStatsView::on_tick_second() {
+    // Packets the M0 took from the batch ring, or that overflowed into the application queue, in the last second.
+    const auto delivered = shared_memory.packet_batch.delivered() + shared_memory.packet_batch.overflowed();
+    text_packets.set("Pkt/s " + to_string_dec_uint(delivered - last_packets_delivered) +
+                     " dropped " + to_string_dec_uint(shared_memory.packet_batch.dropped()));
+    last_packets_delivered = delivered;
+}
+
 } /* namespace ui */
@@ -33,6 +33,7 @@ namespace ui {
 class BasebandStatsView : public View {
    public:
     BasebandStatsView();
+    ~BasebandStatsView();
 
    private:
     Text text_stats{
@@ -40,6 +41,14 @@ class BasebandStatsView : public View {
         "",
     };
 
+    Text text_packets{
+        {0 * 8, 1 * 16, 30 * 8, 1 * 16},
+        "",
+    };
+
+    SignalToken signal_token_tick_second{};
+    uint32_t last_packets_delivered{0};
+
     MessageHandlerRegistration message_handler_stats{
         Message::ID::BasebandStatistics,
         [this](const Message* const p) {
@@ -47,6 +56,7 @@ class BasebandStatsView : public View {
         }};
 
     void on_statistics_update(const BasebandStatistics& statistics);
+    void on_tick_second();
 };
 
 } /* namespace ui */
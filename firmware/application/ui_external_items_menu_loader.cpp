@@ -6,10 +6,126 @@
 
 #include "i2cdevmanager.hpp"
 #include "i2cdev_ppmod.hpp"
+#include "lz4.h"
+#include "string_format.hpp"
+#include "usb_serial_asyncmsg.hpp"
 
 namespace ui {
 
 /* static */ std::vector<DynamicBitmap<16, 16>> ExternalItemsMenuLoader::bitmaps;
+/* static */ uint32_t ExternalItemsMenuLoader::last_launch_ms_{0};
+/* static */ bool ExternalItemsMenuLoader::last_launch_compressed_{false};
+
+namespace {
+
+const std::filesystem::path manifest_file = settings_dir / u"apps_manifest.bin";
+
+ExternalAppManifest manifest{};
+bool manifest_valid = false;
+bool manifest_loaded = false;
+bool manifest_subscribed = false;
+uint32_t manifest_generation = 0;
+
+bool read_manifest_header(ExternalAppManifest::Entry& entry) {
+    File app;
+    auto openError = app.open(apps_dir / entry.file_name);
+    if (openError)
+        return false;
+
+    auto& record = entry.record;
+    if (record.kind == ExternalAppManifest::Kind::External) {
+        application_information_t application_information = {};
+        auto readResult = app.read(&application_information, sizeof(application_information_t));
+        if (!readResult)
+            return false;
+
+        record.header_version = application_information.header_version;
+        record.app_version = application_information.app_version;
+        record.icon_color = application_information.icon_color;
+        record.desired_position = application_information.desired_menu_position;
+        record.menu_location = application_information.menu_location;
+        memcpy(record.app_name, application_information.app_name, sizeof(record.app_name));
+        memcpy(record.bitmap_data, application_information.bitmap_data, sizeof(record.bitmap_data));
+    } else {
+        standalone_application_information_t application_information = {};
+        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
+        if (!readResult)
+            return false;
+
+        record.header_version = application_information.header_version;
+        record.icon_color = application_information.icon_color;
+        record.desired_position = -1;
+        record.menu_location = application_information.menu_location;
+        memcpy(record.app_name, application_information.app_name, sizeof(record.app_name));
+        memcpy(record.bitmap_data, application_information.bitmap_data, sizeof(record.bitmap_data));
+    }
+
+    return true;
+}
+
+void save_manifest() {
+    File file;
+    if (file.create(manifest_file))
+        return;
+
+    if (!manifest.save(file)) {
+        file.close();
+        delete_file(manifest_file);
+    }
+}
+
+}  // namespace
+
+// Headers of all apps on the SD card, from RAM while nothing on the card
+// was written since the last build. Otherwise the directory is listed again
+// and only new or changed files are opened.
+/* static */ const std::vector<ExternalAppManifest::Entry>& ExternalItemsMenuLoader::manifest_entries() {
+    if (!manifest_subscribed) {
+        sd_card::status_signal += [](const sd_card::Status) {
+            // A different card may have been inserted.
+            manifest_valid = false;
+            manifest_loaded = false;
+            manifest.clear();
+        };
+        manifest_subscribed = true;
+    }
+
+    if (sd_card::status() != sd_card::Status::Mounted) {
+        manifest_valid = false;
+        manifest_loaded = false;
+        manifest.clear();
+        return manifest.entries();
+    }
+
+    if (manifest_valid && manifest_generation == file_write_generation() && !manifest.dirty())
+        return manifest.entries();
+
+    if (!manifest_loaded) {
+        File file;
+        if (!file.open(manifest_file))
+            manifest.load(file);
+        manifest_loaded = true;
+    }
+
+    std::vector<ExternalAppManifest::ScanItem> scan;
+    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
+        if (std::filesystem::is_regular_file(entry.status()))
+            scan.push_back({entry.path(), static_cast<uint32_t>(entry.size()), ExternalAppManifest::pack_time(entry.fat_date(), entry.fat_time()), ExternalAppManifest::Kind::External});
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
+        if (std::filesystem::is_regular_file(entry.status()))
+            scan.push_back({entry.path(), static_cast<uint32_t>(entry.size()), ExternalAppManifest::pack_time(entry.fat_date(), entry.fat_time()), ExternalAppManifest::Kind::Standalone});
+    }
+
+    manifest.rebuild(scan, read_manifest_header);
+    if (manifest.dirty())
+        save_manifest();
+
+    // Taken after saving, so writing the manifest itself doesn't invalidate it.
+    manifest_generation = file_write_generation();
+    manifest_valid = true;
+    return manifest.entries();
+}
 
 // iterates over all possible ext apps-s, and if it is runnable on the current system, it'll call the callback, and pass minimal info. used to print to console, and for autostart setting's app list. where the minimal info is enough
 // please keep in sync with load_external_items
@@ -37,62 +153,20 @@ namespace ui {
         }
     }
 
-    if (sd_card::status() != sd_card::Status::Mounted)
-        return;
-
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
+    for (const auto& entry : manifest_entries()) {
+        const auto& header = entry.record;
+        if (header.kind == ExternalAppManifest::Kind::External) {
+            if (header.header_version != CURRENT_HEADER_VERSION)
+                continue;
 
-        if (application_information.header_version != CURRENT_HEADER_VERSION)
+            if (VERSION_MD5 != header.app_version)
+                continue;
+        } else if (header.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
             continue;
 
-        bool versionMatches = VERSION_MD5 == application_information.app_version;
-
-        if (versionMatches) {
-            std::string appshortname = filePath.filename().string();
-            if (appshortname.size() >= 5 && appshortname.substr(appshortname.size() - 5) == ".ppma") {
-                // Remove the ".ppma" suffix
-                appshortname = appshortname.substr(0, appshortname.size() - 5);
-            }
-            AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
-            callback(appInfoConsole);
-        }
-    }
-
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
-
-        if (application_information.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
-            continue;
-
-        std::string appshortname = filePath.filename().string();
-        if (appshortname.size() >= 5 && appshortname.substr(appshortname.size() - 5) == ".ppmp") {
-            // Remove the ".ppmp" suffix
-            appshortname = appshortname.substr(0, appshortname.size() - 5);
-        }
-        AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
+        std::string appshortname = entry.file_name.stem().string();
+        std::string appname{reinterpret_cast<const char*>(&header.app_name[0]), strnlen(reinterpret_cast<const char*>(&header.app_name[0]), sizeof(header.app_name))};
+        AppInfoConsole appInfoConsole = {appshortname.c_str(), appname.c_str(), static_cast<app_location_t>(header.menu_location)};
         callback(appInfoConsole);
     }
 }
@@ -157,107 +231,82 @@ namespace ui {
         }
     }
 
-    if (sd_card::status() != sd_card::Status::Mounted)
-        return external_apps;
-
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
+    for (const auto& entry : manifest_entries()) {
+        const auto& header = entry.record;
+        if (header.menu_location != app_location)
             continue;
 
-        application_information_t application_information = {};
+        auto filePath = apps_dir / entry.file_name;
 
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
+        GridItemEx gridItem = {};
+        gridItem.text = std::string{reinterpret_cast<const char*>(&header.app_name[0]), strnlen(reinterpret_cast<const char*>(&header.app_name[0]), sizeof(header.app_name))};
 
-        if (application_information.menu_location != app_location)
-            continue;
+        if (header.kind == ExternalAppManifest::Kind::External) {
+            if (header.header_version != CURRENT_HEADER_VERSION)
+                continue;
 
-        if (application_information.header_version != CURRENT_HEADER_VERSION)
-            continue;
+            bool versionMatches = VERSION_MD5 == header.app_version;
+            bool checksumBad = header.checksum_known && header.checksum != EXT_APP_EXPECTED_CHECKSUM;
 
-        bool versionMatches = VERSION_MD5 == application_information.app_version;
+            if (versionMatches && !checksumBad) {
+                gridItem.color = Color((uint16_t)header.icon_color);
 
-        GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
+                auto dyn_bmp = DynamicBitmap<16, 16>{header.bitmap_data};
+                gridItem.bitmap = dyn_bmp.bitmap();
+                bitmaps.push_back(std::move(dyn_bmp));
 
-        if (versionMatches) {
-            gridItem.color = Color((uint16_t)application_information.icon_color);
+                gridItem.on_select = [&nav, app_location, filePath]() {
+                    if (!run_external_app(nav, filePath)) {
+                        nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
+                    }
+                };
+            } else {
+                gridItem.color = Theme::getInstance()->fg_light->foreground;
 
-            auto dyn_bmp = DynamicBitmap<16, 16>{application_information.bitmap_data};
-            gridItem.bitmap = dyn_bmp.bitmap();
-            bitmaps.push_back(std::move(dyn_bmp));
+                gridItem.bitmap = &bitmap_sd_card_error;
 
-            gridItem.on_select = [&nav, app_location, filePath]() {
-                if (!run_external_app(nav, filePath)) {
-                    nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
+                if (checksumBad) {
+                    gridItem.on_select = [&nav, filePath]() {
+                        // Retry, the file may have been read back wrong last time.
+                        if (!run_external_app(nav, filePath)) {
+                            nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder is corrupt. Please\nupdate your SD Card content.");
+                        }
+                    };
+                } else {
+                    gridItem.on_select = [&nav]() {
+                        nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder is outdated. Please\nupdate your SD Card content.");
+                    };
                 }
-            };
+            }
 
-            gridItem.desired_position = application_information.desired_menu_position;
+            gridItem.desired_position = header.desired_position;
         } else {
-            gridItem.color = Theme::getInstance()->fg_light->foreground;
+            if (header.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
+                continue;
 
-            gridItem.bitmap = &bitmap_sd_card_error;
+            gridItem.color = Color((uint16_t)header.icon_color);
 
-            gridItem.on_select = [&nav]() {
-                nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder is outdated. Please\nupdate your SD Card content.");
+            auto dyn_bmp = DynamicBitmap<16, 16>{header.bitmap_data};
+            gridItem.bitmap = dyn_bmp.bitmap();
+            bitmaps.push_back(std::move(dyn_bmp));
+
+            gridItem.on_select = [&nav, app_location, filePath]() {
+                if (!run_standalone_app(nav, filePath)) {
+                    nav.display_modal("Error", "The .ppmp file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
+                }
             };
 
-            gridItem.desired_position = application_information.desired_menu_position;
+            gridItem.desired_position = -1;  // No desired position support for standalone apps yet
         }
 
         external_apps.push_back(gridItem);
     }
 
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
-
-        if (application_information.menu_location != app_location)
-            continue;
-
-        if (application_information.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
-            continue;
-
-        GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
-
-        gridItem.color = Color((uint16_t)application_information.icon_color);
-
-        auto dyn_bmp = DynamicBitmap<16, 16>{application_information.bitmap_data};
-        gridItem.bitmap = dyn_bmp.bitmap();
-        bitmaps.push_back(std::move(dyn_bmp));
-
-        gridItem.on_select = [&nav, app_location, filePath]() {
-            if (!run_standalone_app(nav, filePath)) {
-                nav.display_modal("Error", "The .ppmp file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
-            }
-        };
-
-        gridItem.desired_position = -1;  // No desired position support for standalone apps yet
-
-        external_apps.push_back(gridItem);
-    }
-
     return external_apps;
 }
 
 /* static */ bool ExternalItemsMenuLoader::run_external_app(ui::NavigationView& nav, std::filesystem::path filePath) {
+    const auto start = chTimeNow();
     File app;
     uint32_t checksum{0};
 
@@ -271,71 +320,112 @@ namespace ui {
     if (!readResult)
         return false;
 
-    app.seek(0);
+    bool compressed = load_compressed_image(filePath, app, checksum);
 
-    if (application_information.m4_app_offset != 0) {
-        // copy application image
-        for (size_t file_read_index = 0; file_read_index < application_information.m4_app_offset; file_read_index += std::filesystem::max_file_block_size) {
-            auto bytes_to_read = std::filesystem::max_file_block_size;
-            if (file_read_index + std::filesystem::max_file_block_size > application_information.m4_app_offset)
-                bytes_to_read = application_information.m4_app_offset - file_read_index;
+    if (!compressed) {
+        checksum = 0;
+        app.seek(0);
 
-            if (bytes_to_read == 0)
-                break;
+        if (application_information.m4_app_offset != 0) {
+            // copy application image
+            auto loaded = load_image(app, application_information.memory_location, application_information.m4_app_offset, checksum);
+            if (!loaded || *loaded != application_information.m4_app_offset)
+                return false;
 
-            readResult = app.read(&application_information.memory_location[file_read_index], bytes_to_read);
-            if (!readResult)
+            // copy baseband image, the trailing checksum word lands right after it
+            auto baseband_size = std::min<size_t>(app.size() - application_information.m4_app_offset, portapack::memory::map::m4_code.size());
+            loaded = load_image(app, reinterpret_cast<uint8_t*>(portapack::memory::map::m4_code.base()), baseband_size, checksum);
+            if (!loaded)
                 return false;
+        } else {
+            // copy application image
+            auto loaded = load_image(app, application_information.memory_location, 80 * std::filesystem::max_file_block_size, checksum);
+            if (!loaded)
+                return false;
+        }
+    }
 
-            checksum += simple_checksum((uint32_t)&application_information.memory_location[file_read_index], readResult.value());
+    manifest.set_checksum(filePath.filename(), checksum);
 
-            if (readResult.value() < std::filesystem::max_file_block_size)
-                break;
-        }
+    if (checksum != EXT_APP_EXPECTED_CHECKSUM)
+        return false;
 
-        // copy baseband image
-        for (size_t file_read_index = application_information.m4_app_offset;; file_read_index += readResult.value()) {
-            size_t bytes_to_read = std::filesystem::max_file_block_size;
+    last_launch_ms_ = (chTimeNow() - start) * 1000 / CH_FREQUENCY;
+    last_launch_compressed_ = compressed;
+    UsbSerialAsyncmsg::asyncmsg(filePath.filename().string() + (compressed ? " (lz4)" : "") + " loaded in " + to_string_dec_uint(last_launch_ms_) + " ms");
 
-            // not aligned
-            if ((file_read_index % std::filesystem::max_file_block_size) != 0)
-                bytes_to_read = std::filesystem::max_file_block_size - (file_read_index % std::filesystem::max_file_block_size);
+    application_information.externalAppEntry(nav);
+    return true;
+}
 
-            if (bytes_to_read == 0)
-                break;
+/* static */ File::Result<File::Size> ExternalItemsMenuLoader::load_image(File& file, uint8_t* destination, size_t length, uint32_t& checksum) {
+    // A cluster is the longest run FatFs is sure to move with one multi-sector
+    // read straight into destination, without going through its sector buffer.
+    const size_t block_size = std::max<size_t>(sd_card::fs.csize, 1) * std::filesystem::max_file_block_size;
+    size_t loaded = 0;
 
-            auto target_memory = reinterpret_cast<void*>(portapack::memory::map::m4_code.base() + file_read_index - application_information.m4_app_offset);
+    while (loaded < length) {
+        auto readResult = file.read(&destination[loaded], std::min(block_size, length - loaded));
+        if (readResult.is_error())
+            return readResult.error();
 
-            readResult = app.read(target_memory, bytes_to_read);
-            if (!readResult)
-                return false;
+        // Summed while the block is fresh instead of in a second pass over the image.
+        checksum += simple_checksum((uint32_t)&destination[loaded], *readResult);
+        loaded += *readResult;
+
+        if (*readResult == 0)
+            break;
+    }
 
-            checksum += simple_checksum((uint32_t)target_memory, readResult.value());
+    return loaded;
+}
 
-            if (readResult.value() != bytes_to_read)
-                break;
-        }
-    } else {
-        // copy application image
-        for (size_t file_read_index = 0; file_read_index < 80 * std::filesystem::max_file_block_size; file_read_index += std::filesystem::max_file_block_size) {
-            auto bytes_to_read = std::filesystem::max_file_block_size;
+/* static */ bool ExternalItemsMenuLoader::load_compressed_image(const std::filesystem::path& filePath, File& ppma, uint32_t& checksum) {
+    constexpr size_t block_end_pad = 4;
+    const auto& region = portapack::memory::map::m4_code;
 
-            readResult = app.read(&application_information.memory_location[file_read_index], bytes_to_read);
-            if (!readResult)
-                return false;
+    auto packedPath = filePath;
+    packedPath.replace_extension(u".ppmz");
 
-            checksum += simple_checksum((uint32_t)&application_information.memory_location[file_read_index], readResult.value());
+    File packed;
+    if (packed.open(packedPath))
+        return false;
 
-            if (readResult.value() < std::filesystem::max_file_block_size)
-                break;
-        }
-    }
+    compressed_application_header_t header{};
+    auto readResult = packed.read(&header, sizeof(header));
+    if (!readResult || *readResult != sizeof(header))
+        return false;
 
-    if (checksum != EXT_APP_EXPECTED_CHECKSUM)
+    // Must be the same image as the .ppma, which ends with the same checksum
+    // word: a .ppmz left behind by an older .ppma of the same size is caught
+    // here and the .ppma is loaded instead. Decompressing from the end of the
+    // region must not overrun its input.
+    const auto ppma_size = ppma.size();
+    uint32_t ppma_checksum{0};
+    if (ppma_size < sizeof(ppma_checksum) || !ppma.seek(ppma_size - sizeof(ppma_checksum)))
+        return false;
+    readResult = ppma.read(&ppma_checksum, sizeof(ppma_checksum));
+    if (!readResult || *readResult != sizeof(ppma_checksum))
         return false;
 
-    application_information.externalAppEntry(nav);
-    return true;
+    const size_t inplace_margin = (header.compressed_size >> 8) + 32;
+    if (header.magic != COMPRESSED_APPLICATION_MAGIC ||
+        header.checksum != ppma_checksum ||
+        header.image_size + sizeof(uint32_t) != ppma_size ||
+        packed.size() != sizeof(header) + header.compressed_size + block_end_pad ||
+        header.image_size + inplace_margin + block_end_pad > region.size())
+        return false;
+
+    auto source = reinterpret_cast<uint8_t*>(region.end()) - header.compressed_size - block_end_pad;
+    uint32_t ignored{0};
+    auto loaded = load_image(packed, source, header.compressed_size + block_end_pad, ignored);
+    if (!loaded || *loaded != header.compressed_size + block_end_pad)
+        return false;
+
+    unlz4_len(source, reinterpret_cast<void*>(region.base()), header.compressed_size);
+
+    checksum = simple_checksum(region.base(), header.image_size) + header.checksum;
+    return checksum == EXT_APP_EXPECTED_CHECKSUM;
 }
 
 // TODO: implement baseband image support
@@ -29,6 +29,7 @@
 #include "standalone_app.hpp"
 
 #include "file.hpp"
+#include "external_app_manifest.hpp"
 
 #define EXT_APP_EXPECTED_CHECKSUM 0x00000000
 
@@ -66,8 +67,19 @@ class ExternalItemsMenuLoader {
     static bool run_module_app(ui::NavigationView&, uint8_t*, size_t);
     static void load_all_external_items_callback(std::function<void(AppInfoConsole&)> callback, bool module_included = false);
 
+    // Time from opening the file to handing over to the app, for the last successful run_external_app.
+    static uint32_t last_launch_ms() { return last_launch_ms_; }
+    static bool last_launch_compressed() { return last_launch_compressed_; }
+
    private:
     static std::vector<DynamicBitmap<16, 16>> bitmaps;
+
+    static uint32_t last_launch_ms_;
+    static bool last_launch_compressed_;
+
+    static const std::vector<ExternalAppManifest::Entry>& manifest_entries();
+    static File::Result<File::Size> load_image(File& file, uint8_t* destination, size_t length, uint32_t& checksum);
+    static bool load_compressed_image(const std::filesystem::path& filePath, File& ppma, uint32_t& checksum);
 };
 
 }  // namespace ui
@@ -675,6 +675,7 @@ static void cmd_appstart(BaseSequentialStream* chp, int argc, char* argv[]) {
         chprintf(chp, "error\r\n");
         return;
     }
+    chprintf(chp, "loaded in %d ms%s\r\n", (int)ui::ExternalItemsMenuLoader::last_launch_ms(), ui::ExternalItemsMenuLoader::last_launch_compressed() ? " (lz4)" : "");
     chprintf(chp, "ok\r\n");
 }
 
@@ -1188,6 +1189,73 @@ static void cmd_sysinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
     return;
 }
 
+static void cmd_m4prof(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: m4prof [reset|hist]\r\nPrints M4 DSP cycles per buffer for each stage.\r\n";
+    static const char* const stage_names[M4ProfileTable::StageCount] = {"decim_0", "decim_1", "demod", "chan_stats", "buffer"};
+
+    bool show_histogram = false;
+    if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        shared_memory.m4_profile.reset_request = true;
+        chprintf(chp, "ok\r\n");
+        return;
+    } else if (argc == 1 && strcmp(argv[0], "hist") == 0) {
+        show_histogram = true;
+    } else if (argc > 0) {
+        chprintf(chp, usage);
+        return;
+    }
+
+    std::string info = "stage count min avg max\r\n";
+    for (size_t i = 0; i < M4ProfileTable::StageCount; i++) {
+        const M4ProfileStage stage = shared_memory.m4_profile.stages[i];
+        const uint32_t avg = stage.count ? static_cast<uint32_t>(stage.total / stage.count) : 0;
+        info += std::string(stage_names[i]) + " " +
+                to_string_dec_uint(stage.count) + " " +
+                to_string_dec_uint(stage.count ? stage.min : 0) + " " +
+                to_string_dec_uint(avg) + " " +
+                to_string_dec_uint(stage.max) + "\r\n";
+
+        if (show_histogram) {
+            info += " 2^" + to_string_dec_uint(M4ProfileStage::histogram_base) + "..:";
+            for (size_t b = 0; b < M4ProfileStage::histogram_bins; b++) {
+                info += " " + to_string_dec_uint(stage.histogram[b]);
+            }
+            info += "\r\n";
+        }
+    }
+
+    fillOBuffer(&((SerialUSBDriver*)chp)->oqueue, (const uint8_t*)info.c_str(), info.length());
+}
+
+static void cmd_lcdstats(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: lcdstats [reset]\r\nPrints LCD pixels pushed per frame.\r\n";
+
+    auto evtd = getEventDispatcherInstance();
+    if (!evtd) return;
+    auto& painter = evtd->getPainter();
+
+    if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        painter.reset_frame_stats();
+        chprintf(chp, "ok\r\n");
+        return;
+    } else if (argc > 0) {
+        chprintf(chp, usage);
+        return;
+    }
+
+    const auto& stats = painter.frame_stats();
+    const uint32_t avg = stats.frames ? static_cast<uint32_t>(stats.total_pixels / stats.frames) : 0;
+    std::string info =
+        "frames: " + to_string_dec_uint(stats.frames) + "\r\n" +
+        "last px: " + to_string_dec_uint(stats.last_pixels) + "\r\n" +
+        "avg px: " + to_string_dec_uint(avg) + "\r\n" +
+        "peak px: " + to_string_dec_uint(stats.peak_pixels) + "\r\n" +
+        "damage rects: " + to_string_dec_uint(stats.damage_rects) + "\r\n" +
+        "damage px: " + to_string_dec_uint(static_cast<uint32_t>(stats.damage_pixels)) + "\r\n";
+
+    fillOBuffer(&((SerialUSBDriver*)chp)->oqueue, (const uint8_t*)info.c_str(), info.length());
+}
+
 static void cmd_radioinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
     const char* usage = "usage: radioinfo\r\n";
     (void)argv;
@@ -1411,6 +1479,8 @@ static const ShellCommand commands[] = {
     {"gotenv", cmd_gotenv},
     {"gotlight", cmd_gotlight},
     {"sysinfo", cmd_sysinfo},
+    {"m4prof", cmd_m4prof},
+    {"lcdstats", cmd_lcdstats},
     {"radioinfo", cmd_radioinfo},
     {"pmemreset", cmd_pmemreset},
     {"settingsreset", cmd_settingsreset},
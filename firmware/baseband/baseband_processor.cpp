@@ -22,10 +22,12 @@
 #include "baseband_processor.hpp"
 
 #include "portapack_shared_memory.hpp"
+#include "m4_profiler.hpp"
 
 #include "message.hpp"
 
 void BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
+    m4_profiler::ScopedTimer timer{m4_profiler::Stage::ChannelStats};
     channel_stats.feed(
         channel,
         [](const ChannelStatistics& statistics) {
@@ -32,6 +32,7 @@
 using namespace lpc43xx;
 
 #include "portapack_shared_memory.hpp"
+#include "m4_profiler.hpp"
 
 #include "utility.hpp"
 
@@ -79,6 +80,7 @@ void BasebandThread::set_sampling_rate(uint32_t new_sampling_rate) {
 void BasebandThread::run() {
     baseband_sgpio.init();
     baseband::dma::init();
+    m4_profiler::enable();
 
     const auto baseband_buffer = std::make_unique<std::array<baseband::sample_t, 8192>>();
     baseband::dma::configure(baseband_buffer->data(), direction());
@@ -109,9 +111,14 @@ void BasebandThread::run() {
                 shared_memory.m4_performance_counter = max;
             }
 
+            m4_profiler::service();
+
             if (baseband_processor_) {
+                m4_profiler::ScopedTimer timer{m4_profiler::Stage::Buffer};
                 baseband_processor_->execute(buffer);
             }
+
+            shared_memory.packet_batch.service();
         }
     }
 
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_CHANNELIZER_H__
+#define __DSP_CHANNELIZER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <complex>
+
+#include "dsp_types.hpp"
+#include "dsp_fft.hpp"
+#include "utility.hpp"
+
+namespace dsp {
+namespace channelizer {
+
+/* constexpr sin(x) for any x, folded onto fft_sine_quadrant(). */
+constexpr double sine(const double x) {
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double two_pi = 2.0 * pi;
+    double r = x - two_pi * static_cast<int64_t>(x / two_pi);
+    if (r < 0.0) r += two_pi;
+    if (r <= pi / 2) return fft_sine_quadrant(r);
+    if (r <= pi) return fft_sine_quadrant(pi - r);
+    if (r <= 3 * pi / 2) return -fft_sine_quadrant(r - pi);
+    return -fft_sine_quadrant(two_pi - r);
+}
+
+/* Blackman-Harris windowed sinc low-pass with its first null at fs / N, so
+ * neighbouring channels cross at about -6dB. Scaled to a peak tap of 32767.
+ */
+template <size_t N, size_t P>
+constexpr std::array<int16_t, N * P> make_prototype() {
+    constexpr double pi = 3.14159265358979323846;
+    constexpr size_t L = N * P;
+    std::array<double, L> h{};
+    double peak = 0.0;
+    for (size_t n = 0; n < L; n++) {
+        const double t = (static_cast<double>(n) - (L - 1) / 2.0) / N;
+        const double sinc = (t == 0.0) ? 1.0 : sine(pi * t) / (pi * t);
+        const double x = 2.0 * pi * (n + 0.5) / L;
+        const double w = 0.35875 - 0.48829 * sine(x + pi / 2) + 0.14128 * sine(2 * x + pi / 2) - 0.01168 * sine(3 * x + pi / 2);
+        h[n] = sinc * w;
+        peak = (h[n] > peak) ? h[n] : peak;
+    }
+
+    std::array<int16_t, L> taps{};
+    for (size_t n = 0; n < L; n++) {
+        const double q15 = h[n] / peak * 32767.0;
+        taps[n] = static_cast<int16_t>(q15 < 0.0 ? q15 - 0.5 : q15 + 0.5);
+    }
+    return taps;
+}
+
+template <size_t L>
+constexpr float prototype_sum(const std::array<int16_t, L>& taps) {
+    int32_t sum = 0;
+    for (const auto h : taps) {
+        sum += h;
+    }
+    return static_cast<float>(sum);
+}
+
+template <size_t N>
+constexpr std::array<uint8_t, N> make_bit_reverse() {
+    std::array<uint8_t, N> table{};
+    for (size_t i = 0; i < N; i++) {
+        size_t r = 0;
+        for (size_t b = 1, v = i; b < N; b <<= 1, v >>= 1) {
+            r = (r << 1) | (v & 1);
+        }
+        table[i] = static_cast<uint8_t>(r);
+    }
+    return table;
+}
+
+/* Critically sampled polyphase FFT filterbank: N channels of fs / N each,
+ * P taps per polyphase branch. Each block of N input samples runs the N*P
+ * tap prototype across the branches, then one N point FFT yields a sample
+ * for every channel at once.
+ *
+ * Only channel power is needed for activity detection, so blocks are run
+ * over the start of each buffer instead of the whole stream. That keeps the
+ * filter history inside one buffer and lets the caller trade cycles for
+ * estimate variance.
+ */
+template <size_t N, size_t P>
+class PolyphaseChannelizer {
+   public:
+    static_assert(power_of_two(N) && (N >= 4) && (N <= 256), "N must be a power of two, 4..256");
+
+    static constexpr size_t channel_count = N;
+    static constexpr size_t taps = N * P;
+    static constexpr std::array<int16_t, taps> prototype = make_prototype<N, P>();
+    static constexpr std::array<uint8_t, N> bit_reverse = make_bit_reverse<N>();
+
+    /* Most blocks a buffer of 'count' samples can provide. */
+    static constexpr size_t max_blocks(const size_t count) {
+        return (count < taps) ? 0 : (count - taps) / N + 1;
+    }
+
+    /* Runs up to 'blocks' filterbank outputs from the start of src and adds
+     * each channel's |X|^2, normalized to a full scale tone == 1.0, into
+     * power. power[0] is the lowest frequency channel. Returns the number
+     * of blocks actually run.
+     */
+    size_t accumulate(const buffer_c8_t& src, size_t blocks, std::array<float, N>& power) {
+        blocks = std::min(blocks, max_blocks(src.count));
+
+        for (size_t m = 0; m < blocks; m++) {
+            /* Newest sample of this block. */
+            const complex8_t* const x = &src.p[taps - 1 + m * N];
+
+            for (size_t k = 0; k < N; k++) {
+                int32_t re = 0;
+                int32_t im = 0;
+                for (size_t p = 0; p < P; p++) {
+                    const int32_t h = prototype[p * N + k];
+                    const auto s = x[-static_cast<ptrdiff_t>(p * N + k)];
+                    re += h * s.real();
+                    im += h * s.imag();
+                }
+                work[bit_reverse[k]] = {static_cast<float>(re), static_cast<float>(im)};
+            }
+
+            fft_c_preswapped_radix4(work);
+
+            /* Forward FFT bin b holds the channel at -b * fs / N. */
+            for (size_t i = 0; i < N; i++) {
+                const size_t bin = (N + N / 2 - i) & (N - 1);
+                power[i] += magnitude_squared(work[bin]) * normalization;
+            }
+        }
+
+        return blocks;
+    }
+
+   private:
+    /* A full scale (128) tone at a channel centre comes out at 128 * sum(h). */
+    static constexpr float dc_gain = prototype_sum(prototype) * 128.0f;
+    static constexpr float normalization = 1.0f / (dc_gain * dc_gain);
+
+    std::array<std::complex<float>, N> work{};
+};
+
+} /* namespace channelizer */
+} /* namespace dsp */
+
+#endif /*__DSP_CHANNELIZER_H__*/
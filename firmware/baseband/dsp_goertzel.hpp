@@ -24,6 +24,11 @@
 #define __DSP_GOERTZEL_H__
 
 #include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstddef>
+#include <array>
+#include <cmath>
 
 namespace dsp {
 
@@ -38,6 +43,107 @@ class GoertzelDetector {
     int16_t s[3]{0};
 };
 
+/* Goertzel filters for a fixed list of tones, fed one sample at a time.
+ *
+ * Two sets of filter states run half a window apart, so a result covering
+ * the last window_length samples is ready every window_length / 2 samples.
+ * The confidence of the strongest tone is its share of the power across the
+ * bank: near 1.0 for a clean tone, around 1 / N for noise. Energy outside the
+ * bank's band (speech, mostly) doesn't count against it.
+ */
+template <size_t N>
+class GoertzelBank {
+   public:
+    struct Result {
+        size_t index;
+        float confidence;
+    };
+
+    /* Frequencies and sample rate in the same units. */
+    template <typename T>
+    void configure(
+        const std::array<T, N>& frequencies,
+        const float sample_rate,
+        const size_t window_length) {
+        for (size_t k = 0; k < N; k++) {
+            coefficients[k] = 2.0f * std::cos(2.0f * pi * frequencies[k] / sample_rate);
+        }
+        length = window_length;
+        phase = 0;
+        windows[0].running = false;
+        windows[1].running = false;
+    }
+
+    /* Returns true when a window has completed and result() is updated. */
+    bool execute_once(const float sample) {
+        bool done = false;
+        for (size_t w = 0; w < windows.size(); w++) {
+            auto& window = windows[w];
+            if (phase == w * (length / 2)) {
+                if (window.running) {
+                    evaluate(window);
+                    done = true;
+                }
+                window.reset();
+            }
+            if (window.running) {
+                window.execute(sample, coefficients);
+            }
+        }
+        phase = (phase + 1 == length) ? 0 : phase + 1;
+        return done;
+    }
+
+    const Result& result() const {
+        return result_;
+    }
+
+   private:
+    struct Window {
+        std::array<float, N> s1{};
+        std::array<float, N> s2{};
+        bool running{true};
+
+        void reset() {
+            s1.fill(0.0f);
+            s2.fill(0.0f);
+            running = true;
+        }
+
+        void execute(const float sample, const std::array<float, N>& coefficients) {
+            for (size_t k = 0; k < N; k++) {
+                const float s0 = sample + coefficients[k] * s1[k] - s2[k];
+                s2[k] = s1[k];
+                s1[k] = s0;
+            }
+        }
+    };
+
+    std::array<float, N> coefficients{};
+    std::array<Window, 2> windows{};
+    size_t length{1};
+    size_t phase{0};
+    Result result_{0, 0.0f};
+
+    void evaluate(const Window& window) {
+        float peak = 0.0f;
+        float total = 0.0f;
+        result_ = {0, 0.0f};
+        for (size_t k = 0; k < N; k++) {
+            const float power = window.s1[k] * window.s1[k] + window.s2[k] * window.s2[k] - coefficients[k] * window.s1[k] * window.s2[k];
+            total += power;
+            if (power > peak) {
+                peak = power;
+                result_.index = k;
+            }
+        }
+
+        if (total > 0.0f) {
+            result_.confidence = peak / total;
+        }
+    }
+};
+
 } /* namespace dsp */
 
 #endif /*__DSP_GOERTZEL_H__*/
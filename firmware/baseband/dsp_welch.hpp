@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_WELCH_H__
+#define __DSP_WELCH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <complex>
+
+#include "complex.hpp"
+#include "dsp_fft_q15.hpp"
+#include "dsp_window.hpp"
+#include "utility.hpp"
+
+namespace dsp {
+namespace welch {
+
+constexpr size_t length = window::length;
+
+/* Mean of a Q15 window, as a fraction of full scale. */
+inline float coherent_gain(const std::array<int16_t, length>& w) {
+    int32_t sum = 0;
+    for (const auto v : w) {
+        sum += v;
+    }
+    return sum / (32767.0f * length);
+}
+
+/* Welch power spectrum: each segment is windowed and transformed on its
+ * own, and the segments' |X|^2 are averaged. Power is divided by the
+ * window's coherent gain squared, so a tone reads the same level whichever
+ * window is selected (full scale int8 tone -> 1.0).
+ */
+class Averager {
+   public:
+    void configure(const WidebandSpectrumConfigMessage::Window type) {
+        window::expand(type, taps);
+        const float gain = coherent_gain(taps);
+        // int8 * Q15 >> 7 gives a Q15 sample.
+        scale = 1.0f / (32768.0f * length * gain);
+        reset();
+    }
+
+    void reset() {
+        sum.fill(0.0f);
+        count = 0;
+    }
+
+    /* Adds the periodogram of length samples starting at segment. */
+    void add(const complex8_t* const segment) {
+        for (size_t i = 0; i < length; i++) {
+            const size_t i_rev = __RBIT(i) >> (32 - log_2(length));
+            const int32_t w = taps[i];
+            work[i_rev] = {
+                static_cast<int16_t>((segment[i].real() * w) >> 7),
+                static_cast<int16_t>((segment[i].imag() * w) >> 7)};
+        }
+
+        const float s = std::ldexp(scale, fft_c_preswapped_q15(work));
+        for (size_t i = 0; i < length; i++) {
+            sum[i] += magnitude_squared(std::complex<float>{work[i].real() * s, work[i].imag() * s});
+        }
+        count++;
+    }
+
+    size_t segments() const {
+        return count;
+    }
+
+    /* Mean power of bin i over the segments added since reset(). */
+    float power(const size_t i) const {
+        return count ? sum[i] / count : 0.0f;
+    }
+
+   private:
+    std::array<int16_t, length> taps{};
+    std::array<complex16_t, length> work{};
+    std::array<float, length> sum{};
+    float scale{1.0f};
+    size_t count{0};
+};
+
+} /* namespace welch */
+} /* namespace dsp */
+
+#endif /*__DSP_WELCH_H__*/
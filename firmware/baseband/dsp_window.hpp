@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_WINDOW_H__
+#define __DSP_WINDOW_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "dsp_fft.hpp"
+#include "message.hpp"
+
+namespace dsp {
+namespace window {
+
+/* cos(2*pi*p/N) at compile time, reduced to the first quadrant. */
+template <size_t N>
+constexpr double cos_turns(const size_t p) {
+    constexpr double pi = 3.14159265358979323846;
+    constexpr size_t quarter = N / 4;
+    const size_t q = (p % N) / quarter;
+    const size_t r = (p % N) % quarter;
+    const double c = fft_sine_quadrant(2.0 * pi * (quarter - r) / N);
+    const double s = fft_sine_quadrant(2.0 * pi * r / N);
+    switch (q) {
+        case 0:
+            return c;
+        case 1:
+            return -s;
+        case 2:
+            return -c;
+        default:
+            return s;
+    }
+}
+
+/* Periodic cosine-sum window a0 - a1*cos(x) + a2*cos(2x) - ... , stored as
+ * the first half plus centre (N/2 + 1 values), since w[n] == w[N - n].
+ */
+template <size_t N>
+constexpr std::array<int16_t, N / 2 + 1> make_cosine_sum_half(const double a0, const double a1, const double a2, const double a3, const double a4) {
+    std::array<int16_t, N / 2 + 1> table{};
+    for (size_t n = 0; n <= N / 2; n++) {
+        const double w = a0 - a1 * cos_turns<N>(n) + a2 * cos_turns<N>(2 * n) - a3 * cos_turns<N>(3 * n) + a4 * cos_turns<N>(4 * n);
+        const double q15 = w * 32767.0;
+        table[n] = static_cast<int16_t>(q15 < 0.0 ? q15 - 0.5 : q15 + 0.5);
+    }
+    return table;
+}
+
+constexpr size_t length = 256;
+using HalfTable = std::array<int16_t, length / 2 + 1>;
+
+constexpr HalfTable hann = make_cosine_sum_half<length>(0.5, 0.5, 0.0, 0.0, 0.0);
+constexpr HalfTable blackman_harris = make_cosine_sum_half<length>(0.35875, 0.48829, 0.14128, 0.01168, 0.0);
+constexpr HalfTable flat_top = make_cosine_sum_half<length>(0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368);
+
+/* Expands the selected window into a full length Q15 table. */
+inline void expand(const WidebandSpectrumConfigMessage::Window type, std::array<int16_t, length>& dst) {
+    const HalfTable* half = nullptr;
+    switch (type) {
+        case WidebandSpectrumConfigMessage::Window::Hann:
+            half = &hann;
+            break;
+        case WidebandSpectrumConfigMessage::Window::BlackmanHarris:
+            half = &blackman_harris;
+            break;
+        case WidebandSpectrumConfigMessage::Window::FlatTop:
+            half = &flat_top;
+            break;
+        default:
+            dst.fill(32767);
+            return;
+    }
+
+    for (size_t n = 0; n < length; n++) {
+        dst[n] = (*half)[(n <= length / 2) ? n : length - n];
+    }
+}
+
+} /* namespace window */
+} /* namespace dsp */
+
+#endif /*__DSP_WINDOW_H__*/
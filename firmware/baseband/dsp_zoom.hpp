@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_ZOOM_H__
+#define __DSP_ZOOM_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+#include "phase_accumulator.hpp"
+#include "sine_table_int8.hpp"
+
+namespace dsp {
+namespace zoom {
+
+/* Zoom-FFT front end: translates a chosen offset to DC with an NCO, then
+ * decimates by 'factor' = 2 * R (a third order CIC decimating by R, then a
+ * half-band FIR decimating by 2 that cleans up the CIC's aliasing and droop).
+ * Decimated samples are collected into blocks of N and handed to a callback,
+ * so a 256 point FFT of the result spans sampling_rate / factor around the
+ * offset instead of the whole channel.
+ */
+template <size_t N>
+class ZoomDecimator {
+   public:
+    static constexpr size_t max_decimation = 512;
+
+    void configure(
+        const uint32_t sampling_rate,
+        const int32_t offset_hz,
+        const size_t decimation) {
+        input_sampling_rate_ = sampling_rate;
+        factor = std::max<size_t>(2, std::min<size_t>(decimation & ~size_t{1}, max_decimation));
+        cic_factor = factor / 2;
+
+        /* CIC gain is R^3. Normalize by the next power of two, which is exact
+         * when R is itself a power of two. */
+        const uint64_t cic_gain = uint64_t{cic_factor} * cic_factor * cic_factor;
+        cic_shift = 0;
+        while ((uint64_t{1} << cic_shift) < cic_gain) {
+            cic_shift++;
+        }
+
+        // exp(-j*2*pi*offset/fs*n) moves the component at +offset down to DC.
+        const int64_t inc = sampling_rate ? int64_t{offset_hz} * (int64_t{1} << 32) / sampling_rate : 0;
+        nco.set_inc(static_cast<uint32_t>(inc));
+
+        reset();
+    }
+
+    void reset() {
+        nco.reset();
+        integrator_i.fill(0);
+        integrator_q.fill(0);
+        comb_i.fill(0);
+        comb_q.fill(0);
+        halfband_i.fill(0);
+        halfband_q.fill(0);
+        cic_count = 0;
+        halfband_phase = 0;
+        block_count = 0;
+    }
+
+    uint32_t input_sampling_rate() const {
+        return input_sampling_rate_;
+    }
+
+    size_t decimation_factor() const {
+        return factor;
+    }
+
+    template <typename BlockCallback>
+    void feed(const buffer_c16_t& src, BlockCallback callback) {
+        for (size_t n = 0; n < src.count; n++) {
+            const auto s = src.p[n];
+            const uint8_t index = nco.get_phase() >> 24;
+            nco();
+            const int32_t c = sine_table_i8[(index + 64) & 0xff];
+            const int32_t sn = sine_table_i8[index];
+
+            // s * (c - j*sn), Q7 -> Q0
+            integrator_i[0] += (s.real() * c + s.imag() * sn) >> 7;
+            integrator_q[0] += (s.imag() * c - s.real() * sn) >> 7;
+            integrator_i[1] += integrator_i[0];
+            integrator_q[1] += integrator_q[0];
+            integrator_i[2] += integrator_i[1];
+            integrator_q[2] += integrator_q[1];
+
+            if (++cic_count < cic_factor) {
+                continue;
+            }
+            cic_count = 0;
+
+            const int32_t cic_i = comb(integrator_i[2], comb_i) >> cic_shift;
+            const int32_t cic_q = comb(integrator_q[2], comb_q) >> cic_shift;
+
+            std::copy(halfband_i.begin() + 1, halfband_i.end(), halfband_i.begin());
+            std::copy(halfband_q.begin() + 1, halfband_q.end(), halfband_q.begin());
+            halfband_i.back() = cic_i;
+            halfband_q.back() = cic_q;
+
+            halfband_phase ^= 1;
+            if (halfband_phase) {
+                continue;
+            }
+
+            block[block_count++] = {halfband(halfband_i), halfband(halfband_q)};
+            if (block_count == block.size()) {
+                block_count = 0;
+                const buffer_c16_t out{
+                    block.data(),
+                    block.size(),
+                    static_cast<uint32_t>(src.sampling_rate / factor),
+                    src.timestamp};
+                callback(out);
+            }
+        }
+    }
+
+   private:
+    PhaseAccumulator nco{0};
+    uint32_t input_sampling_rate_{0};
+    size_t factor{2};
+    size_t cic_factor{1};
+    size_t cic_shift{0};
+    size_t cic_count{0};
+    size_t halfband_phase{0};
+    size_t block_count{0};
+
+    /* 64 bit state: three integrators of R up to 256 need 16 + 24 bits. */
+    std::array<int64_t, 3> integrator_i{};
+    std::array<int64_t, 3> integrator_q{};
+    std::array<int64_t, 3> comb_i{};
+    std::array<int64_t, 3> comb_q{};
+    std::array<int32_t, 11> halfband_i{};
+    std::array<int32_t, 11> halfband_q{};
+    std::array<complex16_t, N> block{};
+
+    static int64_t comb(int64_t x, std::array<int64_t, 3>& delay) {
+        for (auto& d : delay) {
+            const int64_t y = x - d;
+            d = x;
+            x = y;
+        }
+        return x;
+    }
+
+    /* 11 tap half-band (Lagrange), taps / 512:
+     * 3, 0, -25, 0, 150, 256, 150, 0, -25, 0, 3 */
+    static int16_t halfband(const std::array<int32_t, 11>& h) {
+        const int32_t acc = 256 * h[5] + 150 * (h[4] + h[6]) - 25 * (h[2] + h[8]) + 3 * (h[0] + h[10]);
+        const int32_t y = (acc + 256) >> 9;
+        return static_cast<int16_t>(std::max<int32_t>(-32768, std::min<int32_t>(32767, y)));
+    }
+};
+
+} /* namespace zoom */
+} /* namespace dsp */
+
+#endif /*__DSP_ZOOM_H__*/
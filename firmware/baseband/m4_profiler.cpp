@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "m4_profiler.hpp"
+
+namespace m4_profiler {
+
+static void reset() {
+    for (auto& stage : shared_memory.m4_profile.stages) {
+        stage = {};
+        stage.min = UINT32_MAX;
+    }
+}
+
+void enable() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    reset();
+}
+
+void service() {
+    if (shared_memory.m4_profile.reset_request) {
+        reset();
+        shared_memory.m4_profile.reset_request = false;
+    }
+}
+
+void record(const Stage stage, const uint32_t cycles) {
+    auto& s = shared_memory.m4_profile.stages[stage];
+
+    if (cycles < s.min) s.min = cycles;
+    if (cycles > s.max) s.max = cycles;
+    s.count++;
+    s.total += cycles;
+
+    // Bin by bit length: 32 - clz gives floor(log2(cycles)) + 1.
+    const int32_t bits = (cycles == 0) ? 0 : 32 - __builtin_clz(cycles);
+    int32_t bin = bits - 1 - static_cast<int32_t>(M4ProfileStage::histogram_base);
+    if (bin < 0) bin = 0;
+    if (bin >= static_cast<int32_t>(M4ProfileStage::histogram_bins)) bin = M4ProfileStage::histogram_bins - 1;
+    if (s.histogram[bin] < UINT16_MAX) s.histogram[bin]++;
+}
+
+} /* namespace m4_profiler */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __M4_PROFILER_H__
+#define __M4_PROFILER_H__
+
+#include <cstdint>
+
+#include "hal.h"
+
+#include "portapack_shared_memory.hpp"
+
+/* Cycle-accurate timing of the baseband DSP stages, using the Cortex-M4 DWT
+ * cycle counter. Results accumulate in shared_memory.m4_profile and are read
+ * by the "m4prof" shell command on the M0.
+ */
+namespace m4_profiler {
+
+using Stage = M4ProfileTable::Stage;
+
+/* Turns on the DWT cycle counter. Safe to call more than once. */
+void enable();
+
+/* Clears the table, if the M0 has asked for it. Called once per buffer. */
+void service();
+
+void record(const Stage stage, const uint32_t cycles);
+
+static inline uint32_t cycles() {
+    return DWT->CYCCNT;
+}
+
+/* Times the enclosing scope and records it against one stage. */
+class ScopedTimer {
+   public:
+    explicit ScopedTimer(const Stage stage)
+        : stage_{stage},
+          start_{cycles()} {
+    }
+
+    ~ScopedTimer() {
+        record(stage_, cycles() - start_);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+   private:
+    const Stage stage_;
+    const uint32_t start_;
+};
+
+/* Runs f() under a ScopedTimer and passes its result through, so a stage
+ * that produces a const buffer can be timed in place:
+ *     const auto out = m4_profiler::timed(Stage::Decim0, [&] { return decim_0.execute(in, dst); });
+ */
+template <typename F>
+static inline auto timed(const Stage stage, F f) -> decltype(f()) {
+    ScopedTimer timer{stage};
+    return f();
+}
+
+} /* namespace m4_profiler */
+
+#endif /*__M4_PROFILER_H__*/
@@ -101,5 +101,76 @@ void MatchedFilter::shift_by_decimation_factor() {
     }
 }
 
+void MatchedFilterQ15::configure(
+    const tap_t* const taps,
+    const size_t taps_count,
+    const size_t decimation_factor) {
+    samples_ = std::make_unique<vectors_t>(taps_count * 2);
+    taps_reversed_ = std::make_unique<vectors_t>(taps_count);
+    taps_reversed_x_ = std::make_unique<vectors_t>(taps_count);
+    taps_count_ = taps_count;
+    decimation_factor_ = decimation_factor;
+    decimation_phase = 0;
+    write_index_ = 0;
+    output = 0;
+
+    float taps_sum = 0.0f;
+    for (size_t n = 0; n < taps_count; n++) {
+        taps_sum += std::abs(taps[n].real()) + std::abs(taps[n].imag());
+    }
+
+    const float scale = (taps_sum > 0.0f) ? 32767.0f / taps_sum : 1.0f;
+    output_scale_ = 1.0f / scale;
+
+    for (size_t n = 0; n < taps_count; n++) {
+        const auto tap = taps[taps_count - 1 - n];
+        const auto re = static_cast<int16_t>(std::lround(tap.real() * scale));
+        const auto im = static_cast<int16_t>(std::lround(tap.imag() * scale));
+        taps_reversed_[n] = {re, im};
+        taps_reversed_x_[n] = {im, re};
+    }
+}
+
+bool MatchedFilterQ15::execute_once(
+    const sample_t input) {
+    const vec2_s16 sample{input.real(), input.imag()};
+    samples_[write_index_] = sample;
+    samples_[write_index_ + taps_count_] = sample;
+    write_index_ = (write_index_ + 1 == taps_count_) ? 0 : write_index_ + 1;
+
+    advance_decimation_phase();
+    if (!is_new_decimation_cycle()) {
+        return false;
+    }
+
+    // Oldest sample first, lined up with the reversed taps.
+    const vec2_s16* const history = &samples_[write_index_];
+    int32_t r_p = 0;
+    int32_t r_n = 0;
+    int32_t i_p = 0;
+    int32_t i_n = 0;
+    for (size_t n = 0; n < taps_count_; n++) {
+        const auto s = history[n];
+        const auto t = taps_reversed_[n];
+        const auto t_x = taps_reversed_x_[n];
+
+        // P: sample * tap. N: sample * conj(tap), i_n negated.
+        r_p = smlsd(s, t, r_p);
+        r_n = smlad(s, t, r_n);
+        i_p = smlad(s, t_x, i_p);
+        i_n = smlsd(s, t_x, i_n);
+    }
+
+    const float fr_p = r_p;
+    const float fi_p = i_p;
+    const float fr_n = r_n;
+    const float fi_n = i_n;
+    const auto mag_p = std::sqrt(fr_p * fr_p + fi_p * fi_p);
+    const auto mag_n = std::sqrt(fr_n * fr_n + fi_n * fi_n);
+    output = (mag_p - mag_n) * output_scale_;
+
+    return true;
+}
+
 } /* namespace matched_filter */
 } /* namespace dsp */
@@ -23,9 +23,13 @@
 #define __MATCHED_FILTER_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <complex>
 #include <memory>
 
+#include "complex.hpp"
+#include "simd.hpp"
+
 namespace dsp {
 namespace matched_filter {
 
@@ -87,6 +91,72 @@ class MatchedFilter {
         const size_t decimation_factor);
 };
 
+/* Q15 MatchedFilter for complex16_t samples, with the same taps and output.
+ * Processors pick one or the other by the type of their filter member.
+ *
+ * The history is a circular buffer stored twice over, so the newest
+ * taps_count samples are always contiguous and nothing is shifted when an
+ * output is computed. Each tap is four dual 16 bit multiply-accumulates
+ * (SMLAD/SMLSD) into the four correlation terms.
+ *
+ * Taps are scaled so that sum(|re| + |im|) is 1.0 in Q15, which keeps the
+ * 32 bit accumulators from overflowing for any input. The output is scaled
+ * back to match MatchedFilter.
+ */
+class MatchedFilterQ15 {
+   public:
+    using sample_t = complex16_t;
+    using tap_t = std::complex<float>;
+
+    template <class T>
+    MatchedFilterQ15(
+        const T& taps,
+        size_t decimation_factor = 1) {
+        configure(taps, decimation_factor);
+    }
+
+    template <class T>
+    void configure(
+        const T& taps,
+        size_t decimation_factor) {
+        configure(taps.data(), taps.size(), decimation_factor);
+    }
+
+    bool execute_once(const sample_t input);
+
+    float get_output() const {
+        return output;
+    }
+
+   private:
+    using vectors_t = vec2_s16[];
+
+    /* 2 * taps_count, see above. */
+    std::unique_ptr<vectors_t> samples_{};
+    /* Reversed taps as (re, im) and as (im, re). */
+    std::unique_ptr<vectors_t> taps_reversed_{};
+    std::unique_ptr<vectors_t> taps_reversed_x_{};
+    size_t taps_count_{0};
+    size_t decimation_factor_{1};
+    size_t decimation_phase{0};
+    size_t write_index_{0};
+    float output_scale_{1.0f};
+    float output{0};
+
+    void advance_decimation_phase() {
+        decimation_phase = (decimation_phase + 1) % decimation_factor_;
+    }
+
+    bool is_new_decimation_cycle() const {
+        return (decimation_phase == 0);
+    }
+
+    void configure(
+        const tap_t* const taps,
+        const size_t taps_count,
+        const size_t decimation_factor);
+};
+
 } /* namespace matched_filter */
 } /* namespace dsp */
 
@@ -41,6 +41,14 @@ class PhaseAccumulator {
         phase_inc = new_phase_inc;
     }
 
+    uint32_t get_phase() const {
+        return phase;
+    }
+
+    void reset() {
+        phase = 0;
+    }
+
    private:
     uint32_t phase{0};
     uint32_t phase_inc;
@@ -55,8 +55,7 @@ void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
             // 1 bit == 2 samples, transition defines bit value.
             if ((sample_count & 1) == 1) {
                 if (bit_count >= msg_len) {
-                    const ADSBFrameMessage message(frame, amp);
-                    shared_memory.application_queue.push(message);
+                    shared_memory.packet_batch.post<ADSBFrameMessage>(shared_memory.application_queue, frame, amp);
                     decoding = false;
                     bit = (prev_mag > mag) ? 1 : 0;
                 } else {
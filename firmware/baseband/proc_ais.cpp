@@ -28,30 +28,28 @@
 
 #include "event_m4.hpp"
 
-AISProcessor::AISProcessor() {
-    decim_0.configure(taps_11k0_decim_0.taps);
+#include <algorithm>
+#include <cmath>
+
+AISChannelReceiver::AISChannelReceiver(const ais::Channel channel)
+    : channel_{channel} {
     decim_1.configure(taps_11k0_decim_1.taps);
-    baseband_thread.start();
 }
 
-void AISProcessor::execute(const buffer_c8_t& buffer) {
-    /* 2.4576MHz, 2048 samples */
-
-    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-    const auto decimator_out = decim_1_out;
+buffer_c16_t AISChannelReceiver::execute(const buffer_c16_t& src) {
+    const auto decim_1_out = decim_1.execute(src, src);
 
     /* 38.4kHz, 32 samples */
-    feed_channel_stats(decimator_out);
-
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf.execute_once(decimator_out.p[i])) {
+    for (size_t i = 0; i < decim_1_out.count; i++) {
+        if (mf.execute_once(decim_1_out.p[i])) {
             clock_recovery(mf.get_output());
         }
     }
+
+    return decim_1_out;
 }
 
-void AISProcessor::consume_symbol(
+void AISChannelReceiver::consume_symbol(
     const float raw_symbol) {
     const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
     const auto decoded_symbol = nrzi_decode(sliced_symbol);
@@ -59,15 +57,98 @@ void AISProcessor::consume_symbol(
     packet_builder.execute(decoded_symbol);
 }
 
-void AISProcessor::payload_handler(
+void AISChannelReceiver::payload_handler(
     const baseband::Packet& packet) {
-    const AISPacketMessage message{packet};
+    const AISPacketMessage message{packet, channel_};
     shared_memory.application_queue.push(message);
 }
 
+AISProcessor::AISProcessor() {
+    decim_0.configure(taps_11k0_decim_0.taps);
+
+    constexpr float pi = 3.14159265358979323846f;
+    const float w = 2.0f * pi * channel_offset / decim_0_fs;
+    rotator_step = {std::cos(w), std::sin(w)};
+
+    baseband_thread.start();
+}
+
+void AISProcessor::execute(const buffer_c8_t& buffer) {
+    /* 2.4576MHz, 2048 samples */
+
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+
+    /* 307.2kHz, 256 samples */
+    if (dual_channel) {
+        execute_dual(decim_0_out);
+        return;
+    }
+
+    feed_channel_stats(receiver_a.execute(decim_0_out));
+}
+
+void AISProcessor::execute_dual(const buffer_c16_t& decim_0_out) {
+    const auto clamp = [](const float v) {
+        return static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, v)));
+    };
+
+    // Channel A is shifted into its own buffer, channel B in place.
+    for (size_t i = 0; i < decim_0_out.count; i++) {
+        const float re = decim_0_out.p[i].real();
+        const float im = decim_0_out.p[i].imag();
+        const float c = rotator.real();
+        const float s = rotator.imag();
+
+        channel_a_dst[i] = {clamp(re * c - im * s), clamp(re * s + im * c)};
+        decim_0_out.p[i] = {clamp(re * c + im * s), clamp(im * c - re * s)};
+
+        rotator *= rotator_step;
+    }
+
+    // Keep the rotator on the unit circle.
+    rotator *= (3.0f - std::norm(rotator)) * 0.5f;
+
+    const buffer_c16_t channel_a_buffer{
+        channel_a_dst.data(),
+        decim_0_out.count,
+        decim_0_out.sampling_rate,
+        decim_0_out.timestamp};
+
+    const auto channel_a_out = receiver_a.execute(channel_a_buffer);
+    const auto channel_b_out = receiver_b.execute(decim_0_out);
+
+    // Channel stats follow the stronger of the two 38.4kHz channels.
+    const auto peak_power = [](const buffer_c16_t& channel) {
+        uint32_t peak = 0;
+        for (size_t i = 0; i < channel.count; i++) {
+            const int32_t re = channel.p[i].real();
+            const int32_t im = channel.p[i].imag();
+            peak = std::max(peak, static_cast<uint32_t>(re * re) + static_cast<uint32_t>(im * im));
+        }
+        return peak;
+    };
+    feed_channel_stats((peak_power(channel_a_out) >= peak_power(channel_b_out)) ? channel_a_out : channel_b_out);
+}
+
 void AISProcessor::on_message(const Message* const message) {
-    if (message->id == Message::ID::AudioBeep)
-        on_beep_message(*reinterpret_cast<const AudioBeepMessage*>(message));
+    switch (message->id) {
+        case Message::ID::AISConfigure:
+            on_configure_message(*reinterpret_cast<const AISConfigureMessage*>(message));
+            break;
+
+        case Message::ID::AudioBeep:
+            on_beep_message(*reinterpret_cast<const AudioBeepMessage*>(message));
+            break;
+
+        default:
+            break;
+    }
+}
+
+void AISProcessor::on_configure_message(const AISConfigureMessage& message) {
+    dual_channel = message.dual_channel;
+    receiver_a.set_channel(dual_channel ? ais::Channel::A : message.channel);
+    rotator = {1.0f, 0.0f};
 }
 
 void AISProcessor::on_beep_message(const AudioBeepMessage& message) {
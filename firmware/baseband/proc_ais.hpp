@@ -39,26 +39,26 @@
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
+#include <complex>
 
 #include "ais_baseband.hpp"
 
-class AISProcessor : public BasebandProcessor {
+/* One AIS channel, from 307.2kHz centred on the channel down to packets:
+ * decimation to 38.4kHz, matched filter, clock recovery and framing. */
+class AISChannelReceiver {
    public:
-    AISProcessor();
+    AISChannelReceiver(const ais::Channel channel);
 
-    void execute(const buffer_c8_t& buffer) override;
+    /* Decimates src in place. Returns the 38.4kHz channel. */
+    buffer_c16_t execute(const buffer_c16_t& src);
 
-   private:
-    static constexpr size_t baseband_fs = 2457600;
+    void set_channel(const ais::Channel channel) { channel_ = channel; }
 
-    std::array<complex16_t, 512> dst{};
-    const buffer_c16_t dst_buffer{
-        dst.data(),
-        dst.size()};
+   private:
+    ais::Channel channel_;
 
-    dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    dsp::matched_filter::MatchedFilterQ15 mf{baseband::ais::square_taps_38k4_1t_p, 2};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
         19200,
@@ -76,7 +76,42 @@ class AISProcessor : public BasebandProcessor {
 
     void consume_symbol(const float symbol);
     void payload_handler(const baseband::Packet& packet);
+};
+
+class AISProcessor : public BasebandProcessor {
+   public:
+    AISProcessor();
+
+    void execute(const buffer_c8_t& buffer) override;
+
+   private:
+    static constexpr size_t baseband_fs = 2457600;
+    static constexpr size_t decim_0_fs = baseband_fs / 8;
+
+    /* In dual channel mode the channels are 25kHz either side of DC. */
+    static constexpr float channel_offset = 25000.0f;
+
+    std::array<complex16_t, 512> dst{};
+    const buffer_c16_t dst_buffer{
+        dst.data(),
+        dst.size()};
+    std::array<complex16_t, 256> channel_a_dst{};
+
+    dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
+
+    bool dual_channel{false};
+    /* exp(j*2*pi*n*channel_offset/decim_0_fs), shifts channel A up to DC.
+     * Its conjugate shifts channel B down. */
+    std::complex<float> rotator{1.0f, 0.0f};
+    std::complex<float> rotator_step{};
+
+    AISChannelReceiver receiver_a{ais::Channel::A};
+    AISChannelReceiver receiver_b{ais::Channel::B};
+
+    void execute_dual(const buffer_c16_t& decim_0_out);
+
     void on_message(const Message* const message);
+    void on_configure_message(const AISConfigureMessage& message);
     void on_beep_message(const AudioBeepMessage& message);
 
     /* NB: Threads should be the last members in the class definition. */
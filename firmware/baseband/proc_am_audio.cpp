@@ -25,6 +25,7 @@
 #include "audio_dma.hpp"
 
 #include "event_m4.hpp"
+#include "m4_profiler.hpp"
 
 #include <array>
 #include "dsp_hilbert.hpp"
@@ -34,8 +35,8 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
         return;
     }
 
-    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+    const auto decim_0_out = m4_profiler::timed(m4_profiler::Stage::Decim0, [&] { return decim_0.execute(buffer, dst_buffer); });
+    const auto decim_1_out = m4_profiler::timed(m4_profiler::Stage::Decim1, [&] { return decim_1.execute(decim_0_out, dst_buffer); });
 
     channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
 
@@ -45,7 +46,7 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
     // TODO: Feed channel_stats post-decimation data?
     feed_channel_stats(channel_out);
 
-    auto audio = demodulate(channel_out);  // now 3 AM demodulation types : demod_am, demod_ssb, demod_ssb_fm (for Wefax)
+    auto audio = m4_profiler::timed(m4_profiler::Stage::Demod, [&] { return demodulate(channel_out); });  // now 3 AM demodulation types : demod_am, demod_ssb, demod_ssb_fm (for Wefax)
     audio_compressor.execute_in_place(audio);
     audio_output.write(audio);
 }
@@ -76,6 +77,7 @@ void NarrowbandAMAudio::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(message);
             break;
 
@@ -316,9 +316,8 @@ void BTLERxProcessor::handlePDUPayloadState() {
 
             blePacketData.dataLen = i;
 
-            BLEPacketMessage data_message{&blePacketData};
-
-            shared_memory.application_queue.push(data_message);
+            // The packet travels in the same batch slot as its message.
+            shared_memory.packet_batch.post<BLEPacketSlotMessage>(shared_memory.application_queue, blePacketData);
         }
     }
 
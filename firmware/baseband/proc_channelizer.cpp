@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_channelizer.hpp"
+
+#include "event_m4.hpp"
+#include "portapack_shared_memory.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+
+void ChannelizerProcessor::execute(const buffer_c8_t& buffer) {
+    if (!configured) return;
+
+    accumulated_blocks += channelizer.accumulate(buffer, blocks_per_buffer, power);
+
+    if (++buffer_count >= report_buffers) {
+        report();
+        buffer_count = 0;
+    }
+}
+
+void ChannelizerProcessor::report() {
+    ChannelizerActivityMessage message{};
+    message.sampling_rate = baseband_fs;
+
+    const float norm = accumulated_blocks ? 1.0f / accumulated_blocks : 0.0f;
+    for (size_t i = 0; i < power.size(); i++) {
+        // The DC spur would hold the centre channel's squelch open.
+        if (i == ChannelizerActivityMessage::dc_channel) {
+            message.power_db[i] = -128;
+            continue;
+        }
+
+        const int32_t db = std::max<int32_t>(-128, std::min<int32_t>(0, mag2_to_dbv_norm(power[i] * norm)));
+        message.power_db[i] = db;
+
+        const uint64_t bit = uint64_t{1} << i;
+        if (open_mask & bit) {
+            if (db < (squelch_db - hysteresis_db)) open_mask &= ~bit;
+        } else {
+            if (db >= squelch_db) open_mask |= bit;
+        }
+    }
+    message.open_mask = open_mask;
+
+    power.fill(0.0f);
+    accumulated_blocks = 0;
+
+    shared_memory.application_queue.push(message);
+}
+
+void ChannelizerProcessor::configure(const ChannelizerConfigMessage& message) {
+    baseband_fs = message.sampling_rate;
+    squelch_db = message.squelch_db;
+    hysteresis_db = message.hysteresis_db;
+
+    const size_t buffers_per_second = std::max<size_t>(baseband_fs / 2048, 1);
+    report_buffers = std::max<size_t>(buffers_per_second * message.report_interval_ms / 1000, 1);
+
+    power.fill(0.0f);
+    accumulated_blocks = 0;
+    buffer_count = 0;
+    open_mask = 0;
+
+    baseband_thread.set_sampling_rate(baseband_fs);
+    configured = true;
+}
+
+void ChannelizerProcessor::on_message(const Message* const message) {
+    switch (message->id) {
+        case Message::ID::ChannelizerConfig:
+            configure(*reinterpret_cast<const ChannelizerConfigMessage*>(message));
+            break;
+
+        default:
+            break;
+    }
+}
+
+int main() {
+    EventDispatcher event_dispatcher{std::make_unique<ChannelizerProcessor>()};
+    event_dispatcher.run();
+    return 0;
+}
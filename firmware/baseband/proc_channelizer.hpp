@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_CHANNELIZER_H__
+#define __PROC_CHANNELIZER_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_channelizer.hpp"
+
+#include "message.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+/* Splits the captured band into ChannelizerActivityMessage::channel_count
+ * channels and runs a power squelch on each, so the application can watch
+ * many frequencies per tuning instead of one. The centre channel sits on the
+ * DC spur, so like Looking Glass' ignore_dc it is never reported open.
+ */
+class ChannelizerProcessor : public BasebandProcessor {
+   public:
+    void execute(const buffer_c8_t& buffer) override;
+    void on_message(const Message* const message) override;
+
+   private:
+    using Channelizer = dsp::channelizer::PolyphaseChannelizer<ChannelizerActivityMessage::channel_count, 4>;
+
+    /* Filterbank outputs per 2048 sample buffer. 8 of the possible 29 keeps
+     * the M4 under ~25% busy at 4Msps. */
+    static constexpr size_t blocks_per_buffer = 8;
+
+    bool configured = false;
+    size_t baseband_fs = 4000000;
+
+    Channelizer channelizer{};
+    std::array<float, Channelizer::channel_count> power{};
+    size_t accumulated_blocks = 0;
+    size_t buffer_count = 0;
+    size_t report_buffers = 1;
+
+    int8_t squelch_db = -60;
+    uint8_t hysteresis_db = 3;
+    uint64_t open_mask = 0;
+
+    void configure(const ChannelizerConfigMessage& message);
+    void report();
+
+    /* NB: Threads should be the last members in the class definition. */
+    BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
+    RSSIThread rssi_thread{};
+};
+
+#endif /*__PROC_CHANNELIZER_H__*/
@@ -171,6 +171,7 @@ void FSKRxProcessor::on_message(const Message* const message) {
             break;
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(message);
             break;
 
@@ -80,6 +80,7 @@ void GPSReplayProcessor::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(message);
             break;
 
@@ -27,6 +27,7 @@
 #include "audio_dma.hpp"
 
 #include "event_m4.hpp"
+#include "m4_profiler.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -38,8 +39,8 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
         return;
     }
 
-    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+    const auto decim_0_out = m4_profiler::timed(m4_profiler::Stage::Decim0, [&] { return decim_0.execute(buffer, dst_buffer); });
+    const auto decim_1_out = m4_profiler::timed(m4_profiler::Stage::Decim1, [&] { return decim_1.execute(decim_0_out, dst_buffer); });
 
     channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
 
@@ -49,7 +50,7 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 
     if (!pitch_rssi_enabled) {
         // Normal mode, output demodulated audio
-        auto audio = demod.execute(channel_out, audio_buffer);
+        auto audio = m4_profiler::timed(m4_profiler::Stage::Demod, [&] { return demod.execute(channel_out, audio_buffer); });
         audio_output.write(audio);
 
         if (ctcss_detect_enabled) {
@@ -71,25 +72,22 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
                 audio_ctcss.count,
                 audio_ctcss.sampling_rate});
 
-            // Zero-crossing detection
+            // Sum down to 3kHz and run the tone bank, a result every half window
             for (size_t c = 0; c < audio_ctcss.count; c++) {
-                cur_sample = audio_f[c];
-                if (cur_sample * prev_sample < 0.0) {
-                    z_acc += z_timer;
-                    z_timer = 1;
-                    z_count++;
-                } else
-                    z_timer++;
-                prev_sample = cur_sample;
-            }
-
-            z_filter_count++;
-            if ((z_filter_count >= Z_MIN_FILTER_COUNT) && (z_count >= Z_MIN_ZERO_CROSSINGS)) {
-                ctcss_message.value = (100 * 12000 / 2 * z_count) / z_acc;
-                shared_memory.application_queue.push(ctcss_message);
-                z_filter_count = 0;
-                z_count = 0;
-                z_acc = 0;
+                ctcss_acc += audio_f[c];
+                if (++ctcss_acc_count < ctcss_decimation) {
+                    continue;
+                }
+
+                if (ctcss_bank.execute_once(ctcss_acc * (1.0f / ctcss_decimation))) {
+                    const auto& result = ctcss_bank.result();
+                    const bool detected = result.confidence >= ctcss_min_confidence;
+                    ctcss_message.value = detected ? ctcss::tones_centihz[result.index] : 0;
+                    ctcss_message.confidence = result.confidence * 100.0f;
+                    shared_memory.application_queue.push(ctcss_message);
+                }
+                ctcss_acc = 0.0f;
+                ctcss_acc_count = 0;
             }
         }
     } else {
@@ -114,6 +112,7 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(message);
             break;
 
@@ -158,6 +157,9 @@ void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
 
     hpf.configure(audio_24k_hpf_30hz_config);
     ctcss_filter.configure(taps_64_lp_025_025.taps);
+    ctcss_bank.configure(ctcss::tones_centihz, ctcss_fs * 100.0f, ctcss_window_length);
+    ctcss_acc = 0.0f;
+    ctcss_acc_count = 0;
 
     configured = true;
 }
@@ -29,15 +29,15 @@
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_goertzel.hpp"
 #include "dsp_iir.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
 
-#include <cstdint>
+#include "ctcss_tones.hpp"
 
-#define Z_MIN_FILTER_COUNT 224
-#define Z_MIN_ZERO_CROSSINGS 20
+#include <cstdint>
 
 class NarrowbandFMAudio : public BasebandProcessor {
    public:
@@ -72,29 +72,36 @@ class NarrowbandFMAudio : public BasebandProcessor {
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
 
-    // For CTCSS decoding
+    // For CTCSS decoding: 12kHz after ctcss_filter, 3kHz into the Goertzel bank.
+    static constexpr size_t ctcss_decimation = 4;
+    static constexpr size_t ctcss_fs = 24000 / 2 / ctcss_decimation;
+    // 0.4s window: 2.5Hz resolution for tones 2.3Hz apart, a result every 0.2s.
+    static constexpr size_t ctcss_window_length = ctcss_fs * 2 / 5;
+    static constexpr float ctcss_min_confidence = 0.5f;
+
     dsp::decimate::FIR64AndDecimateBy2Real ctcss_filter{};
     IIRBiquadFilter hpf{};
+    dsp::GoertzelBank<ctcss::tone_count> ctcss_bank{};
+    float ctcss_acc{0.0f};
+    size_t ctcss_acc_count{0};
 
     dsp::demodulate::FM demod{};
 
     AudioOutput audio_output{};
 
-    SpectrumCollector channel_spectrum{};
+    SpectrumCollector channel_spectrum{SpectrumCollector::FFTBackend::Q15};
 
     uint32_t tone_phase{0};
     uint32_t tone_delta{0};
     bool pitch_rssi_enabled{false};
 
-    float cur_sample{}, prev_sample{};
-    uint32_t z_acc{0}, z_timer{0}, z_count{0}, z_filter_count{0};
     bool ctcss_detect_enabled{true};
     static constexpr float k = 32768.0f;
     static constexpr float ki = 1.0f / k;
 
     bool configured{false};
     // RequestSignalMessage sig_message { RequestSignalMessage::Signal::Squelched };
-    CodedSquelchMessage ctcss_message{0};
+    CodedSquelchMessage ctcss_message{0, 0};
 
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
@@ -127,7 +127,7 @@ class SondeProcessor : public BasebandProcessor {
 
     dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    dsp::matched_filter::MatchedFilterQ15 mf{baseband::ais::square_taps_38k4_1t_p, 2};
 
     // Actually 4800bits/s but the Manchester coding doubles the symbol rate
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_9600{
@@ -83,7 +83,7 @@ class TPMSProcessor : public BasebandProcessor {
     dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
     dsp::decimate::FIRC16xR16x16Decim2 decim_1{};
 
-    dsp::matched_filter::MatchedFilter mf_38k4_1t_19k2{rect_taps_307k2_38k4_1t_19k2_p, 8};
+    dsp::matched_filter::MatchedFilterQ15 mf_38k4_1t_19k2{rect_taps_307k2_38k4_1t_19k2_p, 8};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_19k2{
         38400,
@@ -26,6 +26,7 @@
 #include "audio_output.hpp"
 #include "dsp_fft.hpp"
 #include "event_m4.hpp"
+#include "m4_profiler.hpp"
 #include "audio_dma.hpp"
 
 #include <cstdint>
@@ -35,8 +36,8 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
         return;
     }
 
-    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto channel = decim_1.execute(decim_0_out, dst_buffer);
+    const auto decim_0_out = m4_profiler::timed(m4_profiler::Stage::Decim0, [&] { return decim_0.execute(buffer, dst_buffer); });
+    const auto channel = m4_profiler::timed(m4_profiler::Stage::Decim1, [&] { return decim_1.execute(decim_0_out, dst_buffer); });
 
     // TODO: Feed channel_stats post-decimation data?
     feed_channel_stats(channel);
@@ -58,7 +59,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
      * -> FM demodulation
      * -> 96kHz int16_t[64] */
 
-    auto audio_oversampled = demod.execute(channel, work_audio_buffer);  // fs 384khz wfm , 96khz wfmam for NOAA
+    auto audio_oversampled = m4_profiler::timed(m4_profiler::Stage::Demod, [&] { return demod.execute(channel, work_audio_buffer); });  // fs 384khz wfm , 96khz wfmam for NOAA
 
     /* 384kHz int16_t[256]     for wfm
      * -> 4th order CIC decimation by 2, gain of 1
@@ -163,6 +164,7 @@ void WidebandFMAudio::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(message);
             break;
 
@@ -133,7 +133,7 @@ class WidebandFMAudio : public BasebandProcessor {
     AudioSpectrum spectrum{};
     uint32_t fft_step{0};
 
-    SpectrumCollector channel_spectrum{};
+    SpectrumCollector channel_spectrum{SpectrumCollector::FFTBackend::Q15};
     size_t spectrum_interval_samples = 0;
     size_t spectrum_samples = 0;
 
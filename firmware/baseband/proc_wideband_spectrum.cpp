@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstddef>
 
+#include <algorithm>
 #include <array>
 
 void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
@@ -35,31 +36,22 @@ void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 
     if (!configured) return;
 
-    if (phase == 0) {
-        std::fill(spectrum.begin(), spectrum.end(), 0);
-    }
-
-    for (size_t i = 0; i < spectrum.size(); i++) {
-        // TODO: Removed window-presum windowing, due to lack of available code RAM.
-        // TODO: Apply window to improve spectrum bin sidelobes.
-        spectrum[i] += buffer.p[i + 0];
-        spectrum[i] += buffer.p[i + 1024];
-    }
-
-    if (phase == trigger) {
-        const buffer_c16_t buffer_c16{
-            spectrum.data(),
-            spectrum.size(),
-            buffer.sampling_rate};
-        channel_spectrum.feed(
-            buffer_c16,
-            0, 0, 0);
-        phase = 0;
+    // One buffer per frame is enough: the segments of its first
+    // SpectrumCollector::segment_span samples are Welch averaged.
+    if (phase >= trigger) {
+        if (channel_spectrum.feed_segments(buffer)) {
+            phase = 0;
+        }
     } else {
         phase++;
     }
 }
 
+void WidebandSpectrum::configure_window(const WidebandSpectrumConfigMessage& message) {
+    const size_t overlap = std::min<size_t>(message.overlap, 75);
+    channel_spectrum.configure_segments(message.window, dsp::welch::length * (100 - overlap) / 100);
+}
+
 void WidebandSpectrum::on_signal_message(const RequestSignalMessage& message) {
     if (message.signal == RequestSignalMessage::Signal::BeepStopRequest) {
         audio::dma::beep_stop();
@@ -89,6 +81,7 @@ void WidebandSpectrum::on_message(const Message* const msg) {
     switch (msg->id) {
         case Message::ID::UpdateSpectrum:
         case Message::ID::SpectrumStreamingConfig:
+        case Message::ID::SpectrumAccumulationConfig:
             channel_spectrum.on_message(msg);
             break;
 
@@ -96,6 +89,7 @@ void WidebandSpectrum::on_message(const Message* const msg) {
             baseband_fs = message.sampling_rate;
             trigger = message.trigger;
             baseband_thread.set_sampling_rate(baseband_fs);
+            configure_window(message);
             phase = 0;
             configured = true;
             break;
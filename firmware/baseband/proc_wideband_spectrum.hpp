@@ -45,10 +45,10 @@ class WidebandSpectrum : public BasebandProcessor {
 
     void on_beep_message(const AudioBeepMessage& message);
     void on_signal_message(const RequestSignalMessage& message);
+    void configure_window(const WidebandSpectrumConfigMessage& message);
 
     SpectrumCollector channel_spectrum{};
 
-    std::array<complex16_t, 256> spectrum{};
     size_t phase = 0, trigger = 127;
 
     /* NB: Threads should be the last members in the class definition. */
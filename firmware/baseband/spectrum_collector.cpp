@@ -22,12 +22,14 @@
 #include "spectrum_collector.hpp"
 
 #include "dsp_fft.hpp"
+#include "dsp_fft_q15.hpp"
 
 #include "utility.hpp"
 #include "event_m4.hpp"
 #include "portapack_shared_memory.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 void SpectrumCollector::on_message(const Message* const message) {
     switch (message->id) {
@@ -39,21 +41,49 @@ void SpectrumCollector::on_message(const Message* const message) {
             set_state(*reinterpret_cast<const SpectrumStreamingConfigMessage*>(message));
             break;
 
+        case Message::ID::SpectrumAccumulationConfig:
+            set_accumulation(*reinterpret_cast<const SpectrumAccumulationConfigMessage*>(message));
+            break;
+
         default:
             break;
     }
 }
 
 void SpectrumCollector::set_state(const SpectrumStreamingConfigMessage& message) {
-    if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
+    if (message.mode == SpectrumStreamingConfigMessage::Mode::Zoom) {
+        if (!zoom) {
+            zoom = std::make_unique<dsp::zoom::ZoomDecimator<256>>();
+        }
+        zoom_offset = message.zoom_offset;
+        zoom_decimation = message.zoom_decimation;
+        zoom_reconfigure = true;
+        zoom_active = true;
+        start();
+    } else if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
+        zoom_active = false;
         start();
     } else {
         stop();
     }
 }
 
+void SpectrumCollector::set_accumulation(const SpectrumAccumulationConfigMessage& message) {
+    accumulation_mode = message.mode;
+    accumulation_frames = std::max<size_t>(message.frames, 1);
+    accumulated_frames = 0;
+
+    if (accumulation_mode == SpectrumAccumulationConfigMessage::Mode::None) {
+        accumulator.reset();
+    } else if (!accumulator) {
+        accumulator = std::make_unique<std::array<float, 256>>();
+    }
+}
+
 void SpectrumCollector::start() {
     streaming = true;
+    // Frames from before a retune must not be mixed into the next reduction.
+    accumulated_frames = 0;
     ChannelSpectrumConfigMessage message{&fifo};
     shared_memory.application_queue.push(message);
 }
@@ -79,9 +109,27 @@ void SpectrumCollector::feed(
     const int32_t filter_high_frequency,
     const int32_t filter_transition) {
     // Called from baseband processing thread.
+    channel_filter_transition = filter_transition;
+
+    if (zoom_active) {
+        if (zoom_reconfigure || (zoom->input_sampling_rate() != channel.sampling_rate)) {
+            zoom->configure(channel.sampling_rate, zoom_offset, zoom_decimation);
+            zoom_reconfigure = false;
+        }
+        // Filter edges relative to the zoomed centre.
+        channel_filter_low_frequency = filter_low_frequency - zoom_offset;
+        channel_filter_high_frequency = filter_high_frequency - zoom_offset;
+
+        zoom->feed(
+            channel,
+            [this](const buffer_c16_t& data) {
+                this->post_message(data);
+            });
+        return;
+    }
+
     channel_filter_low_frequency = filter_low_frequency;
     channel_filter_high_frequency = filter_high_frequency;
-    channel_filter_transition = filter_transition;
 
     channel_spectrum_decimator.feed(
         channel,
@@ -93,11 +141,44 @@ void SpectrumCollector::feed(
 void SpectrumCollector::post_message(const buffer_c16_t& data) {
     // Called from baseband processing thread.
     if (streaming && !channel_spectrum_request_update) {
-        fft_swap(data, channel_spectrum);
+        if (fft_backend == FFTBackend::Q15) {
+            fft_swap(data, channel_spectrum.q15);
+        } else {
+            fft_swap(data, channel_spectrum.f);
+        }
         channel_spectrum_sampling_rate = data.sampling_rate;
+        segments_posted = false;
+        channel_spectrum_request_update = true;
+        EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+    }
+}
+
+void SpectrumCollector::configure_segments(
+    const WidebandSpectrumConfigMessage::Window window,
+    const size_t step) {
+    // Drop any frame posted with the previous settings.
+    channel_spectrum_request_update = false;
+    if (!segments) {
+        segments = std::make_unique<Segments>();
+    }
+    segments->step = std::max<size_t>(std::min(step, segment_span - dsp::welch::length), 1);
+    segments->averager.configure(window);
+}
+
+bool SpectrumCollector::feed_segments(const buffer_c8_t& samples) {
+    // Called from baseband processing thread.
+    if (streaming && !channel_spectrum_request_update && segments && (samples.count >= segment_span)) {
+        std::copy(&samples.p[0], &samples.p[segment_span], segments->samples.begin());
+        channel_spectrum_sampling_rate = samples.sampling_rate;
+        channel_filter_low_frequency = 0;
+        channel_filter_high_frequency = 0;
+        channel_filter_transition = 0;
+        segments_posted = true;
         channel_spectrum_request_update = true;
         EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+        return true;
     }
+    return false;
 }
 
 template <typename T>
@@ -108,12 +189,15 @@ static typename T::value_type spectrum_window_none(const T& s, const size_t i) {
 };
 
 template <typename T>
-static typename T::value_type spectrum_window_hamming_3(const T& s, const size_t i) {
+static std::complex<float> spectrum_window_hamming_3(const T& s, const size_t i) {
     constexpr size_t length = sizeof(s) / sizeof(s[0]);
     static_assert((length), "Array length must be power of 2");
     constexpr size_t mask = length - 1;
     // Three point Hamming window.
-    return s[i] * 0.54f + (s[(i - 1) & mask] + s[(i + 1) & mask]) * -0.23f;
+    const std::complex<float> center = s[i];
+    const std::complex<float> left = s[(i - 1) & mask];
+    const std::complex<float> right = s[(i + 1) & mask];
+    return center * 0.54f + (left + right) * -0.23f;
 };
 
 template <typename T>
@@ -128,26 +212,87 @@ static typename T::value_type spectrum_window_blackman_3(const T& s, const size_
     return s[i] * alpha - (s[(i - 1) & mask] + s[(i + 1) & mask]) * beta + (s[(i - 2) & mask] + s[(i + 2) & mask]) * gamma;
 };
 
+static uint8_t spectrum_db(const float mag2) {
+    const float db = mag2_to_dbv_norm(mag2);
+    constexpr float mag_scale = 5.0f;
+    const unsigned int v = (db * mag_scale) + 255.0f;
+    return std::max(0U, std::min(255U, v));
+}
+
+float SpectrumCollector::bin_power(const size_t i, const float scale) const {
+    const auto corrected_sample = (fft_backend == FFTBackend::Q15) ? spectrum_window_hamming_3(channel_spectrum.q15, i) : spectrum_window_hamming_3(channel_spectrum.f, i);
+    return magnitude_squared(corrected_sample * scale);
+}
+
+void SpectrumCollector::average_segments() {
+    auto& averager = segments->averager;
+    averager.reset();
+    for (size_t offset = 0; offset + dsp::welch::length <= segment_span; offset += segments->step) {
+        averager.add(&segments->samples[offset]);
+    }
+}
+
+template <typename PowerOfBin>
+void SpectrumCollector::publish(const PowerOfBin power_of_bin) {
+    ChannelSpectrum spectrum;
+    spectrum.sampling_rate = channel_spectrum_sampling_rate;
+    spectrum.channel_filter_low_frequency = channel_filter_low_frequency;
+    spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
+    spectrum.channel_filter_transition = channel_filter_transition;
+
+    if (accumulator) {
+        /* Reduce in linear power, only post once enough frames are in. */
+        using Mode = SpectrumAccumulationConfigMessage::Mode;
+        auto& acc = *accumulator;
+        const bool first = (accumulated_frames == 0);
+        for (size_t i = 0; i < acc.size(); i++) {
+            const float mag2 = power_of_bin(i);
+            if (first) {
+                acc[i] = mag2;
+            } else if (accumulation_mode == Mode::PeakHold) {
+                acc[i] = std::max(acc[i], mag2);
+            } else if (accumulation_mode == Mode::MinHold) {
+                acc[i] = std::min(acc[i], mag2);
+            } else {
+                acc[i] += mag2;
+            }
+        }
+
+        accumulated_frames++;
+        if (accumulated_frames >= accumulation_frames) {
+            const float norm = (accumulation_mode == Mode::Average) ? 1.0f / accumulated_frames : 1.0f;
+            for (size_t i = 0; i < spectrum.db.size(); i++) {
+                spectrum.db[i] = spectrum_db(acc[i] * norm);
+            }
+            accumulated_frames = 0;
+            fifo.in(spectrum);
+        }
+    } else {
+        for (size_t i = 0; i < spectrum.db.size(); i++) {
+            spectrum.db[i] = spectrum_db(power_of_bin(i));
+        }
+        fifo.in(spectrum);
+    }
+}
+
 void SpectrumCollector::update() {
     // Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
     if (streaming && channel_spectrum_request_update) {
-        /* Decimated buffer is full. Compute spectrum. */
-        fft_c_preswapped(channel_spectrum, 0, 8);
-
-        ChannelSpectrum spectrum;
-        spectrum.sampling_rate = channel_spectrum_sampling_rate;
-        spectrum.channel_filter_low_frequency = channel_filter_low_frequency;
-        spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
-        spectrum.channel_filter_transition = channel_filter_transition;
-        for (size_t i = 0; i < spectrum.db.size(); i++) {
-            const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-            const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-            const float db = mag2_to_dbv_norm(mag2);
-            constexpr float mag_scale = 5.0f;
-            const unsigned int v = (db * mag_scale) + 255.0f;
-            spectrum.db[i] = std::max(0U, std::min(255U, v));
+        if (segments_posted) {
+            /* Windowed power is already final, no frequency domain window. */
+            average_segments();
+            const auto& averager = segments->averager;
+            publish([&averager](const size_t i) { return averager.power(i); });
+        } else {
+            /* Decimated buffer is full. Compute spectrum. */
+            float scale = 1.0f / 32768.0f;
+            if (fft_backend == FFTBackend::Q15) {
+                scale = std::ldexp(scale, fft_c_preswapped_q15(channel_spectrum.q15));
+            } else {
+                fft_c_preswapped_radix4(channel_spectrum.f);
+            }
+            publish([this, scale](const size_t i) { return bin_power(i, scale); });
         }
-        fifo.in(spectrum);
     }
 
     channel_spectrum_request_update = false;
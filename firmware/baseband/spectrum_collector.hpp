@@ -29,14 +29,28 @@
 #include "complex.hpp"
 
 #include "block_decimator.hpp"
+#include "dsp_welch.hpp"
+#include "dsp_zoom.hpp"
 
 #include <cstdint>
 #include <array>
+#include <memory>
 
 #include "message.hpp"
 
 class SpectrumCollector {
    public:
+    /* Float is the reference path; Q15 runs the packed fixed-point FFT with
+     * block floating point, which wideband segments always use (dsp_welch.hpp).
+     */
+    enum class FFTBackend : uint8_t {
+        Float,
+        Q15,
+    };
+
+    explicit SpectrumCollector(const FFTBackend backend = FFTBackend::Float)
+        : fft_backend{backend} {}
+
     void on_message(const Message* const message);
 
     void set_decimation_factor(const size_t decimation_factor);
@@ -47,6 +61,15 @@ class SpectrumCollector {
         const int32_t filter_high_frequency,
         const int32_t filter_transition);
 
+    /* Welch averaged frames for wideband input: feed_segments() keeps the
+     * first segment_span samples, and update() averages the power of every
+     * 256 sample segment of that span, step samples apart. Returns false if
+     * the previous frame is still being processed.
+     */
+    static constexpr size_t segment_span = 1024;
+    void configure_segments(const WidebandSpectrumConfigMessage::Window window, const size_t step);
+    bool feed_segments(const buffer_c8_t& samples);
+
    private:
     BlockDecimator<complex16_t, 256> channel_spectrum_decimator{1};
     ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k]{};
@@ -54,7 +77,34 @@ class SpectrumCollector {
 
     volatile bool channel_spectrum_request_update{false};
     bool streaming{false};
-    std::array<std::complex<float>, 256> channel_spectrum{};
+    const FFTBackend fft_backend;
+    /* Only one backend's work buffer is live at a time. */
+    union ChannelSpectrumBuffer {
+        ChannelSpectrumBuffer()
+            : f{} {}
+        std::array<std::complex<float>, 256> f;
+        std::array<complex16_t, 256> q15;
+    } channel_spectrum{};
+    SpectrumAccumulationConfigMessage::Mode accumulation_mode{SpectrumAccumulationConfigMessage::Mode::None};
+    size_t accumulation_frames{1};
+    size_t accumulated_frames{0};
+    /* Linear power per bin, only allocated while accumulation is enabled. */
+    std::unique_ptr<std::array<float, 256>> accumulator{};
+    struct Segments {
+        std::array<complex8_t, segment_span> samples;
+        size_t step;
+        dsp::welch::Averager averager;
+    };
+    /* Only allocated by configure_segments(). */
+    std::unique_ptr<Segments> segments{};
+    bool segments_posted{false};
+    /* Allocated on the first zoom request and kept, since the baseband
+     * thread may be inside feed() when streaming switches back. */
+    std::unique_ptr<dsp::zoom::ZoomDecimator<256>> zoom{};
+    volatile bool zoom_active{false};
+    volatile bool zoom_reconfigure{false};
+    int32_t zoom_offset{0};
+    size_t zoom_decimation{1};
     uint32_t channel_spectrum_sampling_rate{0};
     int32_t channel_filter_low_frequency{0};
     int32_t channel_filter_high_frequency{0};
@@ -63,10 +113,15 @@ class SpectrumCollector {
     void post_message(const buffer_c16_t& data);
 
     void set_state(const SpectrumStreamingConfigMessage& message);
+    void set_accumulation(const SpectrumAccumulationConfigMessage& message);
     void start();
     void stop();
 
     void update();
+    float bin_power(const size_t i, const float scale) const;
+    void average_segments();
+    template <typename PowerOfBin>
+    void publish(const PowerOfBin power_of_bin);
 };
 
 #endif /*__SPECTRUM_COLLECTOR_H__*/
@@ -132,6 +132,11 @@ typedef enum IRQn {
 #define __SIMD32(addr)  (*(__SIMD32_TYPE **) & (addr))
 #define _SIMD32_OFFSET(addr) (*(__SIMD32_TYPE *) (addr))
 
+/* Host builds (unit tests, benchmarks) get portable equivalents of the
+ * intrinsics below from the stand-in CMSIS headers in test/include/cmsis_host.
+ */
+#if defined(__arm__)
+
 /* Overload of __SXTB16() to add ROR argument, since using __ROR() as an
  * argument to the existing __SXTB16() doesn't produce optimum/sane code.
  */
@@ -264,6 +269,8 @@ __attribute__( ( always_inline ) ) __STATIC_INLINE int32_t __SMMULR (int32_t op1
   return(result);
 }
 
+#endif /* defined(__arm__) */
+
 #endif /* __cplusplus */
 
 #endif /* __LPC43XX_M4_H */
@@ -31,6 +31,17 @@
 
 namespace ais {
 
+/* AIS 1 is channel 87B at 161.975MHz, AIS 2 is channel 88B at 162.025MHz.
+ * Both are received at once when tuned halfway between them. */
+enum class Channel : uint8_t {
+    A,
+    B,
+};
+
+constexpr uint32_t channel_a_frequency = 161975000;
+constexpr uint32_t channel_b_frequency = 162025000;
+constexpr uint32_t dual_channel_frequency = 162000000;
+
 struct DateTime {
     uint16_t year;
     uint8_t month;
@@ -97,11 +108,15 @@ using MMSI = uint32_t;
 class Packet {
    public:
     constexpr Packet(
-        const baseband::Packet& packet)
+        const baseband::Packet& packet,
+        const Channel channel = Channel::A)
         : packet_{packet},
-          field_{packet_} {
+          field_{packet_},
+          channel_{channel} {
     }
 
+    Channel channel() const { return channel_; }
+
     size_t length() const;
 
     bool is_valid() const;
@@ -129,6 +144,7 @@ class Packet {
 
     const baseband::Packet packet_;
     const Reader field_;
+    const Channel channel_;
 
     const size_t fcs_length = 16;
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __CTCSS_TONES_H__
+#define __CTCSS_TONES_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace ctcss {
+
+/* CTCSS tones of tonekey::tone_keys, in 0.01 Hz units, ascending.
+ * Shared with the baseband, which can't use the application's table.
+ */
+constexpr std::array<uint16_t, 50> tones_centihz{{
+    6700, 6930, 7190, 7440, 7700, 7970, 8250, 8540, 8850, 9150,
+    9480, 9740, 10000, 10350, 10720, 11090, 11480, 11880, 12300, 12730,
+    13180, 13650, 14130, 14620, 15140, 15670, 15980, 16220, 16550, 16790,
+    17130, 17380, 17730, 17990, 18350, 18620, 18990, 19280, 19660, 19950,
+    20350, 20650, 21070, 21810, 22570, 22910, 23360, 24180, 25030, 25410,
+}};
+
+constexpr size_t tone_count = tones_centihz.size();
+
+} /* namespace ctcss */
+
+#endif /*__CTCSS_TONES_H__*/
@@ -133,6 +133,110 @@ void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to
     }
 }
 
+/* constexpr sine for building twiddle tables at compile time.
+ * Only valid for 0 <= x <= pi/2, which is all a quarter-wave table needs.
+ */
+constexpr double fft_sine_quadrant(const double x) {
+    double term = x;
+    double sum = x;
+    for (size_t n = 1; n < 12; n++) {
+        term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/* Quarter-wave sine table: sin(2*pi*i/N) for i in [0, N/4].
+ * A full set of twiddle factors is derived from it by symmetry, which keeps
+ * the table at N/4+1 floats (2KiB for N=2048) instead of N complex values.
+ */
+template <size_t N>
+struct FFTTwiddleTable {
+    static_assert(power_of_two(N) && (N >= 4), "only defined for N == power of two, N >= 4");
+
+    static constexpr size_t quarter = N / 4;
+
+    static constexpr std::array<float, quarter + 1> make_table() {
+        std::array<float, quarter + 1> table{};
+        constexpr double pi = 3.14159265358979323846;
+        for (size_t i = 0; i <= quarter; i++) {
+            table[i] = static_cast<float>(fft_sine_quadrant(2.0 * pi * i / N));
+        }
+        return table;
+    }
+
+    static constexpr std::array<float, quarter + 1> sine = make_table();
+
+    /* Returns exp(-j*2*pi*p/N) for p in [0, N). */
+    static std::complex<float> w(const size_t p) {
+        const size_t r = p & (quarter - 1);
+        const float s = sine[r];
+        const float c = sine[quarter - r];
+        switch (p / quarter) {
+            case 0:
+                return {c, -s};
+            case 1:
+                return {-s, -c};
+            case 2:
+                return {-c, s};
+            default:
+                return {s, c};
+        }
+    }
+};
+
+/* Radix-4 (radix-2^2) decimation-in-time FFT with table twiddles.
+ * Takes the same bit-reversed input as fft_c_preswapped() and produces the
+ * same output, but fuses each pair of radix-2 stages into one radix-4 pass
+ * (3 complex multiplies per 4 points instead of 4) and reads twiddles from a
+ * constexpr table instead of accumulating them, so error doesn't grow with N.
+ * When log2(N) is odd, a single twiddle-free radix-2 pass is run first.
+ */
+template <typename T, size_t N>
+void fft_c_preswapped_radix4(std::array<T, N>& data) {
+    static_assert(power_of_two(N) && (N >= 4), "only defined for N == power of two, N >= 4");
+    using Twiddles = FFTTwiddleTable<N>;
+    constexpr auto K = log_2(N);
+
+    size_t k = 0;
+    if (K & 1) {
+        for (size_t i = 0; i < N; i += 2) {
+            const T temp = data[i + 1];
+            data[i + 1] = data[i] - temp;
+            data[i] += temp;
+        }
+        k = 1;
+    }
+
+    for (; k < K; k += 2) {
+        const size_t mmax = 1 << k;
+        const size_t stride = N / (mmax * 4);
+        for (size_t m = 0; m < mmax; m++) {
+            const T w1 = Twiddles::w(m * stride);
+            const T w2 = Twiddles::w(2 * m * stride);
+            const T w3 = Twiddles::w(3 * m * stride);
+            for (size_t i = m; i < N; i += mmax * 4) {
+                const T t0 = data[i];
+                const T t1 = w2 * data[i + mmax];
+                const T t2 = w1 * data[i + mmax * 2];
+                const T t3 = w3 * data[i + mmax * 3];
+
+                const T s01 = t0 + t1;
+                const T d01 = t0 - t1;
+                const T s23 = t2 + t3;
+                const T d23 = t2 - t3;
+                /* -j * d23 */
+                const T d23_j{d23.imag(), -d23.real()};
+
+                data[i] = s01 + s23;
+                data[i + mmax] = d01 + d23_j;
+                data[i + mmax * 2] = s01 - s23;
+                data[i + mmax * 3] = d01 - d23_j;
+            }
+        }
+    }
+}
+
 /*
    ifft(v,N):
    [0] If N==1 then return.
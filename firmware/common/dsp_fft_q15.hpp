@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_FFT_Q15_H__
+#define __DSP_FFT_Q15_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "complex.hpp"
+#include "dsp_fft.hpp"
+#include "simd.hpp"
+#include "utility.hpp"
+
+/* Packed Q15 complex FFT for the M4.
+ *
+ * Each complex16_t is handled as one 32-bit word (real in the low half,
+ * imaginary in the high half), so a twiddle multiply is one SMLSD and one
+ * SMLAD, and the butterfly add/subtract is one QADD16/QSUB16 each.
+ *
+ * Block floating point: before every stage the peak of the block is checked
+ * and the stage scales its outputs down by 0, 1 or 2 bits so that no
+ * butterfly can overflow. The total shift is returned as the block exponent,
+ * i.e. the true transform is data * 2^exponent.
+ */
+
+/* Quarter-wave Q15 sine table: sin(2*pi*i/N) * 32767 for i in [0, N/4]. */
+template <size_t N>
+struct FFTTwiddleTableQ15 {
+    static_assert(power_of_two(N) && (N >= 4), "only defined for N == power of two, N >= 4");
+
+    static constexpr size_t quarter = N / 4;
+
+    static constexpr std::array<int16_t, quarter + 1> make_table() {
+        std::array<int16_t, quarter + 1> table{};
+        constexpr double pi = 3.14159265358979323846;
+        for (size_t i = 0; i <= quarter; i++) {
+            const double v = fft_sine_quadrant(2.0 * pi * i / N) * 32767.0;
+            table[i] = static_cast<int16_t>(v + 0.5);
+        }
+        return table;
+    }
+
+    static constexpr std::array<int16_t, quarter + 1> sine = make_table();
+
+    /* Returns exp(-j*2*pi*p/N) in Q15 for p in [0, N/2). */
+    static vec2_s16 w(const size_t p) {
+        const size_t r = p & (quarter - 1);
+        const int16_t s = sine[r];
+        const int16_t c = sine[quarter - r];
+        if (p < quarter) {
+            return {c, static_cast<int16_t>(-s)};
+        } else {
+            return {static_cast<int16_t>(-s), static_cast<int16_t>(-c)};
+        }
+    }
+};
+
+/* Bitwise OR of one's complement magnitudes. It has a bit at or above b set
+ * if and only if some component reaches 2^b in magnitude (2^b + 1 if
+ * negative), which is all the block exponent logic needs and is cheaper than
+ * a true maximum.
+ */
+static inline uint32_t fft_q15_peak_bits(const vec2_s16 v) {
+    const int32_t re = v.v[0];
+    const int32_t im = v.v[1];
+    return static_cast<uint32_t>((re ^ (re >> 31)) | (im ^ (im >> 31)));
+}
+
+/* Each butterfly output component is bounded by (1 + sqrt(2)) times the
+ * largest input magnitude. Measured as in fft_q15_peak_bits(), a peak below
+ * 2^13 needs no scaling, below 2^14 needs one bit and anything else two.
+ */
+static inline size_t fft_q15_stage_shift(const uint32_t peak_bits) {
+    if (peak_bits & 0xffffc000) return 2;
+    if (peak_bits & 0x00002000) return 1;
+    return 0;
+}
+
+template <size_t N>
+int32_t fft_c_preswapped_q15(std::array<complex16_t, N>& data) {
+    static_assert(power_of_two(N) && (N >= 4), "only defined for N == power of two, N >= 4");
+    static_assert(sizeof(complex16_t) == sizeof(vec2_s16), "complex16_t must pack into one word");
+    using Twiddles = FFTTwiddleTableQ15<N>;
+    constexpr auto K = log_2(N);
+
+    vec2_s16* const p = reinterpret_cast<vec2_s16*>(data.data());
+
+    uint32_t peak_bits = 0;
+    for (size_t i = 0; i < N; i++) {
+        peak_bits |= fft_q15_peak_bits(p[i]);
+    }
+
+    int32_t exponent = 0;
+
+    /* Provide data to this function, pre-swapped. */
+    for (size_t k = 0; k < K; k++) {
+        const size_t shift = fft_q15_stage_shift(peak_bits);
+        const int32_t round = 1 << (14 + shift);
+        exponent += shift;
+        peak_bits = 0;
+
+        const size_t mmax = 1 << k;
+        const size_t stride = N / (mmax * 2);
+        for (size_t m = 0; m < mmax; m++) {
+            const vec2_s16 w = Twiddles::w(m * stride);
+            const vec2_s16 w_x{w.v[1], w.v[0]};
+            for (size_t i = m; i < N; i += mmax * 2) {
+                const size_t j = i + mmax;
+                const vec2_s16 b = p[j];
+                // (br * wr - bi * wi) + j(br * wi + bi * wr), Q30 -> Q15, rounding in the accumulator
+                const int32_t t_re = smlsd(b, w, round) >> (15 + shift);
+                const int32_t t_im = smlad(b, w_x, round) >> (15 + shift);
+                const vec2_s16 t{static_cast<int16_t>(t_re), static_cast<int16_t>(t_im)};
+
+                vec2_s16 a = p[i];
+                if (shift) {
+                    a = {static_cast<int16_t>(a.v[0] >> shift), static_cast<int16_t>(a.v[1] >> shift)};
+                }
+
+                p[i] = qadd16(a, t);
+                p[j] = qsub16(a, t);
+                peak_bits |= fft_q15_peak_bits(p[i]) | fft_q15_peak_bits(p[j]);
+            }
+        }
+    }
+
+    return exponent;
+}
+
+#endif /*__DSP_FFT_Q15_H__*/
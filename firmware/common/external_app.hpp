@@ -48,4 +48,17 @@ struct application_information_t {
     uint32_t m4_app_offset;
 };
 
+#define COMPRESSED_APPLICATION_MAGIC 0x5a4d5050  // "PPMZ"
+
+/* Optional .ppmz next to a .ppma: the image as it sits in RAM once loaded
+ * (m4 image first, then the application), as one raw lz4 block followed by
+ * four zero bytes. checksum makes the words of the image sum to zero; it
+ * is also the .ppma's trailing word, which ties the .ppmz to its .ppma. */
+struct compressed_application_header_t {
+    uint32_t magic;
+    uint32_t image_size;
+    uint32_t compressed_size;
+    uint32_t checksum;
+};
+
 #endif /*__EXTERNAL_APPS_H__*/
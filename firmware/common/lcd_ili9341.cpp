@@ -28,6 +28,7 @@
 using namespace portapack;
 
 #include "utility.hpp"
+#include "ui_glyph_run.hpp"
 
 #include "ch.h"
 
@@ -44,6 +45,12 @@ namespace lcd {
 
 namespace {
 
+/* Size of every RAM write window opened, i.e. pixels sent to the panel. */
+uint32_t pixels_pushed_total = 0;
+
+/* Nibble patterns for the last colour pair text was drawn in. */
+ui::GlyphRowExpander glyph_expander{};
+
 void lcd_reset() {
     io.lcd_reset_state(false);
     chThdSleepMilliseconds(1);
@@ -237,6 +244,7 @@ void lcd_paset(const uint_fast16_t start_page, const uint_fast16_t end_page) {
 void lcd_start_ram_write(
     const ui::Point p,
     const ui::Size s) {
+    pixels_pushed_total += s.width() * s.height();
     lcd_caset(p.x(), p.x() + s.width() - 1);
     lcd_paset(p.y(), p.y() + s.height() - 1);
     lcd_ramwr_start();
@@ -300,6 +308,10 @@ bool ILI9341::read_display_status() {
     return true;
 }
 
+uint32_t ILI9341::pixels_pushed() const {
+    return pixels_pushed_total;
+}
+
 void ILI9341::init() {
     lcd_reset();
     lcd_init();
@@ -654,10 +666,12 @@ void ILI9341::draw_bitmap(
         if (ui::Color::magenta().v != background.v) {
             lcd_start_ram_write(p, size);
 
+            const uint32_t fg = io.lcd_output_color(foreground).v;
+            const uint32_t bg = io.lcd_output_color(background).v;
             const size_t count = size.width() * size.height();
             for (size_t i = 0; i < count; i++) {
                 const auto pixel = pixels[i >> 3] & (1U << (i & 0x7));
-                io.lcd_write_pixel(pixel ? foreground : background);
+                io.lcd_write_word(pixel ? fg : bg);
             }
         } else {
             // transparent bg
@@ -710,7 +724,44 @@ void ILI9341::draw_glyph(
     const ui::Color foreground,
     const ui::Color background,
     uint8_t zoom_level) {
-    draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background, zoom_level);
+    if (zoom_level <= 1) {
+        const uint8_t* const pixels = glyph.pixels();
+        draw_glyph_run(p, glyph.size(), &pixels, 1, foreground, background);
+    } else {
+        draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background, zoom_level);
+    }
+}
+
+void ILI9341::draw_glyph_run(
+    const ui::Point p,
+    const ui::Size glyph_size,
+    const uint8_t* const* const glyphs,
+    const size_t count,
+    const ui::Color foreground,
+    const ui::Color background) {
+    const size_t w = glyph_size.width();
+    const size_t h = glyph_size.height();
+    const size_t run_width = count * w;
+
+    if ((w > ui::GlyphRowExpander::max_glyph_width) ||
+        (run_width > glyph_run_max_width) ||
+        (ui::Color::magenta().v == background.v)) {
+        for (size_t i = 0; i < count; i++) {
+            draw_bitmap({static_cast<ui::Coord>(p.x() + i * w), p.y()}, glyph_size, glyphs[i], foreground, background);
+        }
+        return;
+    }
+
+    glyph_expander.set_colors(io.lcd_output_color(foreground), io.lcd_output_color(background));
+    lcd_start_ram_write(p, {static_cast<ui::Dim>(run_width), static_cast<ui::Dim>(h)});
+
+    std::array<ui::Color, glyph_run_max_width> row;
+    for (size_t y = 0; y < h; y++) {
+        for (size_t i = 0; i < count; i++) {
+            glyph_expander.expand_row(glyphs[i], w, y, &row[i * w]);
+        }
+        io.lcd_write_pixels_prepared(row.data(), run_width);
+    }
 }
 
 void ILI9341::scroll_set_area(
@@ -44,6 +44,9 @@ class ILI9341 {
 
     bool read_display_status();
 
+    /* Running count of pixels written to the panel; wraps. */
+    uint32_t pixels_pushed() const;
+
     void init();
     void shutdown();
 
@@ -105,6 +108,19 @@ class ILI9341 {
         const ui::Color background,
         uint8_t zoom_level = 1);
 
+    /* Widest run draw_glyph_run() sends as one window. */
+    static constexpr size_t glyph_run_max_width = 320;
+
+    /* Draws count glyphs of the same size side by side, starting at p, in a
+     * single address window filled a row at a time. */
+    void draw_glyph_run(
+        const ui::Point p,
+        const ui::Size glyph_size,
+        const uint8_t* const* const glyphs,
+        const size_t count,
+        const ui::Color foreground,
+        const ui::Color background);
+
     /*** Scrolling ***
      * Scrolling support is implemented in the ILI9341 driver. Basically a region
      * of the screen is set up to act as a circular buffer. The VSA (vertical scroll
@@ -33,6 +33,7 @@
 #include "baseband_packet.hpp"
 
 #include "adsb_frame.hpp"
+#include "ais_packet.hpp"
 #include "ert_packet.hpp"
 #include "pocsag_packet.hpp"
 #include "aprs_packet.hpp"
@@ -134,6 +135,10 @@ class Message {
         NoaaAptRxConfigure = 77,
         NoaaAptRxStatusData = 78,
         NoaaAptRxImageData = 79,
+        SpectrumAccumulationConfig = 80,
+        ChannelizerConfig = 81,
+        ChannelizerActivity = 82,
+        AISConfigure = 83,
         MAX
     };
 
@@ -260,32 +265,126 @@ class AudioStatisticsMessage : public Message {
 
 class SpectrumStreamingConfigMessage : public Message {
    public:
+    /* Zoom streams the spectrum of a narrow slice of the channel: the
+     * component at zoom_offset (Hz from channel centre) is moved to DC and
+     * the channel is decimated by zoom_decimation before the FFT. */
     enum class Mode : uint32_t {
         Stopped = 0,
         Running = 1,
+        Zoom = 2,
     };
 
     constexpr SpectrumStreamingConfigMessage(
-        Mode mode)
+        Mode mode,
+        int32_t zoom_offset = 0,
+        uint32_t zoom_decimation = 1)
         : Message{ID::SpectrumStreamingConfig},
-          mode{mode} {
+          mode{mode},
+          zoom_offset{zoom_offset},
+          zoom_decimation{zoom_decimation} {
     }
 
     Mode mode{Mode::Stopped};
+    int32_t zoom_offset{0};
+    uint32_t zoom_decimation{1};
+};
+
+class SpectrumAccumulationConfigMessage : public Message {
+   public:
+    /* Reductions run by SpectrumCollector in linear power before a frame is
+     * posted. Only one reduced frame is posted per 'frames' FFTs. */
+    enum class Mode : uint8_t {
+        None = 0,
+        Average = 1,
+        PeakHold = 2,
+        MinHold = 3,
+    };
+
+    constexpr SpectrumAccumulationConfigMessage(
+        Mode mode,
+        uint8_t frames)
+        : Message{ID::SpectrumAccumulationConfig},
+          mode{mode},
+          frames{frames} {
+    }
+
+    Mode mode{Mode::None};
+    uint8_t frames{1};
 };
 
 class WidebandSpectrumConfigMessage : public Message {
    public:
+    /* Time-domain window applied to each 256 sample segment before its FFT. */
+    enum class Window : uint8_t {
+        None = 0,
+        Hann = 1,
+        BlackmanHarris = 2,
+        FlatTop = 3,
+    };
+
     constexpr WidebandSpectrumConfigMessage(
         size_t sampling_rate,
-        size_t trigger)
+        size_t trigger,
+        Window window = Window::Hann,
+        uint8_t overlap = 50)
         : Message{ID::WidebandSpectrumConfig},
           sampling_rate{sampling_rate},
-          trigger{trigger} {
+          trigger{trigger},
+          window{window},
+          overlap{overlap} {
     }
 
     size_t sampling_rate{0};
     size_t trigger{0};
+    Window window{Window::Hann};
+    uint8_t overlap{50};  // Segment overlap in percent, 0-75.
+};
+
+class ChannelizerConfigMessage : public Message {
+   public:
+    constexpr ChannelizerConfigMessage(
+        uint32_t sampling_rate,
+        int8_t squelch_db,
+        uint8_t hysteresis_db = 3,
+        uint8_t report_interval_ms = 20)
+        : Message{ID::ChannelizerConfig},
+          sampling_rate{sampling_rate},
+          squelch_db{squelch_db},
+          hysteresis_db{hysteresis_db},
+          report_interval_ms{report_interval_ms} {
+    }
+
+    uint32_t sampling_rate{0};
+    int8_t squelch_db{-60};  // dBFS per channel
+    uint8_t hysteresis_db{3};
+    uint8_t report_interval_ms{20};
+};
+
+/* Posted by the channelizer once per report interval. Channel i is centred
+ * at (i - channel_count / 2) * sampling_rate / channel_count from the tuned
+ * frequency, so channel 0 is the lowest.
+ */
+class ChannelizerActivityMessage : public Message {
+   public:
+    static constexpr size_t channel_count = 64;
+    /* Centre channel, on the LO leakage/DC spur. Always reported closed. */
+    static constexpr size_t dc_channel = channel_count / 2;
+
+    constexpr ChannelizerActivityMessage()
+        : Message{ID::ChannelizerActivity} {
+    }
+
+    int32_t channel_offset(const size_t channel) const {
+        return static_cast<int32_t>((static_cast<int64_t>(channel) - int64_t{channel_count / 2}) * sampling_rate / int64_t{channel_count});
+    }
+
+    bool is_open(const size_t channel) const {
+        return (open_mask >> channel) & 1;
+    }
+
+    uint32_t sampling_rate{0};
+    uint64_t open_mask{0};  // Bit i set while channel i's squelch is open.
+    std::array<int8_t, channel_count> power_db{};  // Mean power, dBFS
 };
 
 struct AudioSpectrum {
@@ -330,12 +429,31 @@ class ChannelSpectrumConfigMessage : public Message {
 class AISPacketMessage : public Message {
    public:
     constexpr AISPacketMessage(
-        const baseband::Packet& packet)
+        const baseband::Packet& packet,
+        const ais::Channel channel)
         : Message{ID::AISPacket},
-          packet{packet} {
+          packet{packet},
+          channel{channel} {
     }
 
     baseband::Packet packet;
+    ais::Channel channel;
+};
+
+class AISConfigureMessage : public Message {
+   public:
+    constexpr AISConfigureMessage(
+        const bool dual_channel,
+        const ais::Channel channel)
+        : Message{ID::AISConfigure},
+          dual_channel{dual_channel},
+          channel{channel} {
+    }
+
+    /* Receive both channels, tuned to ais::dual_channel_frequency. */
+    const bool dual_channel;
+    /* The channel tuned to otherwise, to tag packets with. */
+    const ais::Channel channel;
 };
 
 class TPMSPacketMessage : public Message {
@@ -463,15 +581,35 @@ class BLEPacketMessage : public Message {
     BlePacketData* packet{nullptr};
 };
 
+/* A BLEPacketMessage carrying its own packet, for the packet batch ring.
+ * Handlers must read data rather than packet: a copy made when the ring is
+ * full and the message goes through the application queue still has packet
+ * pointing at the original, on the M4 stack. */
+class BLEPacketSlotMessage : public BLEPacketMessage {
+   public:
+    BLEPacketSlotMessage(
+        const BlePacketData& packet_data)
+        : BLEPacketMessage{&data},
+          data{packet_data} {
+    }
+
+    BlePacketData data;
+};
+
 class CodedSquelchMessage : public Message {
    public:
     constexpr CodedSquelchMessage(
-        const uint32_t value)
+        const uint32_t value,
+        const uint8_t confidence = 0)
         : Message{ID::CodedSquelch},
-          value{value} {
+          value{value},
+          confidence{confidence} {
     }
 
+    /* Tone in 0.01Hz units, 0 if none detected. */
     uint32_t value;
+    /* Detector confidence for the strongest tone, 0-100. */
+    uint8_t confidence;
 };
 
 class ShutdownMessage : public Message {
@@ -735,7 +873,7 @@ struct CaptureConfig {
             return 0;
         } else {
             const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-            return std::max(1U, percent);
+            return std::max<size_t>(1U, percent);
         }
     }
 };
@@ -22,7 +22,9 @@
 #ifndef __MESSAGE_QUEUE_H__
 #define __MESSAGE_QUEUE_H__
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include "message.hpp"
 #include "fifo.hpp"
@@ -119,4 +121,159 @@ class MessageQueue {
     void signal();
 };
 
+/* Lock-free single producer, single consumer message queue, for M4 to M0.
+ *
+ * Records are 4-byte aligned and never split across the end of the buffer
+ * (a wrap marker sends the reader back to the start), so the consumer can
+ * dispatch each message in place instead of copying it out. Only the
+ * producer writes in_ and only the consumer writes out_, so the cores never
+ * contend for a lock; threads on the producing core are serialized by a
+ * short system lock around the copy.
+ *
+ * A message that doesn't fit is dropped and counted against its ID.
+ */
+class SPSCMessageQueue {
+   public:
+    SPSCMessageQueue() = delete;
+    SPSCMessageQueue(const SPSCMessageQueue&) = delete;
+    SPSCMessageQueue(SPSCMessageQueue&&) = delete;
+
+    SPSCMessageQueue(
+        uint8_t* const data,
+        size_t k)
+        : data_{data},
+          size_{1U << k} {
+    }
+
+    template <typename T>
+    bool push(const T& message) {
+        static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
+        static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+        return push(&message, sizeof(message), message.id);
+    }
+
+    template <typename HandlerFn>
+    void handle(HandlerFn handler) {
+        while (Message* const message = peek()) {
+            handler(message);
+            skip();
+        }
+    }
+
+    /* Oldest message, in place in the queue. Valid until skip(). */
+    Message* peek() {
+        while (!is_empty()) {
+            const size_t offset = out_ & mask();
+            if (length_at(offset) != wrap_marker) {
+                __DMB();
+                return reinterpret_cast<Message*>(&data_[offset + header_size]);
+            }
+            out_ = out_ + (size_ - offset);
+        }
+        return nullptr;
+    }
+
+    void skip() {
+        // A handler may have reset the queue (baseband shutdown).
+        if (is_empty()) {
+            return;
+        }
+
+        const size_t length = length_at(out_ & mask());
+        // Finish reading the message before handing its space back.
+        __DMB();
+        out_ = out_ + record_size(length);
+    }
+
+    bool is_empty() const {
+        return in_ == out_;
+    }
+
+    /* Only while the producer is stopped. Drop statistics are kept. */
+    void reset() {
+        in_ = out_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    uint32_t pushed() const { return pushed_; }
+    uint32_t dropped() const { return dropped_; }
+    size_t high_water() const { return high_water_; }
+
+    uint16_t dropped(const Message::ID id) const {
+        return dropped_by_id_[static_cast<size_t>(id)];
+    }
+
+    void reset_stats() {
+        pushed_ = dropped_ = high_water_ = 0;
+        std::fill(std::begin(dropped_by_id_), std::end(dropped_by_id_), 0);
+    }
+
+   private:
+    static constexpr uint16_t wrap_marker = 0xffff;
+    static constexpr size_t header_size = 4;
+
+    uint8_t* const data_;
+    const size_t size_;
+    volatile uint32_t in_{0};
+    volatile uint32_t out_{0};
+
+    uint32_t pushed_{0};
+    uint32_t dropped_{0};
+    uint32_t high_water_{0};
+    uint16_t dropped_by_id_[static_cast<size_t>(Message::ID::MAX)]{};
+
+    size_t mask() const {
+        return size_ - 1;
+    }
+
+    static constexpr size_t record_size(const size_t length) {
+        return header_size + ((length + 3) & ~size_t{3});
+    }
+
+    uint16_t length_at(const size_t offset) const {
+        return *reinterpret_cast<const uint16_t*>(&data_[offset]);
+    }
+
+    bool push(const void* const buf, const size_t len, const Message::ID id) {
+        const size_t record = record_size(len);
+        bool success = false;
+
+        chSysLock();
+        uint32_t in = in_;
+        size_t offset = in & mask();
+        const size_t tail = size_ - offset;
+        const size_t needed = (record > tail) ? tail + record : record;
+
+        if (needed <= size_ - (in - out_)) {
+            if (record > tail) {
+                *reinterpret_cast<uint16_t*>(&data_[offset]) = wrap_marker;
+                in += tail;
+                offset = 0;
+            }
+
+            *reinterpret_cast<uint16_t*>(&data_[offset]) = len;
+            memcpy(&data_[offset + header_size], buf, len);
+            __DMB();
+            in_ = in + record;
+
+            pushed_++;
+            high_water_ = std::max<uint32_t>(high_water_, in_ - out_);
+            success = true;
+        } else {
+            dropped_++;
+            auto& count = dropped_by_id_[static_cast<size_t>(id)];
+            if (count < UINT16_MAX) count++;
+        }
+        chSysUnlock();
+
+        if (success) {
+            signal();
+        }
+        return success;
+    }
+
+    void signal();
+};
+
 #endif /*__MESSAGE_QUEUE_H__*/
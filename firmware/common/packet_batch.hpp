@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PACKET_BATCH_H__
+#define __PACKET_BATCH_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "message.hpp"
+
+#include <ch.h>
+
+/* Ring of fixed size packet slots in shared memory, for decoders that can
+ * produce hundreds of packets a second (ADS-B, BLE).
+ *
+ * Each slot holds one complete Message, constructed in place by the baseband
+ * thread. Packets are published to the M0 in batches, when flush_count are
+ * waiting or the oldest has waited flush_latency, so a burst of packets
+ * costs one M0 wakeup instead of one each. The M0 event loop dispatches
+ * every published slot in place, in one pass.
+ *
+ * The ring only has room for a short burst. post() sends packets that don't
+ * fit through the application queue instead, which the M0 drains first, so
+ * those can arrive ahead of older packets still in the ring.
+ *
+ * Producer: post(), or emplace() + commit(), from the baseband thread only,
+ * and service() once per baseband buffer. Consumer: handle() on the M0.
+ */
+class PacketBatchRing {
+   public:
+    static constexpr size_t slot_size = 64;
+    static constexpr size_t slot_count = 8;  // Power of two, see slot().
+    static constexpr size_t flush_count = 4;
+    static constexpr systime_t flush_latency = MS2ST(10);
+
+    /* Constructs a packet in the next free slot. Returns nullptr (and counts
+     * a drop) if the M0 hasn't caught up. Call commit() once it's filled in. */
+    template <typename T, typename... Args>
+    T* emplace(Args&&... args) {
+        static_assert(sizeof(T) <= slot_size, "packet type too large for slot");
+        static_assert(alignof(T) <= 4, "packet type alignment too large for slot");
+        static_assert(std::is_base_of<Message, T>::value, "packet type is not based on Message");
+
+        if (write_ - read_ >= slot_count) {
+            dropped_++;
+            return nullptr;
+        }
+
+        return new (slot(write_)) T(std::forward<Args>(args)...);
+    }
+
+    /* Constructs and commits a packet, or pushes it to 'overflow' if the
+     * ring is full. Returns false (and counts a drop) if both are full. */
+    template <typename T, typename Queue, typename... Args>
+    bool post(Queue& overflow, Args&&... args) {
+        if (write_ - read_ < slot_count) {
+            emplace<T>(std::forward<Args>(args)...);
+            commit();
+            return true;
+        }
+
+        // Wake the M0 for what the ring already holds.
+        flush();
+        const T packet{std::forward<Args>(args)...};
+        if (overflow.push(packet)) {
+            overflowed_++;
+            return true;
+        }
+
+        dropped_++;
+        return false;
+    }
+
+    void commit() {
+        if (write_ == published_) {
+            pending_since_ = chTimeNow();
+        }
+
+        write_++;
+        if (write_ - published_ >= flush_count) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (write_ == published_) {
+            return;
+        }
+
+        __DMB();
+        published_ = write_;
+        signal();
+    }
+
+    void service() {
+        if ((write_ != published_) && (chTimeNow() - pending_since_ >= flush_latency)) {
+            flush();
+        }
+    }
+
+    bool is_empty() const {
+        return read_ == published_;
+    }
+
+    template <typename HandlerFn>
+    void handle(HandlerFn handler) {
+        while (!is_empty()) {
+            __DMB();
+            handler(reinterpret_cast<Message*>(slot(read_)));
+
+            // A handler may have reset the ring (baseband shutdown).
+            if (is_empty()) {
+                break;
+            }
+
+            read_ = read_ + 1;
+            delivered_++;
+        }
+    }
+
+    /* Only while the producer is stopped. Unread packets are discarded. */
+    void reset() {
+        write_ = read_ = published_;
+    }
+
+    uint32_t delivered() const { return delivered_; }
+    uint32_t dropped() const { return dropped_; }
+    /* Packets sent through the overflow queue instead of the ring. */
+    uint32_t overflowed() const { return overflowed_; }
+
+   private:
+    alignas(4) uint8_t slots_[slot_count][slot_size]{};
+
+    uint32_t write_{0};
+    volatile uint32_t published_{0};
+    volatile uint32_t read_{0};
+    systime_t pending_since_{0};
+
+    uint32_t delivered_{0};
+    uint32_t dropped_{0};
+    uint32_t overflowed_{0};
+
+    uint8_t* slot(const uint32_t index) {
+        return slots_[index & (slot_count - 1)];
+    }
+
+    void signal();
+};
+
+#endif /*__PACKET_BATCH_H__*/
@@ -200,8 +200,35 @@ class IO {
     }
 
     void lcd_write_pixels(const ui::Color* const pixels, size_t n) {
-        for (size_t i = 0; i < n; i++) {
-            lcd_write_pixel(pixels[i]);
+        if (dark_cover_enabled) {
+            for (size_t i = 0; i < n; i++) {
+                lcd_write_data(DARKENED_PIXEL(pixels[i].v, brightness));
+            }
+        } else {
+            lcd_write_pixels_prepared(pixels, n);
+        }
+    }
+
+    /* The colour a pixel is sent to the panel as, i.e. after the dark cover.
+     * Lets callers that draw few distinct colours convert them once. */
+    ui::Color lcd_output_color(ui::Color pixel) const {
+        if (dark_cover_enabled) {
+            pixel.v = DARKENED_PIXEL(pixel.v, brightness);
+        }
+        return pixel;
+    }
+
+    /* Writes pixels already converted by lcd_output_color(). */
+    void lcd_write_pixels_prepared(const ui::Color* pixels, size_t n) {
+        for (; n >= 4; n -= 4) {
+            lcd_write_data(pixels[0].v);
+            lcd_write_data(pixels[1].v);
+            lcd_write_data(pixels[2].v);
+            lcd_write_data(pixels[3].v);
+            pixels += 4;
+        }
+        while (n--) {
+            lcd_write_data((pixels++)->v);
         }
     }
 
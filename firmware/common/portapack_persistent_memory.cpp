@@ -814,6 +814,7 @@ enum recon_config_bits {
     RC_REPEAT_AMP = 20,
     RC_LOAD_REPEATERS = 19,
     RC_REPEAT_FILE_MODE = 18,
+    RC_FAST_SCAN = 17,
 };
 
 bool check_recon_config_bit(uint8_t rc_bit) {
@@ -877,6 +878,9 @@ bool recon_load_repeaters() {
 bool recon_repeat_recorded_file_mode() {
     return check_recon_config_bit(RC_REPEAT_FILE_MODE);
 }
+bool recon_fast_scan() {
+    return check_recon_config_bit(RC_FAST_SCAN);
+}
 void set_recon_autosave_freqs(const bool v) {
     set_recon_config_bit(RC_AUTOSAVE_FREQS, v);
 }
@@ -907,6 +911,9 @@ void set_recon_match_mode(const bool v) {
 void set_recon_auto_record_locked(const bool v) {
     set_recon_config_bit(RC_AUTO_RECORD_LOCKED, v);
 }
+void set_recon_fast_scan(const bool v) {
+    set_recon_config_bit(RC_FAST_SCAN, v);
+}
 void set_recon_repeat_recorded(const bool v) {
     set_recon_config_bit(RC_REPEAT_RECORDED, v);
 }
@@ -27,6 +27,7 @@
 #include <cstddef>
 
 #include "message_queue.hpp"
+#include "packet_batch.hpp"
 
 struct JammerChannel {
     bool enabled;
@@ -53,16 +54,48 @@ struct ToneData {
     uint8_t message[256];
 };
 
+/* Per-stage DSP cycle counts, written by the M4 profiler and read out by the
+ * M0 shell. The histogram bins are powers of two: bin b counts buffers that
+ * took [2^(b + histogram_base), 2^(b + histogram_base + 1)) cycles.
+ */
+struct M4ProfileStage {
+    static constexpr size_t histogram_bins = 16;
+    static constexpr size_t histogram_base = 8;
+
+    uint32_t min;
+    uint32_t max;
+    uint32_t count;
+    uint64_t total;
+    uint16_t histogram[histogram_bins];
+};
+
+struct M4ProfileTable {
+    enum Stage : uint8_t {
+        Decim0 = 0,
+        Decim1 = 1,
+        Demod = 2,
+        ChannelStats = 3,
+        Buffer = 4,
+        StageCount
+    };
+
+    M4ProfileStage stages[StageCount];
+
+    // Set by the M0 to ask the M4 to clear the table before the next sample.
+    bool volatile reset_request;
+};
+
 /* NOTE: These structures must be located in the same location in both M4 and M0 binaries */
 struct SharedMemory {
     static constexpr size_t application_queue_k = 11;
     static constexpr size_t app_local_queue_k = 11;
 
-    uint8_t application_queue_data[1 << application_queue_k]{0};
+    alignas(4) uint8_t application_queue_data[1 << application_queue_k]{0};
     uint8_t app_local_queue_data[1 << app_local_queue_k]{0};
     const Message* volatile baseband_message{nullptr};
-    MessageQueue application_queue{application_queue_data, application_queue_k};
+    SPSCMessageQueue application_queue{application_queue_data, application_queue_k};
     MessageQueue app_local_queue{app_local_queue_data, app_local_queue_k};
+    PacketBatchRing packet_batch{};
 
     char m4_panic_msg[32]{0};
 
@@ -85,6 +118,8 @@ struct SharedMemory {
     uint16_t volatile m4_stack_usage{0};
     uint32_t volatile m4_heap_usage{0};
     uint16_t volatile m4_buffer_missed{0};
+
+    M4ProfileTable m4_profile{};
 };
 
 extern SharedMemory& shared_memory;
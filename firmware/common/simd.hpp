@@ -67,6 +67,10 @@ struct vec2_s16 {
     };
 };
 
+/* Host builds (unit tests) get these intrinsics from the CMSIS stand-ins
+ * in test/include/cmsis_host.
+ */
+
 static inline vec4_s8 rev16(const vec4_s8 v) {
     vec4_s8 result;
     result.w = __REV16(v.w);
@@ -105,6 +109,18 @@ static inline int32_t smlad(const vec2_s16 v1, const vec2_s16 v2, const int32_t
     return __SMLAD(v1.w, v2.w, accum);
 }
 
+static inline vec2_s16 qadd16(const vec2_s16 v1, const vec2_s16 v2) {
+    vec2_s16 result;
+    result.w = __QADD16(v1.w, v2.w);
+    return result;
+}
+
+static inline vec2_s16 qsub16(const vec2_s16 v1, const vec2_s16 v2) {
+    vec2_s16 result;
+    result.w = __QSUB16(v1.w, v2.w);
+    return result;
+}
+
 #endif /* defined(LPC43XX_M4) */
 
 #endif /*__SIMD_H__*/
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_DAMAGE_REGION_H__
+#define __UI_DAMAGE_REGION_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ui.hpp"
+
+namespace ui {
+
+/* A short list of screen rectangles that need repainting.
+ *
+ * An added rectangle is merged into an existing one when their bounding box
+ * is no larger than the two areas added together, which catches overlapping
+ * and touching rectangles (a row of fields, a widget hidden next to one
+ * that moved) without ever growing into large unchanged areas. When the list
+ * is full, the new rectangle goes to whichever entry it grows least.
+ */
+class DamageRegion {
+   public:
+    static constexpr size_t capacity = 8;
+
+    void add(const Rect& r) {
+        if (r.is_empty())
+            return;
+
+        Rect pending = r;
+        // Merging can make a rectangle that now swallows others, so repeat.
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (size_t i = 0; i < count_; i++) {
+                const Rect b = bounds(rects_[i], pending);
+                if (area(b) <= area(rects_[i]) + area(pending)) {
+                    pending = b;
+                    remove(i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        if (count_ < capacity) {
+            rects_[count_++] = pending;
+            return;
+        }
+
+        size_t best = 0;
+        int32_t best_growth = INT32_MAX;
+        for (size_t i = 0; i < count_; i++) {
+            const int32_t growth = area(bounds(rects_[i], pending)) - area(rects_[i]);
+            if (growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        rects_[best] = bounds(rects_[best], pending);
+    }
+
+    void clear() { count_ = 0; }
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    const Rect* begin() const { return rects_.data(); }
+    const Rect* end() const { return rects_.data() + count_; }
+
+    /* Total pixels covered; the rectangles never overlap by much, so this is
+     * also roughly what repainting them costs. */
+    uint32_t area() const {
+        uint32_t total = 0;
+        for (size_t i = 0; i < count_; i++)
+            total += area(rects_[i]);
+        return total;
+    }
+
+   private:
+    std::array<Rect, capacity> rects_{};
+    size_t count_{0};
+
+    void remove(const size_t i) {
+        rects_[i] = rects_[--count_];
+    }
+
+    static int32_t area(const Rect& r) {
+        return static_cast<int32_t>(r.width()) * r.height();
+    }
+
+    static Rect bounds(const Rect& a, const Rect& b) {
+        const int x1 = std::min(a.left(), b.left());
+        const int y1 = std::min(a.top(), b.top());
+        const int x2 = std::max(a.right(), b.right());
+        const int y2 = std::max(a.bottom(), b.bottom());
+        return {x1, y1, x2 - x1, y2 - y1};
+    }
+};
+
+} /* namespace ui */
+
+#endif /*__UI_DAMAGE_REGION_H__*/
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_GLYPH_RUN_H__
+#define __UI_GLYPH_RUN_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ui.hpp"
+
+namespace ui {
+
+/* Expands rows of 1-bpp glyph bitmaps into RGB565 pixels.
+ *
+ * Glyph bits are packed LSB first with no row padding (pixel i of a w wide
+ * glyph is bit i & 7 of byte i >> 3), so a row can start mid byte. A row is
+ * pulled out as one word and expanded a nibble at a time from a table of
+ * the 16 possible 4 pixel patterns for the current colour pair, which is
+ * only rebuilt when the colours change.
+ */
+class GlyphRowExpander {
+   public:
+    /* Widest glyph row handled in one word (a row may start 7 bits in). */
+    static constexpr size_t max_glyph_width = 24;
+
+    void set_colors(const Color foreground, const Color background) {
+        if (valid_ && foreground.v == foreground_.v && background.v == background_.v)
+            return;
+
+        for (size_t n = 0; n < patterns_.size(); n++) {
+            for (size_t b = 0; b < 4; b++) {
+                patterns_[n][b] = (n & (1U << b)) ? foreground : background;
+            }
+        }
+        foreground_ = foreground;
+        background_ = background;
+        valid_ = true;
+    }
+
+    /* Writes row y of a w pixel wide glyph to out[0..w). */
+    void expand_row(const uint8_t* const pixels, const size_t w, const size_t y, Color* out) const {
+        const size_t first_bit = y * w;
+        const uint8_t* const p = &pixels[first_bit >> 3];
+        const size_t shift = first_bit & 7;
+        const size_t bytes = (shift + w + 7) >> 3;
+
+        uint32_t bits = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            bits |= static_cast<uint32_t>(p[i]) << (i * 8);
+        }
+        bits >>= shift;
+
+        size_t x = 0;
+        for (; x + 4 <= w; x += 4) {
+            const auto& pattern = patterns_[bits & 0xf];
+            out[0] = pattern[0];
+            out[1] = pattern[1];
+            out[2] = pattern[2];
+            out[3] = pattern[3];
+            out += 4;
+            bits >>= 4;
+        }
+        for (; x < w; x++) {
+            *(out++) = (bits & 1) ? foreground_ : background_;
+            bits >>= 1;
+        }
+    }
+
+   private:
+    std::array<std::array<Color, 4>, 16> patterns_{};
+    Color foreground_{};
+    Color background_{};
+    bool valid_{false};
+};
+
+} /* namespace ui */
+
+#endif /*__UI_GLYPH_RUN_H__*/
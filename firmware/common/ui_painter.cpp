@@ -27,6 +27,9 @@
 #include "portapack.hpp"
 using namespace portapack;
 
+#include <algorithm>
+#include <array>
+
 namespace ui {
 
 Style Style::invert() const {
@@ -39,7 +42,8 @@ Style Style::invert() const {
 int Painter::draw_char(Point p, const Style& style, char c, uint8_t zoom_level) {
     const auto glyph = style.font.glyph(c);
 
-    display.draw_glyph(p, glyph, style.foreground, style.background, zoom_level);
+    if (!clipped_out({p, {glyph.size().width() * zoom_level, glyph.size().height() * zoom_level}}))
+        display.draw_glyph(p, glyph, style.foreground, style.background, zoom_level);
 
     return glyph.advance().x() * zoom_level;
 }
@@ -58,8 +62,22 @@ int Painter::draw_string(
     size_t width = 0;
     Color pen = foreground;
 
+    /* Consecutive visible glyphs in the same pen are sent to the display as
+     * one run, i.e. one address window instead of one per character. */
+    std::array<const uint8_t*, max_glyph_run> run;
+    size_t run_count = 0;
+    Point run_p = p;
+    const Size glyph_size{font.char_width(), font.line_height()};
+
+    auto flush_run = [&]() {
+        if (run_count)
+            display.draw_glyph_run(run_p, glyph_size, run.data(), run_count, pen, background);
+        run_count = 0;
+    };
+
     for (auto c : text) {
         if (escape) {
+            flush_run();
             if (c < std::size(term_colors))
                 pen = term_colors[(uint8_t)c];
             else
@@ -70,13 +88,23 @@ int Painter::draw_string(
                 escape = true;
             } else {
                 const auto glyph = font.glyph(c);
-                display.draw_glyph(p, glyph, pen, background);
+                if (clipped_out({p, glyph.size()})) {
+                    flush_run();
+                } else {
+                    if ((run_count == run.size()) ||
+                        ((run_count + 1) * glyph_size.width() > lcd::ILI9341::glyph_run_max_width))
+                        flush_run();
+                    if (run_count == 0)
+                        run_p = p;
+                    run[run_count++] = glyph.pixels();
+                }
                 const auto advance = glyph.advance();
                 p += advance;
                 width += advance.x();
             }
         }
     }
+    flush_run();
 
     return width;
 }
@@ -86,15 +114,16 @@ void Painter::draw_bitmap(Point p, const Bitmap& bitmap, Color foreground, Color
     if ((background.v == ui::Color::white().v) && (foreground.to_greyscale() > 146))
         foreground = foreground.dark();
 
-    display.draw_bitmap(p, bitmap.size, bitmap.data, foreground, background);
+    if (!clipped_out({p, bitmap.size}))
+        display.draw_bitmap(p, bitmap.size, bitmap.data, foreground, background);
 }
 
 void Painter::draw_hline(Point p, int width, Color c) {
-    display.fill_rectangle({p, {width, 1}}, c);
+    fill_rectangle({p, {width, 1}}, c);
 }
 
 void Painter::draw_vline(Point p, int height, Color c) {
-    display.fill_rectangle({p, {1, height}}, c);
+    fill_rectangle({p, {1, height}}, c);
 }
 
 void Painter::draw_rectangle(Rect r, Color c) {
@@ -105,20 +134,49 @@ void Painter::draw_rectangle(Rect r, Color c) {
 }
 
 void Painter::fill_rectangle(Rect r, Color c) {
-    display.fill_rectangle(r, c);
+    if (clip_) r = r.intersect(clip_);
+    if (r) display.fill_rectangle(r, c);
 }
 
 void Painter::fill_rectangle_unrolled8(Rect r, Color c) {
-    display.fill_rectangle_unrolled8(r, c);
+    if (clip_) r = r.intersect(clip_);
+    if (r) display.fill_rectangle_unrolled8(r, c);
 }
 
 void Painter::paint_widget_tree(Widget* w) {
     if (ui::is_dirty()) {
+        auto& damage = ui::damage_region();
+        if (!damage.empty()) {
+            frame_stats_.damage_rects += damage.size();
+            frame_stats_.damage_pixels += damage.area();
+            for (const auto& r : damage) {
+                paint_damage(w, r);
+            }
+            damage.clear();
+            set_clip({});
+        }
+
         paint_widget(w);
         ui::dirty_clear();
     }
 }
 
+void Painter::end_frame() {
+    const uint32_t pushed = display.pixels_pushed();
+    const uint32_t pixels = pushed - frame_start_pixels_;
+    frame_start_pixels_ = pushed;
+
+    frame_stats_.frames++;
+    frame_stats_.last_pixels = pixels;
+    frame_stats_.peak_pixels = std::max(frame_stats_.peak_pixels, pixels);
+    frame_stats_.total_pixels += pixels;
+}
+
+void Painter::reset_frame_stats() {
+    frame_stats_ = {};
+    frame_start_pixels_ = display.pixels_pushed();
+}
+
 void Painter::paint_widget(Widget* w) {
     if (w->hidden()) {
         // Mark widget (and all children) as invisible.
@@ -144,4 +202,23 @@ void Painter::paint_widget(Widget* w) {
     }
 }
 
+/* Repaints the part of w and its children that falls inside damage, back to
+ * front. Dirty widgets are skipped since paint_widget() repaints them and
+ * everything on them in full right after. */
+void Painter::paint_damage(Widget* w, const Rect& damage) {
+    if (w->hidden() || w->dirty() || !w->visible())
+        return;
+
+    const auto area = w->screen_rect().intersect(damage);
+    if (!area)
+        return;
+
+    set_clip(area);
+    w->paint(*this);
+
+    for (const auto child : w->children()) {
+        paint_damage(child, area);
+    }
+}
+
 } /* namespace ui */
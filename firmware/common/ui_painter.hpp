@@ -65,6 +65,16 @@ class Widget;
 
 class Painter {
    public:
+    /* Pixels sent to the LCD between frame syncs, whoever drew them. */
+    struct FrameStats {
+        uint32_t frames{0};
+        uint32_t last_pixels{0};
+        uint32_t peak_pixels{0};
+        uint64_t total_pixels{0};
+        uint32_t damage_rects{0};   // rectangles repainted by the damage pass
+        uint64_t damage_pixels{0};  // area of those rectangles
+    };
+
     Painter(){};
 
     Painter(const Painter&) = delete;
@@ -86,8 +96,29 @@ class Painter {
     void draw_hline(Point p, int width, Color c);
     void draw_vline(Point p, int height, Color c);
 
+    /* Limits fills and lines to r, and skips glyphs and bitmaps entirely
+     * outside it. An empty rectangle turns clipping off. */
+    void set_clip(const Rect& r) { clip_ = r; }
+    const Rect& clip() const { return clip_; }
+
+    void end_frame();
+    const FrameStats& frame_stats() const { return frame_stats_; }
+    void reset_frame_stats();
+
    private:
+    /* Most glyphs draw_string() hands to the display in one run. */
+    static constexpr size_t max_glyph_run = 64;
+
+    Rect clip_{};
+    FrameStats frame_stats_{};
+    uint32_t frame_start_pixels_{0};
+
+    bool clipped_out(const Rect& r) const {
+        return clip_ && !clip_.intersect(r);
+    }
+
     void paint_widget(Widget* w);
+    void paint_damage(Widget* w, const Rect& damage);
 };
 
 } /* namespace ui */
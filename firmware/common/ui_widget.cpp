@@ -43,6 +43,7 @@ using namespace rtc_time;
 namespace ui {
 
 static bool ui_dirty = true;
+static DamageRegion ui_damage{};
 
 void dirty_set() {
     ui_dirty = true;
@@ -56,6 +57,15 @@ bool is_dirty() {
     return ui_dirty;
 }
 
+void dirty_screen_rect(const Rect& r) {
+    ui_damage.add(r);
+    dirty_set();
+}
+
+DamageRegion& damage_region() {
+    return ui_damage;
+}
+
 /* Widget ****************************************************************/
 
 const std::vector<Widget*> Widget::no_children{};
@@ -77,6 +87,13 @@ Rect Widget::parent_rect() const {
 }
 
 void Widget::set_parent_rect(const Rect new_parent_rect) {
+    const bool covers_old = new_parent_rect.left() <= _parent_rect.left() && new_parent_rect.top() <= _parent_rect.top() &&
+                            new_parent_rect.right() >= _parent_rect.right() && new_parent_rect.bottom() >= _parent_rect.bottom();
+    if (!covers_old && flags.visible && !flags.hidden) {
+        // Uncover what was under the old position.
+        dirty_screen_rect(screen_rect());
+    }
+
     _parent_rect = new_parent_rect;
     set_dirty();
 }
@@ -126,10 +143,10 @@ void Widget::hidden(bool hide) {
 
         // If parent is hidden, either of these is a no-op.
         if (hide) {
-            // TODO: Instead of dirtying parent entirely, dirty only children
-            // that overlap with this widget.
-
-            // parent()->dirty_overlapping_children_in_rect(parent_rect());
+            // Repaint whatever is under this widget, clipped to its area,
+            // rather than dirtying the parent and all its children.
+            if (flags.visible)
+                dirty_screen_rect(screen_rect());
 
             /* TODO: Notify self and all non-hidden children that they're
              * now effectively hidden?
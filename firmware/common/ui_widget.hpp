@@ -26,6 +26,7 @@
 #define __UI_WIDGET_H__
 
 #include "ui.hpp"
+#include "ui_damage_region.hpp"
 #include "ui_text.hpp"
 #include "ui_painter.hpp"
 #include "ui_focus.hpp"
@@ -49,6 +50,11 @@ void dirty_set();
 void dirty_clear();
 bool is_dirty();
 
+/* Queues part of the screen for repainting: whatever is visible there is
+ * repainted, clipped to it, before dirty widgets are painted. */
+void dirty_screen_rect(const Rect& r);
+DamageRegion& damage_region();
+
 class Context {
    public:
     FocusManager& focus_manager() {
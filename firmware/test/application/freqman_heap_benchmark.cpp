@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Load time and heap use of freqman_db against the one allocation per entry
+ * list it replaced. Its own executable, because counting the heap means
+ * replacing the global operator new and delete.
+ */
+
+#include "doctest.h"
+#include "freqman_db.hpp"
+#include "freqman_test_file.hpp"
+#include "mock_file.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+size_t heap_live = 0;
+size_t heap_peak = 0;
+
+/* Keeps max_align_t alignment for the block after the size header. */
+constexpr size_t heap_size_prefix = alignof(std::max_align_t);
+
+void heap_reset_peak() {
+    heap_peak = heap_live;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    auto* p = static_cast<uint8_t*>(std::malloc(size + heap_size_prefix));
+    if (!p)
+        throw std::bad_alloc{};
+    *reinterpret_cast<size_t*>(p) = size;
+    heap_live += size;
+    heap_peak = std::max(heap_peak, heap_live);
+    return p + heap_size_prefix;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr)
+        return;
+    auto* p = static_cast<uint8_t*>(ptr) - heap_size_prefix;
+    heap_live -= *reinterpret_cast<size_t*>(p);
+    std::free(p);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+/* The representation freqman_db replaced: one heap entry per line. */
+size_t load_as_entry_pointers(MockFile& file, std::vector<std::unique_ptr<freqman_entry>>& list) {
+    BufferLineReader<MockFile> reader{file};
+    for (const auto& line : reader) {
+        auto entry = std::make_unique<freqman_entry>();
+        std::string_view view{line};
+        while (!view.empty() && (view.back() == '\n' || view.back() == '\r'))
+            view.remove_suffix(1);
+        if (parse_freqman_entry(view, *entry))
+            list.push_back(std::move(entry));
+    }
+    list.shrink_to_fit();
+    return list.size();
+}
+
+template <typename F>
+double milliseconds(F f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Freqman DB heap");
+
+TEST_CASE("Benchmark: load time and peak heap against one allocation per entry.") {
+    const std::string text = make_freqman_file(3000);
+
+    std::vector<std::unique_ptr<freqman_entry>> old_list;
+    MockFile old_file{text};
+    heap_reset_peak();
+    const auto base_old = heap_live;
+    const double old_ms = milliseconds([&] { load_as_entry_pointers(old_file, old_list); });
+    const auto old_peak = heap_peak - base_old;
+    const auto old_kept = heap_live - base_old;
+
+    freqman_db db;
+    MockFile file{text};
+    heap_reset_peak();
+    const auto base_new = heap_live;
+    const double new_ms = milliseconds([&] { parse_freqman_lines(file, db, {.max_entries = 0}); });
+    const auto new_peak = heap_peak - base_new;
+    const auto new_kept = heap_live - base_new;
+
+    REQUIRE(db.size() == old_list.size());
+    for (size_t i = 0; i < db.size(); i += 97) {
+        CHECK(db.record(i).frequency_a == old_list[i]->frequency_a);
+        CHECK(db.description(i) == old_list[i]->description);
+    }
+
+    MESSAGE("entries: " << db.size());
+    MESSAGE("entry pointers: " << old_ms << " ms, peak " << old_peak << " B, kept " << old_kept << " B");
+    MESSAGE("freqman_db:     " << new_ms << " ms, peak " << new_peak << " B, kept " << new_kept << " B");
+
+    CHECK(new_kept < old_kept);
+    CHECK(new_peak < old_peak);
+}
+
+TEST_SUITE_END();
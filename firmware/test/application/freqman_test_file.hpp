@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FREQMAN_TEST_FILE_H__
+#define __FREQMAN_TEST_FILE_H__
+
+#include <string>
+
+/* A scanner style list: mostly single frequencies, blocks sharing a
+ * description, the odd comment and range. */
+inline std::string make_freqman_file(size_t lines) {
+    std::string text;
+    for (size_t i = 0; i < lines; i++) {
+        if (i % 50 == 0) {
+            text += "# Block " + std::to_string(i / 50) + "\r\n";
+        } else if (i % 17 == 0) {
+            text += "a=" + std::to_string(400'000'000 + i * 1000) + ",b=" + std::to_string(401'000'000 + i * 1000) + ",m=NFM,s=12.5kHz,d=Range " + std::to_string(i) + "\r\n";
+        } else {
+            text += "f=" + std::to_string(145'000'000 + i * 12'500) + ",m=NFM,bw=11k,d=" +
+                    ((i / 10) % 2 ? "Repeater output long name" : "Channel " + std::to_string(i)) + "\r\n";
+        }
+    }
+    return text;
+}
+
+#endif /*__FREQMAN_TEST_FILE_H__*/
@@ -72,9 +72,16 @@ FRESULT f_truncate(FIL*) {
 FRESULT f_unlink(const TCHAR*) {
     return FR_OK;
 }
+FRESULT f_utime(const TCHAR*, const FILINFO*) {
+    return FR_OK;
+}
 FRESULT f_write(FIL*, const void*, UINT, UINT*) {
     return FR_OK;
 }
 
 /* Debug */
 void __debug_log(const std::string&) {}
+
+/* Message queue */
+#include "message_queue.hpp"
+void SPSCMessageQueue::signal() {}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host micro-benchmark for the recent entries on_packet() path.
+ *
+ * Replays a fixed stream of BLE-like packets over a set of device keys
+ * through the old std::list implementation (linear find, copy to the front,
+ * erase) and through RecentEntriesPool, and prints nanoseconds per packet.
+ * Exits non-zero if the pool is slower than the list at any device count.
+ *
+ *     application_benchmark [repeat_count]
+ */
+
+#include "recent_entries_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t entries_max = 64;
+constexpr size_t packet_count = 200000;
+
+/* Roughly the size and shape of BleRecentEntry. */
+struct Entry {
+    using Key = uint64_t;
+
+    Key mac;
+    uint32_t hits{0};
+    uint8_t data[40]{};
+    std::string name{};
+
+    Entry(Key mac)
+        : mac{mac} {}
+
+    Key key() const { return mac; }
+};
+
+using EntryList = std::list<Entry>;
+using EntryPool = RecentEntriesPool<Entry, entries_max>;
+
+/* The on_packet() this container replaced. */
+Entry& list_on_packet(EntryList& entries, const Entry::Key key) {
+    auto it = std::find_if(entries.begin(), entries.end(), [key](const Entry& e) { return e.key() == key; });
+    if (it != entries.end()) {
+        entries.push_front(*it);
+        entries.erase(it);
+    } else {
+        entries.emplace_front(key);
+        while (entries.size() > entries_max)
+            entries.pop_back();
+    }
+    return entries.front();
+}
+
+/* Device keys with a skewed rate: a few chatty devices, many quiet ones. */
+std::vector<Entry::Key> make_stream(const size_t device_count) {
+    std::vector<Entry::Key> stream(packet_count);
+    uint32_t state = 12345;
+    for (auto& key : stream) {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t r = state >> 8;
+        const size_t device = (r & 1) ? (r >> 1) % std::min<size_t>(device_count, 8) : (r >> 1) % device_count;
+        key = 0xc0ffee000000ULL + device * 0x10001ULL;
+    }
+    return stream;
+}
+
+template <typename F>
+double ns_per_packet(const size_t repeat, F f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeat; i++)
+        f();
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (repeat * packet_count);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const size_t repeat = (argc > 1) ? std::max(1, atoi(argv[1])) : 10;
+    bool ok = true;
+    volatile uint32_t sink = 0;
+
+    printf("%8s %12s %12s %8s\n", "devices", "list ns/pkt", "pool ns/pkt", "speedup");
+    for (const size_t device_count : {8, 32, 64, 200}) {
+        const auto stream = make_stream(device_count);
+
+        const double list_ns = ns_per_packet(repeat, [&] {
+            EntryList entries;
+            for (const auto key : stream)
+                sink += ++list_on_packet(entries, key).hits;
+        });
+
+        const double pool_ns = ns_per_packet(repeat, [&] {
+            EntryPool entries;
+            for (const auto key : stream)
+                sink += ++entries.touch(key).hits;
+        });
+
+        printf("%8zu %12.1f %12.1f %7.1fx\n", device_count, list_ns, pool_ns, list_ns / pool_ns);
+        ok &= (pool_ns <= list_ns);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ui_damage_region.hpp"
+
+using namespace ui;
+
+namespace {
+
+bool same(const Rect& a, const Rect& b) {
+    return a.left() == b.left() && a.top() == b.top() &&
+           a.width() == b.width() && a.height() == b.height();
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("DamageRegion");
+
+TEST_CASE("Empty rectangles are ignored.") {
+    DamageRegion region;
+    region.add({10, 10, 0, 5});
+    CHECK(region.empty());
+}
+
+TEST_CASE("Disjoint rectangles are kept apart.") {
+    DamageRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({100, 100, 10, 10});
+    CHECK_EQ(region.size(), 2);
+    CHECK_EQ(region.area(), 200);
+}
+
+TEST_CASE("Touching rectangles in a row are merged.") {
+    DamageRegion region;
+    for (int i = 0; i < 5; i++) {
+        region.add({i * 8, 16, 8, 16});
+    }
+    REQUIRE_EQ(region.size(), 1);
+    CHECK(same(*region.begin(), {0, 16, 40, 16}));
+}
+
+TEST_CASE("Contained rectangles are absorbed.") {
+    DamageRegion region;
+    region.add({0, 0, 100, 100});
+    region.add({10, 10, 5, 5});
+    REQUIRE_EQ(region.size(), 1);
+    CHECK(same(*region.begin(), {0, 0, 100, 100}));
+}
+
+TEST_CASE("Diagonal rectangles don't merge into a large box.") {
+    DamageRegion region;
+    region.add({0, 0, 20, 20});
+    region.add({15, 15, 20, 20});
+    CHECK_EQ(region.size(), 2);
+}
+
+TEST_CASE("A merge that covers another entry swallows it too.") {
+    DamageRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({20, 0, 10, 10});
+    region.add({10, 0, 10, 10});
+    REQUIRE_EQ(region.size(), 1);
+    CHECK(same(*region.begin(), {0, 0, 30, 10}));
+}
+
+TEST_CASE("A full region grows the closest entry.") {
+    DamageRegion region;
+    for (size_t i = 0; i < DamageRegion::capacity; i++) {
+        region.add({static_cast<int>(i) * 30, 0, 10, 10});
+    }
+    CHECK_EQ(region.size(), DamageRegion::capacity);
+
+    region.add({62, 20, 6, 6});
+    CHECK_EQ(region.size(), DamageRegion::capacity);
+
+    bool grown = false;
+    for (const auto& r : region) {
+        if (same(r, {60, 0, 10, 26}))
+            grown = true;
+    }
+    CHECK(grown);
+}
+
+TEST_CASE("Clear empties the region.") {
+    DamageRegion region;
+    region.add({0, 0, 10, 10});
+    region.clear();
+    CHECK(region.empty());
+    CHECK_EQ(region.area(), 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "mock_file.hpp"
+#include "database_index.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr size_t key_length = 7;
+constexpr size_t record_length = 16;
+
+using Index = DatabaseIndex<MockFile>;
+
+/* Zero padded six hex digit keys, every third value, like icao24.db. */
+std::string make_key(size_t i) {
+    char key[key_length + 1]{};
+    snprintf(key, sizeof(key), "%06X", static_cast<unsigned>(i * 3));
+    return key;
+}
+
+std::string make_db(size_t count) {
+    std::string keys;
+    std::string records;
+    for (size_t i = 0; i < count; i++) {
+        keys.append(make_key(i).c_str(), key_length - 1);
+        keys.push_back('\0');
+
+        char record[record_length]{};
+        snprintf(record, sizeof(record), "record %u", static_cast<unsigned>(i));
+        records.append(record, record_length);
+    }
+    return keys + records;
+}
+
+std::string expected_record(size_t i) {
+    return "record " + std::to_string(i);
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("DatabaseIndex");
+
+TEST_CASE("It finds every key in a small database.") {
+    MockFile f{make_db(50)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    for (size_t i = 0; i < 50; i++) {
+        REQUIRE(index.find(make_key(i), record) == Index::Lookup::Found);
+        CHECK_EQ(std::string{record}, expected_record(i));
+    }
+    CHECK_EQ(index.count(), 50);
+    CHECK_EQ(index.stride(), 1);
+}
+
+TEST_CASE("It finds every key in a database larger than the sparse index.") {
+    constexpr size_t count = 20000;
+    MockFile f{make_db(count)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    for (size_t i = 0; i < count; i += 7) {
+        REQUIRE(index.find(make_key(i), record) == Index::Lookup::Found);
+        CHECK_EQ(std::string{record}, expected_record(i));
+    }
+    CHECK(index.stride() > 1);
+    CHECK(index.find(make_key(count - 1), record) == Index::Lookup::Found);
+    CHECK_EQ(std::string{record}, expected_record(count - 1));
+}
+
+TEST_CASE("It reports missing keys.") {
+    constexpr size_t count = 5000;
+    MockFile f{make_db(count)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    CHECK(index.find("000001", record) == Index::Lookup::NotFound);
+    CHECK(index.find("000004", record) == Index::Lookup::NotFound);
+    CHECK(index.find("FFFFFF", record) == Index::Lookup::NotFound);
+    CHECK(index.find(" ", record) == Index::Lookup::NotFound);
+    CHECK(index.find("", record) == Index::Lookup::NotFound);
+    CHECK(index.find("000000000", record) == Index::Lookup::NotFound);
+}
+
+TEST_CASE("It matches on a key prefix.") {
+    MockFile f{make_db(50)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    // 0x1E == 10 * 3
+    CHECK(index.find("00001E", record) == Index::Lookup::Found);
+    CHECK_EQ(std::string{record}, expected_record(10));
+    CHECK(index.find("000000", record) == Index::Lookup::Found);
+}
+
+TEST_CASE("It reads at most a page of keys and one record per lookup.") {
+    constexpr size_t count = 20000;
+    MockFile f{make_db(count)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    index.find(make_key(0), record);
+    for (size_t i = 1; i < count; i += 997) {
+        auto reads = index.reads();
+        REQUIRE(index.find(make_key(i), record) == Index::Lookup::Found);
+        CHECK(index.reads() - reads <= 2);
+    }
+}
+
+TEST_CASE("It answers repeated lookups from the cache.") {
+    MockFile f{make_db(20000)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    REQUIRE(index.find(make_key(1234), record) == Index::Lookup::Found);
+    REQUIRE(index.find("000001", record) == Index::Lookup::NotFound);
+    auto reads = index.reads();
+
+    memset(record, 0, sizeof(record));
+    CHECK(index.find(make_key(1234), record) == Index::Lookup::Found);
+    CHECK_EQ(std::string{record}, expected_record(1234));
+    CHECK(index.find("000001", record) == Index::Lookup::NotFound);
+    CHECK_EQ(index.reads(), reads);
+}
+
+TEST_CASE("It evicts the least recently used cache entry.") {
+    MockFile f{make_db(1000)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    for (size_t i = 0; i < Index::cache_size; i++)
+        index.find(make_key(i), record);
+
+    // Touch key 0 so key 1 is the oldest, then push one more in.
+    index.find(make_key(0), record);
+    index.find(make_key(100), record);
+    auto reads = index.reads();
+
+    index.find(make_key(0), record);
+    CHECK_EQ(index.reads(), reads);
+    index.find(make_key(1), record);
+    CHECK(index.reads() > reads);
+}
+
+TEST_CASE("It reports read errors.") {
+    MockFile f{make_db(1000)};
+    Index index{f, key_length, record_length};
+    char record[record_length]{};
+
+    REQUIRE(index.find(make_key(0), record) == Index::Lookup::Found);
+    f.data_.resize(key_length * 1000);
+    CHECK(index.find(make_key(999), record) == Index::Lookup::ReadError);
+}
+
+TEST_SUITE_END();
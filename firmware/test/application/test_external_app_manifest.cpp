@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "mock_file.hpp"
+#include "external_app_manifest.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using Kind = ExternalAppManifest::Kind;
+using ScanItem = ExternalAppManifest::ScanItem;
+
+std::vector<ScanItem> make_scan(size_t count) {
+    std::vector<ScanItem> scan;
+    for (size_t i = 0; i < count; i++) {
+        std::string name = "app" + std::to_string(i) + ".ppma";
+        scan.push_back({std::filesystem::path{name}, static_cast<uint32_t>(1000 + i), ExternalAppManifest::pack_time(0x5a21, i), Kind::External});
+    }
+    return scan;
+}
+
+/* Fills the header from the file size so tests can tell entries apart. */
+struct HeaderReader {
+    size_t calls{0};
+
+    bool operator()(ExternalAppManifest::Entry& entry) {
+        calls++;
+        entry.record.menu_location = entry.record.file_size % 7;
+        entry.record.icon_color = entry.record.file_size;
+        entry.record.app_name[0] = 'A';
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("ExternalAppManifest");
+
+TEST_CASE("First rebuild reads every header.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    CHECK(manifest.rebuild(make_scan(5), std::ref(reader)));
+    CHECK_EQ(reader.calls, 5);
+    REQUIRE_EQ(manifest.entries().size(), 5);
+    CHECK_EQ(manifest.entries()[3].record.icon_color, 1003);
+    CHECK(manifest.dirty());
+}
+
+TEST_CASE("Unchanged directory reads no headers.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(5), std::ref(reader));
+    reader.calls = 0;
+
+    CHECK_FALSE(manifest.rebuild(make_scan(5), std::ref(reader)));
+    CHECK_EQ(reader.calls, 0);
+    CHECK_EQ(manifest.entries().size(), 5);
+}
+
+TEST_CASE("Only changed, added files are read and removed files are dropped.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(5), std::ref(reader));
+    reader.calls = 0;
+
+    auto scan = make_scan(6);
+    scan.erase(scan.begin());  // app0 removed, app5 added
+    scan[1].file_size = 4000;  // app2 replaced
+    CHECK(manifest.rebuild(scan, std::ref(reader)));
+    CHECK_EQ(reader.calls, 2);
+    REQUIRE_EQ(manifest.entries().size(), 5);
+    CHECK(manifest.entries()[0].file_name == std::filesystem::path{u"app1.ppma"});
+    CHECK_EQ(manifest.entries()[1].record.icon_color, 4000);
+    CHECK(manifest.entries()[4].file_name == std::filesystem::path{u"app5.ppma"});
+}
+
+TEST_CASE("Timestamp change forces a reread.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(3), std::ref(reader));
+    reader.calls = 0;
+
+    auto scan = make_scan(3);
+    scan[2].file_time++;
+    manifest.rebuild(scan, std::ref(reader));
+    CHECK_EQ(reader.calls, 1);
+}
+
+TEST_CASE("Unreadable files are left out.") {
+    ExternalAppManifest manifest;
+    manifest.rebuild(make_scan(4), [](ExternalAppManifest::Entry& entry) {
+        return entry.record.file_size != 1002;
+    });
+    CHECK_EQ(manifest.entries().size(), 3);
+}
+
+TEST_CASE("Save and load round trip.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(4), std::ref(reader));
+    manifest.set_checksum(std::filesystem::path{u"app2.ppma"}, 0x1234);
+
+    MockFile file{""};
+    REQUIRE(manifest.save(file));
+    CHECK_FALSE(manifest.dirty());
+
+    ExternalAppManifest loaded;
+    file.seek(0);
+    REQUIRE(loaded.load(file));
+    REQUIRE_EQ(loaded.entries().size(), 4);
+    CHECK(loaded.entries()[2].file_name == std::filesystem::path{u"app2.ppma"});
+    CHECK_EQ(loaded.entries()[2].record.checksum, 0x1234);
+    CHECK(loaded.entries()[2].record.checksum_known);
+    CHECK_FALSE(loaded.entries()[1].record.checksum_known);
+
+    reader.calls = 0;
+    CHECK_FALSE(loaded.rebuild(make_scan(4), std::ref(reader)));
+    CHECK_EQ(reader.calls, 0);
+}
+
+TEST_CASE("Truncated or foreign cache files are rejected.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(2), std::ref(reader));
+    MockFile file{""};
+    manifest.save(file);
+
+    MockFile truncated{file.data_.substr(0, file.data_.size() - 3)};
+    ExternalAppManifest loaded;
+    CHECK_FALSE(loaded.load(truncated));
+    CHECK(loaded.entries().empty());
+
+    MockFile foreign{"not a manifest at all"};
+    CHECK_FALSE(loaded.load(foreign));
+}
+
+TEST_CASE("A record count larger than the file is rejected.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(2), std::ref(reader));
+    MockFile file{""};
+    manifest.save(file);
+
+    const uint32_t count = 0x40000000;
+    file.data_.replace(2 * sizeof(uint32_t), sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+    file.seek(0);
+
+    ExternalAppManifest loaded;
+    CHECK_FALSE(loaded.load(file));
+    CHECK(loaded.entries().empty());
+}
+
+TEST_CASE("Checksum updates mark the manifest dirty only on change.") {
+    ExternalAppManifest manifest;
+    HeaderReader reader;
+    manifest.rebuild(make_scan(2), std::ref(reader));
+    MockFile file{""};
+    manifest.save(file);
+
+    manifest.set_checksum(std::filesystem::path{u"app1.ppma"}, 0);
+    CHECK(manifest.dirty());
+    manifest.save(file);
+    manifest.set_checksum(std::filesystem::path{u"app1.ppma"}, 0);
+    CHECK_FALSE(manifest.dirty());
+}
+
+TEST_SUITE_END();
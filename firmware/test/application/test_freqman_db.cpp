@@ -21,6 +21,8 @@
 
 #include "doctest.h"
 #include "freqman_db.hpp"
+#include "freqman_test_file.hpp"
+#include "mock_file.hpp"
 
 TEST_SUITE_BEGIN("Freqman Parsing");
 
@@ -133,12 +135,12 @@ TEST_CASE("It can parse frequency step") {
     REQUIRE(
         parse_freqman_entry(
             "f=123000000,d=This is the description.,s=0.1kHz", e));
-    CHECK_EQ(e.step, 0);
+    CHECK_EQ(e.step, 2);
 
     REQUIRE(
         parse_freqman_entry(
             "f=123000000,d=This is the description.,s=50kHz", e));
-    CHECK_EQ(e.step, 11);
+    CHECK_EQ(e.step, 13);
 
     REQUIRE(
         parse_freqman_entry(
@@ -266,3 +268,93 @@ TEST_CASE("It can parse frequency step") {
 */
 
 TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("Freqman DB");
+
+TEST_CASE("It loads every entry line in one pass.") {
+    MockFile file{
+        "# comment\r\n"
+        "f=145500000,m=NFM,bw=11k,d=Calling\r\n"
+        "\n"
+        "a=430000000,b=440000000,d=Range\n"
+        "f=446006250,d=PMR1\n"
+        "garbage\n"
+        "r=145600000,t=145000000,d=Relay"};
+    freqman_db db;
+
+    REQUIRE(parse_freqman_lines(file, db, {.max_entries = 0}));
+    REQUIRE(db.size() == 4);
+
+    CHECK(db.record(0).type == freqman_type::Single);
+    CHECK(db.record(0).frequency_a == 145'500'000);
+    CHECK(db.description(0) == "Calling");
+    CHECK(db.record(1).type == freqman_type::Range);
+    CHECK(db.record(1).frequency_b == 440'000'000);
+    CHECK(db.description(3) == "Relay");
+
+    // Modulation and bandwidth carry over from the entry before.
+    CHECK(db.record(2).modulation == db.record(0).modulation);
+    CHECK(db.record(2).bandwidth == db.record(0).bandwidth);
+}
+
+TEST_CASE("It applies the type filters and the entry limit.") {
+    const std::string text = make_freqman_file(400);
+    freqman_db db;
+
+    MockFile all{text};
+    REQUIRE(parse_freqman_lines(all, db, {.max_entries = 0}));
+    const auto total = db.size();
+
+    MockFile limited{text};
+    REQUIRE(parse_freqman_lines(limited, db, {.max_entries = 25}));
+    CHECK(db.size() == 25);
+
+    MockFile no_ranges{text};
+    REQUIRE(parse_freqman_lines(no_ranges, db, {.max_entries = 0, .load_ranges = false}));
+    CHECK(db.size() < total);
+    for (size_t i = 0; i < db.size(); i++)
+        CHECK(db.record(i).type != freqman_type::Range);
+}
+
+TEST_CASE("Repeated descriptions are stored once.") {
+    freqman_db db;
+    freqman_entry entry{.frequency_a = 1'000'000, .description = "Shared", .type = freqman_type::Single};
+
+    db.push_back(entry);
+    const auto used = db.memory_used();
+    for (int i = 0; i < 10; i++)
+        db.push_back(entry);
+
+    CHECK(db.record(10).description_offset == db.record(0).description_offset);
+    CHECK(db.description(10) == "Shared");
+
+    entry.description = "";
+    db.push_back(entry);
+    CHECK(db.description(11).empty());
+    CHECK(db.memory_used() >= used);
+}
+
+TEST_CASE("Entries can be unpacked, replaced and erased.") {
+    freqman_db db;
+    db.push_back({.frequency_a = 1, .description = "one", .type = freqman_type::Single});
+    db.push_back({.frequency_a = 2, .description = "two", .type = freqman_type::Single});
+    db.push_back({.frequency_a = 3, .description = "three", .type = freqman_type::Single});
+
+    db.set(1, {.frequency_a = 20, .frequency_b = 30, .description = "twenty", .type = freqman_type::Range, .step = 3});
+    auto entry = db.entry(1);
+    CHECK(entry.frequency_a == 20);
+    CHECK(entry.frequency_b == 30);
+    CHECK(entry.description == "twenty");
+    CHECK(entry.type == freqman_type::Range);
+    CHECK(entry.step == 3);
+
+    db.erase(0);
+    REQUIRE(db.size() == 2);
+    CHECK(db.description(0) == "twenty");
+    CHECK(db.entry(1).description == "three");
+
+    db.clear();
+    CHECK(db.empty());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "freqman_index.hpp"
+#include "mock_file.hpp"
+#include "string_format.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+using Index = FreqmanIndex<MockFile>;
+
+constexpr uint32_t timestamp = 0x5A2B6C00;
+
+std::string make_text(size_t count) {
+    std::string text;
+    for (size_t i = 0; i < count; i++) {
+        const auto n = std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                text += "f=" + std::to_string(100000000 + i * 12500) + ",m=NFM,bw=16k,d=Channel " + n + "\n";
+                break;
+            case 1:
+                text += "a=" + std::to_string(88000000 + i) + ",b=108000000,m=WFM,bw=200k,s=100kHz,d= Range " + n + " \n";
+                break;
+            case 2:
+                text += "r=" + std::to_string(145000000 + i) + ",t=144400000,m=NFM,bw=11k,c=67.0\n";
+                break;
+            default:
+                text += "# comment " + n + "\n";
+                break;
+        }
+    }
+    return text;
+}
+
+/* The description as FreqmanDB reads it back from the text. */
+std::string description(const std::string& text, const freqman_index_record& record) {
+    return text.substr(record.offset + record.description_column, record.description_length);
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Freqman Index");
+
+TEST_CASE("It indexes every line with its offset and parsed fields.") {
+    const auto text = make_text(100);
+    MockFile source{text};
+    MockFile file{""};
+    Index index{file};
+
+    REQUIRE(index.build(source, timestamp));
+    REQUIRE_EQ(index.count(), 100);
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < index.count(); i++) {
+        const auto end = text.find('\n', offset) + 1;
+        const std::string line = text.substr(offset, end - offset);
+
+        freqman_index_record record{};
+        REQUIRE(index.read(i, record));
+        CHECK_EQ(record.offset, offset);
+        CHECK_EQ(record.length, line.size());
+
+        freqman_entry entry{};
+        const bool parsed = parse_freqman_entry(line, entry);
+        REQUIRE_EQ(record.parsed(), parsed);
+        if (parsed) {
+            CHECK(record.type == entry.type);
+            CHECK_EQ(record.frequency_a, entry.frequency_a);
+            CHECK_EQ(record.frequency_b, entry.frequency_b);
+            CHECK_EQ(record.modulation, entry.modulation);
+            CHECK_EQ(record.bandwidth, entry.bandwidth);
+            CHECK_EQ(record.step, entry.step);
+            CHECK_EQ(record.tone, entry.tone);
+            CHECK_EQ(description(text, record), entry.description);
+        } else {
+            CHECK_EQ(description(text, record), trim(line));
+        }
+
+        offset = end;
+    }
+}
+
+TEST_CASE("It indexes a last line without a newline and long lines.") {
+    const std::string long_line = "f=100000000,d=Long " + std::string(108, 'x') + "\n";
+    REQUIRE(long_line.size() == 128);
+    const std::string text = long_line + long_line + "f=200000000,d=Last";
+    MockFile source{text};
+    MockFile file{""};
+    Index index{file};
+
+    REQUIRE(index.build(source, timestamp));
+    REQUIRE_EQ(index.count(), 3);
+
+    freqman_index_record record{};
+    REQUIRE(index.read(1, record));
+    CHECK_EQ(record.offset, 128);
+    CHECK_EQ(record.description_length, freqman_max_desc_size);
+
+    REQUIRE(index.read(2, record));
+    CHECK_EQ(record.offset, 256);
+    CHECK_EQ(record.frequency_a, 200000000);
+    CHECK_EQ(description(text, record), "Last");
+    CHECK_FALSE(index.read(3, record));
+}
+
+TEST_CASE("It indexes an empty file as no lines.") {
+    MockFile source{""};
+    MockFile file{""};
+    Index index{file};
+
+    REQUIRE(index.build(source, timestamp));
+    CHECK(index.valid());
+    CHECK_EQ(index.count(), 0);
+}
+
+TEST_CASE("It only loads an index built from the same text.") {
+    const auto text = make_text(40);
+    MockFile source{text};
+    MockFile file{""};
+
+    {
+        Index index{file};
+        REQUIRE(index.build(source, timestamp));
+    }
+
+    Index index{file};
+    CHECK(index.load(text.size(), timestamp));
+    CHECK_EQ(index.count(), 40);
+
+    CHECK_FALSE(index.load(text.size() + 1, timestamp));
+    CHECK_FALSE(index.load(text.size(), timestamp + 1));
+    CHECK_EQ(index.count(), 0);
+
+    // Truncated index.
+    file.data_.resize(file.data_.size() - 1);
+    CHECK_FALSE(index.load(text.size(), timestamp));
+
+    MockFile garbage{std::string(100, 'x')};
+    Index other{garbage};
+    CHECK_FALSE(other.load(text.size(), timestamp));
+}
+
+TEST_CASE("A rebuild replaces a longer index.") {
+    MockFile long_source{make_text(50)};
+    MockFile file{""};
+    Index index{file};
+    REQUIRE(index.build(long_source, timestamp));
+
+    const auto text = make_text(10);
+    MockFile source{text};
+    REQUIRE(index.build(source, timestamp + 2));
+    CHECK_EQ(index.count(), 10);
+    CHECK_EQ(file.data_.size(), sizeof(freqman_index_header) + 10 * sizeof(freqman_index_record));
+    CHECK(Index{file}.load(text.size(), timestamp + 2));
+}
+
+TEST_CASE("An append only rewrites the tail and the header.") {
+    const auto text = make_text(50);
+    MockFile source{text};
+    MockFile file{""};
+    Index index{file};
+    REQUIRE(index.build(source, timestamp));
+
+    // Mark a record the update mustn't touch.
+    const auto marked = sizeof(freqman_index_header) + 10 * sizeof(freqman_index_record) + offsetof(freqman_index_record, reserved);
+    file.data_[marked] = 0x5A;
+
+    const auto appended = make_text(52);
+    MockFile appended_source{appended};
+    REQUIRE(index.update(appended_source, 49, timestamp + 2));
+    CHECK_EQ(index.count(), 52);
+    CHECK_EQ(static_cast<uint8_t>(file.data_[marked]), 0x5A);
+
+    MockFile rebuilt{""};
+    REQUIRE(Index{rebuilt}.build(appended_source, timestamp + 2));
+    file.data_[marked] = rebuilt.data_[marked];
+    CHECK(file.data_ == rebuilt.data_);
+    CHECK(Index{file}.load(appended.size(), timestamp + 2));
+}
+
+TEST_CASE("An update drops records past a shortened tail.") {
+    MockFile source{make_text(20)};
+    MockFile file{""};
+    Index index{file};
+    REQUIRE(index.build(source, timestamp));
+
+    const auto text = make_text(18);
+    MockFile shortened{text};
+    REQUIRE(index.update(shortened, 17, timestamp + 2));
+    CHECK_EQ(index.count(), 18);
+    CHECK_EQ(file.data_.size(), sizeof(freqman_index_header) + 18 * sizeof(freqman_index_record));
+    CHECK(Index{file}.load(text.size(), timestamp + 2));
+
+    CHECK_FALSE(index.update(shortened, 19, timestamp + 2));
+}
+
+TEST_CASE("Reads are served from the current window.") {
+    MockFile source{make_text(100)};
+    MockFile file{""};
+    Index index{file};
+    REQUIRE(index.build(source, timestamp));
+
+    freqman_index_record record{};
+    REQUIRE(index.read(Index::window_size + 1, record));
+
+    // Records in the same window no longer need the file.
+    auto data = std::move(file.data_);
+    file.data_.clear();
+    for (uint32_t i = Index::window_size; i < Index::window_size * 2; i++)
+        CHECK(index.read(i, record));
+
+    file.data_ = std::move(data);
+    REQUIRE(index.read(99, record));
+    CHECK_EQ(record.offset, make_text(99).size());
+}
+
+TEST_SUITE_END();
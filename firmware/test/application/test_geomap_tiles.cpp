@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ui/ui_geomap_tiles.hpp"
+
+#include <vector>
+
+using namespace ui;
+
+namespace {
+
+void put16(std::vector<uint8_t>& v, uint16_t x) {
+    v.push_back(x & 0xff);
+    v.push_back(x >> 8);
+}
+
+void put32(std::vector<uint8_t>& v, uint32_t x) {
+    put16(v, x & 0xffff);
+    put16(v, x >> 16);
+}
+
+/* Header for a 100x70 map with three levels, as the generator writes it. */
+std::vector<uint8_t> header() {
+    std::vector<uint8_t> v{'P', 'P', 'M', 'T'};
+    put16(v, 1);
+    put16(v, 16);
+    put16(v, 3);
+    put16(v, 0);
+    put16(v, 100);
+    put16(v, 70);
+    put16(v, 7);
+    put16(v, 5);
+    put32(v, 512);
+    put16(v, 50);
+    put16(v, 35);
+    put16(v, 4);
+    put16(v, 3);
+    put32(v, 18432);
+    put16(v, 25);
+    put16(v, 17);
+    put16(v, 2);
+    put16(v, 2);
+    put32(v, 24576);
+    return v;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("GeoMap tiles");
+
+TEST_CASE("A generated header parses.") {
+    const auto h = header();
+    MapTileIndex index;
+    REQUIRE(index.parse(h.data(), h.size()));
+    CHECK(index.levels() == 3);
+    CHECK(index.level(0).width == 100);
+    CHECK(index.level(2).tiles_y == 2);
+}
+
+TEST_CASE("Bad magic, tile size or a short level table are rejected.") {
+    MapTileIndex index;
+
+    auto h = header();
+    h[0] = 'X';
+    CHECK_FALSE(index.parse(h.data(), h.size()));
+
+    h = header();
+    h[6] = 32;
+    CHECK_FALSE(index.parse(h.data(), h.size()));
+
+    h = header();
+    CHECK_FALSE(index.parse(h.data(), h.size() - 1));
+    CHECK(index.levels() == 0);
+}
+
+TEST_CASE("Tiles are stored row major per level.") {
+    const auto h = header();
+    MapTileIndex index;
+    REQUIRE(index.parse(h.data(), h.size()));
+
+    CHECK(index.tile_offset({0, 0, 0}) == 512);
+    CHECK(index.tile_offset({0, 1, 0}) == 512 + 512);
+    CHECK(index.tile_offset({0, 0, 1}) == 512 + 7 * 512);
+    CHECK(index.tile_offset({1, 3, 2}) == 18432 + (2 * 4 + 3) * 512);
+}
+
+TEST_CASE("Zoom out picks the first level at least as coarse.") {
+    const auto h = header();
+    MapTileIndex index;
+    REQUIRE(index.parse(h.data(), h.size()));
+
+    CHECK(index.level_for_zoom_out(1) == 0);
+    CHECK(index.level_for_zoom_out(2) == 1);
+    CHECK(index.level_for_zoom_out(3) == 2);
+    // Clamped to the coarsest level in the file.
+    CHECK(index.level_for_zoom_out(10) == 2);
+}
+
+TEST_CASE("The tile cache loads once and evicts the least recently used.") {
+    MapTileCache cache;
+    size_t loads = 0;
+    auto load = [&loads](const MapTileKey key, Color* dst) {
+        loads++;
+        dst[0] = Color{static_cast<uint16_t>(key.tx)};
+        return true;
+    };
+
+    for (uint16_t tx = 0; tx < MapTileCache::capacity; tx++) {
+        CHECK(cache.get({0, tx, 0}, load)[0].v == tx);
+    }
+    CHECK(loads == MapTileCache::capacity);
+
+    // Touch tile 0 so tile 1 becomes the oldest.
+    CHECK(cache.get({0, 0, 0}, load)[0].v == 0);
+    CHECK(loads == MapTileCache::capacity);
+
+    cache.get({1, 0, 0}, load);
+    CHECK(loads == MapTileCache::capacity + 1);
+    cache.get({0, 0, 0}, load);
+    CHECK(loads == MapTileCache::capacity + 1);
+    cache.get({0, 1, 0}, load);
+    CHECK(loads == MapTileCache::capacity + 2);
+}
+
+TEST_CASE("A failed load is not cached.") {
+    MapTileCache cache;
+    bool ok = false;
+    auto load = [&ok](const MapTileKey, Color*) { return ok; };
+
+    CHECK(cache.get({0, 5, 5}, load) == nullptr);
+    ok = true;
+    CHECK(cache.get({0, 5, 5}, load) != nullptr);
+    CHECK(cache.misses() == 2);
+    CHECK(cache.hits() == 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ui_glyph_run.hpp"
+
+#include <vector>
+
+using namespace ui;
+
+namespace {
+
+/* The plain bit by bit expansion draw_bitmap() does. */
+Color reference_pixel(const std::vector<uint8_t>& pixels, size_t w, size_t x, size_t y, Color fg, Color bg) {
+    const size_t i = y * w + x;
+    return (pixels[i >> 3] & (1U << (i & 7))) ? fg : bg;
+}
+
+std::vector<uint8_t> pattern(size_t w, size_t h) {
+    std::vector<uint8_t> pixels((w * h + 7) / 8);
+    uint32_t state = 0x12345678;
+    for (auto& b : pixels) {
+        state = state * 1664525 + 1013904223;
+        b = state >> 24;
+    }
+    return pixels;
+}
+
+bool rows_match(size_t w, size_t h) {
+    const Color fg{0xf800};
+    const Color bg{0x001f};
+    const auto pixels = pattern(w, h);
+
+    GlyphRowExpander expander;
+    expander.set_colors(fg, bg);
+
+    std::vector<Color> row(w);
+    for (size_t y = 0; y < h; y++) {
+        expander.expand_row(pixels.data(), w, y, row.data());
+        for (size_t x = 0; x < w; x++) {
+            if (row[x].v != reference_pixel(pixels, w, x, y, fg, bg).v)
+                return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("GlyphRowExpander");
+
+TEST_CASE("Byte aligned 8x16 rows match the bitwise expansion.") {
+    CHECK(rows_match(8, 16));
+}
+
+TEST_CASE("5x8 rows starting mid byte match the bitwise expansion.") {
+    CHECK(rows_match(5, 8));
+}
+
+TEST_CASE("Other widths up to the maximum match the bitwise expansion.") {
+    for (size_t w = 1; w <= GlyphRowExpander::max_glyph_width; w++) {
+        CAPTURE(w);
+        CHECK(rows_match(w, 16));
+    }
+}
+
+TEST_CASE("Changing colours rebuilds the patterns.") {
+    const uint8_t all_on[2] = {0xff, 0xff};
+    GlyphRowExpander expander;
+    Color row[8];
+
+    expander.set_colors(Color{1}, Color{2});
+    expander.expand_row(all_on, 8, 0, row);
+    CHECK(row[0].v == 1);
+
+    expander.set_colors(Color{3}, Color{2});
+    expander.expand_row(all_on, 8, 0, row);
+    CHECK(row[0].v == 3);
+    CHECK(row[7].v == 3);
+}
+
+TEST_SUITE_END();
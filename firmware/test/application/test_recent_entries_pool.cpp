@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "recent_entries_pool.hpp"
+
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TestEntry {
+    using Key = uint32_t;
+
+    Key id;
+    size_t hits{0};
+    std::string name{};
+
+    TestEntry(Key id)
+        : id{id} {}
+
+    Key key() const { return id; }
+};
+
+struct PairEntry {
+    using Key = std::pair<uint8_t, uint32_t>;
+
+    Key id;
+
+    PairEntry(const Key& id)
+        : id{id} {}
+
+    Key key() const { return id; }
+};
+
+template <typename Entries>
+std::vector<uint32_t> keys_of(const Entries& entries) {
+    std::vector<uint32_t> keys;
+    for (const auto& e : entries)
+        keys.push_back(e.key());
+    return keys;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("RecentEntriesPool");
+
+TEST_CASE("touch() inserts new keys at the front.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    entries.touch(1);
+    entries.touch(2);
+    entries.touch(3);
+
+    CHECK_EQ(entries.size(), 3);
+    CHECK_EQ(keys_of(entries), std::vector<uint32_t>{3, 2, 1});
+    CHECK_EQ(entries.front().key(), 3);
+    CHECK_EQ(entries.back().key(), 1);
+}
+
+TEST_CASE("touch() moves an existing entry to the front in place.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    entries.touch(1).hits = 5;
+    entries.touch(2);
+    entries.touch(3);
+
+    auto& entry = entries.touch(1);
+    CHECK_EQ(entry.hits, 5);
+    CHECK_EQ(&entry, &entries.front());
+    CHECK_EQ(entries.size(), 3);
+    CHECK_EQ(keys_of(entries), std::vector<uint32_t>{1, 3, 2});
+}
+
+TEST_CASE("find() returns end() for missing keys.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    CHECK(entries.find(1) == entries.end());
+
+    entries.touch(1);
+    CHECK(entries.find(1) != entries.end());
+    CHECK_EQ(entries.find(1)->key(), 1);
+    CHECK(entries.find(2) == entries.end());
+}
+
+TEST_CASE("A full pool evicts the least recently used entry.") {
+    RecentEntriesPool<TestEntry, 4> entries;
+    for (uint32_t k = 1; k <= 4; k++)
+        entries.touch(k);
+    entries.touch(1);
+    entries.touch(5);
+
+    CHECK_EQ(entries.size(), 4);
+    CHECK_EQ(keys_of(entries), std::vector<uint32_t>{5, 1, 4, 3});
+    CHECK(entries.find(2) == entries.end());
+}
+
+TEST_CASE("References stay valid while other entries come and go.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    auto& kept = entries.touch(42);
+    kept.name = "kept";
+    for (uint32_t k = 0; k < 6; k++)
+        entries.touch(k);
+    entries.erase(entries.find(3));
+    entries.sort([](const auto& a, const auto& b) { return a.key() < b.key(); });
+
+    CHECK_EQ(&*entries.find(42), &kept);
+    CHECK_EQ(kept.name, "kept");
+}
+
+TEST_CASE("It iterates in both directions.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    for (uint32_t k = 1; k <= 4; k++)
+        entries.push_back(TestEntry{k});
+
+    std::vector<uint32_t> reversed;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+        reversed.push_back(it->key());
+    CHECK_EQ(reversed, std::vector<uint32_t>{4, 3, 2, 1});
+
+    auto it = entries.end();
+    --it;
+    CHECK_EQ(it->key(), 4);
+}
+
+TEST_CASE("It erases ranges from the back like remove_expired_entries().") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    for (uint32_t k = 1; k <= 6; k++)
+        entries.push_back(TestEntry{k});
+
+    auto it = entries.rbegin();
+    while (it != entries.rend() && it->key() > 3)
+        ++it;
+    entries.erase(it.base(), entries.end());
+
+    CHECK_EQ(keys_of(entries), std::vector<uint32_t>{1, 2, 3});
+    CHECK(entries.find(5) == entries.end());
+}
+
+TEST_CASE("sort() is stable.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    for (uint32_t k = 1; k <= 6; k++)
+        entries.emplace_back(k).hits = k % 2;
+
+    entries.sort([](const auto& a, const auto& b) { return a.hits < b.hits; });
+    CHECK_EQ(keys_of(entries), std::vector<uint32_t>{2, 4, 6, 1, 3, 5});
+    CHECK_EQ(entries.find(4)->key(), 4);
+}
+
+TEST_CASE("An older entry with a duplicate key is found again after the newer one is erased.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    entries.touch(1).hits = 1;
+    entries.push_front(TestEntry{1});
+
+    CHECK_EQ(entries.find(1)->hits, 0);
+    entries.pop_front();
+    REQUIRE(entries.find(1) != entries.end());
+    CHECK_EQ(entries.find(1)->hits, 1);
+}
+
+TEST_CASE("It hashes pair keys.") {
+    RecentEntriesPool<PairEntry, 8> entries;
+    entries.touch({1, 100});
+    entries.touch({2, 100});
+
+    CHECK(entries.find({1, 100}) != entries.end());
+    CHECK(entries.find({2, 100}) != entries.end());
+    CHECK(entries.find({3, 100}) == entries.end());
+}
+
+TEST_CASE("Copies are independent.") {
+    RecentEntriesPool<TestEntry, 8> entries;
+    for (uint32_t k = 1; k <= 3; k++)
+        entries.touch(k);
+
+    auto copy = entries;
+    entries.clear();
+    CHECK(entries.empty());
+    CHECK_EQ(keys_of(copy), std::vector<uint32_t>{3, 2, 1});
+    CHECK(copy.find(2) != copy.end());
+}
+
+TEST_CASE("It matches std::list over a random packet stream.") {
+    RecentEntriesPool<TestEntry, 16> entries;
+    std::list<uint32_t> model;
+    uint32_t state = 1;
+
+    for (size_t i = 0; i < 20000; i++) {
+        state = state * 1664525u + 1013904223u;
+        const uint32_t key = (state >> 16) % 40;
+        const uint32_t op = (state >> 8) & 0x0f;
+
+        if (op == 0 && !model.empty()) {
+            // Erase from the middle.
+            const uint32_t victim = *std::next(model.begin(), model.size() / 2);
+            model.remove(victim);
+            entries.erase(entries.find(victim));
+        } else {
+            model.remove(key);
+            model.push_front(key);
+            if (model.size() > 16)
+                model.pop_back();
+            entries.touch(key);
+        }
+
+        REQUIRE_EQ(keys_of(entries), std::vector<uint32_t>{model.begin(), model.end()});
+        for (uint32_t k = 0; k < 40; k++) {
+            const bool present = std::find(model.begin(), model.end(), k) != model.end();
+            REQUIRE_EQ(entries.find(k) != entries.end(), present);
+        }
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2023 Kyle Reed
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "recon_fast_scan.hpp"
+
+namespace {
+
+constexpr uint32_t sampling_rate = 4'000'000;
+constexpr int64_t channel_width = sampling_rate / ReconFastScan::channel_count;
+
+freqman_db make_db(std::initializer_list<std::string_view> lines) {
+    freqman_db db;
+    for (const auto line : lines) {
+        freqman_entry entry{};
+        REQUIRE(parse_freqman_entry(line, entry));
+        db.push_back(entry);
+    }
+    return db;
+}
+
+ChannelizerActivityMessage activity(std::initializer_list<size_t> open_channels) {
+    ChannelizerActivityMessage message{};
+    message.sampling_rate = sampling_rate;
+    message.power_db.fill(-100);
+    for (const auto channel : open_channels) {
+        message.open_mask |= uint64_t{1} << channel;
+        message.power_db[channel] = -20;
+    }
+    return message;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Recon fast scan");
+
+TEST_CASE("Entries inside one capture share a cluster.") {
+    auto db = make_db({
+        "f=446006250,d=PMR1",
+        "a=430000000,b=440000000,d=Range",
+        "f=446018750,d=PMR2",
+        "f=446093750,d=PMR8",
+        "f=145500000,d=Calling",
+        "l=439000000,t=431400000,d=Repeater",
+    });
+
+    ReconFastScan scan;
+    scan.build(db, sampling_rate);
+
+    // 145.5, 439.0 and the three PMR channels; the range is left out.
+    REQUIRE(scan.size() == 3);
+    CHECK(scan.current().count == 1);
+    CHECK(scan.members()[scan.current().first].index == 4);
+
+    scan.next();
+    CHECK(scan.current().count == 1);
+    CHECK(scan.members()[scan.current().first].index == 5);
+
+    // PMR1 and PMR2 share a channel and are left to the stepping.
+    scan.next();
+    REQUIRE(scan.current().count == 1);
+    CHECK(scan.members()[scan.current().first].index == 3);
+    CHECK(scan.current().center == (446006250 + 446093750) / 2);
+
+    CHECK(scan.next());
+    CHECK(scan.position() == 0);
+
+    CHECK(scan.covered_count() == 3);
+    CHECK_FALSE(scan.covers(0));
+    CHECK_FALSE(scan.covers(1));
+    CHECK_FALSE(scan.covers(2));
+    CHECK(scan.covers(3));
+    CHECK(scan.covers(4));
+    CHECK(scan.covers(5));
+}
+
+TEST_CASE("No entry is tuned onto the DC channel.") {
+    auto db = make_db({
+        "f=145500000",
+        "f=433000000",
+        "f=433500000",
+        "f=434000000",
+    });
+
+    ReconFastScan scan;
+    scan.build(db, sampling_rate);
+
+    REQUIRE(scan.size() == 2);
+    CHECK(scan.current().center == 145500000 + channel_width);
+    CHECK(scan.covered_count() == 4);
+    for (const auto& member : scan.members()) {
+        CHECK(member.channel != ChannelizerActivityMessage::dc_channel);
+    }
+}
+
+TEST_CASE("Clusters are kept until invalidated.") {
+    auto db = make_db({"f=446006250"});
+    ReconFastScan scan;
+    CHECK_FALSE(scan.valid());
+    scan.build(db, sampling_rate);
+    CHECK(scan.valid());
+    scan.invalidate();
+    CHECK_FALSE(scan.valid());
+}
+
+TEST_CASE("Cluster members stay clear of the capture edges.") {
+    auto db = make_db({
+        "f=100000000",
+        "f=101000000",
+        "f=102000000",
+        "f=103000000",
+        "f=104000000",
+    });
+
+    ReconFastScan scan;
+    scan.build(db, sampling_rate);
+
+    REQUIRE(scan.size() == 2);
+    CHECK(scan.current().count == 4);
+    for (const auto& member : scan.members()) {
+        CHECK(member.channel >= ReconFastScan::guard_channels);
+        CHECK(member.channel < ReconFastScan::channel_count - ReconFastScan::guard_channels);
+    }
+
+    // Entries land on the channel nearest their offset from the center.
+    const auto& first = scan.members()[0];
+    CHECK((first.channel - 32) * channel_width == doctest::Approx(100000000 - scan.current().center).epsilon(0.02));
+}
+
+TEST_CASE("An entry locks after nb_match consecutive opens.") {
+    auto db = make_db({"f=446006250", "f=446506250"});
+    ReconFastScan scan;
+    scan.build(db, sampling_rate);
+    REQUIRE(scan.size() == 1);
+
+    const auto& members = scan.members();
+    const size_t second = members[1].channel;
+
+    CHECK(scan.on_activity(activity({second}), 3, true) == -1);
+    CHECK(scan.on_activity(activity({second}), 3, true) == -1);
+    CHECK(scan.on_activity(activity({}), 3, true) == -1);
+    CHECK(members[1].matches == 0);
+
+    CHECK(scan.on_activity(activity({second}), 3, true) == -1);
+    CHECK(scan.on_activity(activity({second}), 3, true) == -1);
+    CHECK(scan.on_activity(activity({second}), 3, true) == 1);
+    CHECK(scan.peak_db(activity({second})) == -20);
+}
+
+TEST_CASE("Sparse matching keeps counts across closed reports.") {
+    auto db = make_db({"f=446006250"});
+    ReconFastScan scan;
+    scan.build(db, sampling_rate);
+    const size_t channel = scan.members()[0].channel;
+
+    CHECK(scan.on_activity(activity({channel}), 2, false) == -1);
+    CHECK(scan.on_activity(activity({}), 2, false) == -1);
+    CHECK(scan.on_activity(activity({channel}), 2, false) == 0);
+
+    scan.next();
+    CHECK(scan.members()[0].matches == 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ui/ui_spectrum_bins.hpp"
+
+using namespace ui::spectrum;
+
+namespace {
+
+using BinMap = SpectrumBinMap<256, 320>;
+
+/* Bin value equal to its shifted (low to high frequency) position. */
+std::array<uint8_t, 256> ramp() {
+    std::array<uint8_t, 256> db{};
+    for (size_t i = 0; i < 256; i++) {
+        db[(i + 128) % 256] = i;
+    }
+    return db;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("SpectrumBinMap");
+
+TEST_CASE("Crop keeps the centre bins, one per column.") {
+    BinMap map;
+    map.configure(BinReducer::Crop, 240);
+    REQUIRE(map.width() == 240);
+
+    std::array<uint8_t, 320> out{};
+    map.reduce(ramp(), out.data());
+    for (size_t c = 0; c < 240; c++) {
+        CHECK(out[c] == c + 8);
+    }
+}
+
+TEST_CASE("Crop matches the original 240 column layout.") {
+    std::array<uint8_t, 256> db{};
+    for (size_t i = 0; i < 256; i++) {
+        db[i] = i;
+    }
+
+    BinMap map;
+    map.configure(BinReducer::Crop, 240);
+    std::array<uint8_t, 320> out{};
+    map.reduce(db, out.data());
+    for (size_t c = 0; c < 120; c++) {
+        CHECK(out[c] == db[256 - 120 + c]);
+        CHECK(out[c + 120] == db[c]);
+    }
+}
+
+TEST_CASE("Decimate spans the whole band.") {
+    BinMap map;
+    map.configure(BinReducer::Decimate, 128);
+
+    std::array<uint8_t, 320> out{};
+    map.reduce(ramp(), out.data());
+    for (size_t c = 0; c < 128; c++) {
+        CHECK(out[c] == c * 2);
+    }
+}
+
+TEST_CASE("MaxPool keeps a narrow peak that decimation drops.") {
+    std::array<uint8_t, 256> db{};
+    db[(1 + 128) % 256] = 200;
+
+    BinMap map;
+    std::array<uint8_t, 320> out{};
+
+    map.configure(BinReducer::Decimate, 128);
+    map.reduce(db, out.data());
+    CHECK(out[0] == 0);
+
+    map.configure(BinReducer::MaxPool, 128);
+    map.reduce(db, out.data());
+    CHECK(out[0] == 200);
+    for (size_t c = 1; c < 128; c++) {
+        CHECK(out[c] == 0);
+    }
+}
+
+TEST_CASE("Widths beyond the bin count stretch the band.") {
+    BinMap map;
+    map.configure(BinReducer::MaxPool, 320);
+    REQUIRE(map.width() == 320);
+
+    std::array<uint8_t, 320> out{};
+    map.reduce(ramp(), out.data());
+    CHECK(out[0] == 0);
+    CHECK(out[319] == 255);
+    for (size_t c = 1; c < 320; c++) {
+        CHECK(out[c] >= out[c - 1]);
+    }
+}
+
+TEST_CASE("Width is clamped to the maximum.") {
+    BinMap map;
+    map.configure(BinReducer::Crop, 400);
+    CHECK(map.width() == 320);
+}
+
+TEST_CASE("A zero width maps no columns.") {
+    BinMap map;
+    map.configure(BinReducer::MaxPool, 0);
+    CHECK(map.width() == 0);
+
+    std::array<uint8_t, 1> out{42};
+    map.reduce(ramp(), out.data());
+    CHECK(out[0] == 42);
+}
+
+TEST_SUITE_END();
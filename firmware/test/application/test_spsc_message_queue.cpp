@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+
+#include "ch.h"
+/* The host has no interrupts to mask around the producer's copy. */
+#undef chSysLock
+#define chSysLock()
+#undef chSysUnlock
+#define chSysUnlock()
+
+#include "message_queue.hpp"
+
+#include <vector>
+
+namespace {
+
+/* 64 bytes: five AudioLevelReport records (12 bytes each) fill all but 4. */
+constexpr size_t queue_k = 6;
+
+struct Queue {
+    alignas(4) uint8_t data[1 << queue_k]{};
+    SPSCMessageQueue queue{data, queue_k};
+};
+
+AudioLevelReportMessage level(const uint32_t value) {
+    AudioLevelReportMessage message{};
+    message.value = value;
+    return message;
+}
+
+uint32_t level_of(const Message* const message) {
+    REQUIRE(message != nullptr);
+    REQUIRE(message->id == Message::ID::AudioLevelReport);
+    return static_cast<const AudioLevelReportMessage*>(message)->value;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("SPSCMessageQueue");
+
+TEST_CASE("Messages of different sizes are read back in order.") {
+    Queue q;
+    TXProgressMessage progress{};
+    progress.progress = 1234;
+    progress.done = true;
+
+    REQUIRE(q.queue.push(DisplayFrameSyncMessage{}));
+    REQUIRE(q.queue.push(level(7)));
+    REQUIRE(q.queue.push(progress));
+    REQUIRE(q.queue.push(level(8)));
+
+    std::vector<Message::ID> ids;
+    std::vector<uint32_t> values;
+    q.queue.handle([&](Message* const message) {
+        ids.push_back(message->id);
+        if (message->id == Message::ID::AudioLevelReport)
+            values.push_back(level_of(message));
+        else if (message->id == Message::ID::TXProgress) {
+            const auto p = static_cast<const TXProgressMessage*>(message);
+            values.push_back(p->progress);
+            CHECK(p->done);
+        }
+    });
+
+    const std::vector<Message::ID> expected_ids{
+        Message::ID::DisplayFrameSync,
+        Message::ID::AudioLevelReport,
+        Message::ID::TXProgress,
+        Message::ID::AudioLevelReport};
+    CHECK(ids == expected_ids);
+    CHECK(values == std::vector<uint32_t>{7, 1234, 8});
+    CHECK(q.queue.is_empty());
+    CHECK_EQ(q.queue.pushed(), 4);
+    CHECK_EQ(q.queue.dropped(), 0);
+}
+
+TEST_CASE("A record that doesn't fit the tail wraps to the buffer start.") {
+    Queue q;
+    for (uint32_t i = 0; i < 5; i++)
+        REQUIRE(q.queue.push(level(i)));
+
+    CHECK_EQ(level_of(q.queue.peek()), 0);
+    q.queue.skip();
+    CHECK_EQ(level_of(q.queue.peek()), 1);
+    q.queue.skip();
+
+    // Only 4 bytes are left at the end, so the next record starts at 0.
+    TXProgressMessage progress{};
+    progress.progress = 99;
+    REQUIRE(q.queue.push(progress));
+
+    for (uint32_t i = 2; i < 5; i++) {
+        CHECK_EQ(level_of(q.queue.peek()), i);
+        q.queue.skip();
+    }
+
+    Message* const wrapped = q.queue.peek();
+    REQUIRE(wrapped != nullptr);
+    CHECK(wrapped->id == Message::ID::TXProgress);
+    CHECK(reinterpret_cast<uint8_t*>(wrapped) == &q.data[4]);
+    CHECK_EQ(static_cast<const TXProgressMessage*>(wrapped)->progress, 99);
+    q.queue.skip();
+
+    CHECK(q.queue.is_empty());
+    CHECK(q.queue.peek() == nullptr);
+    CHECK_EQ(q.queue.dropped(), 0);
+}
+
+TEST_CASE("A full queue drops the message and counts it.") {
+    Queue q;
+    for (uint32_t i = 0; i < 5; i++)
+        REQUIRE(q.queue.push(level(i)));
+
+    CHECK_FALSE(q.queue.push(level(5)));
+    CHECK_FALSE(q.queue.push(DisplayFrameSyncMessage{}));
+    CHECK_EQ(q.queue.pushed(), 5);
+    CHECK_EQ(q.queue.dropped(), 2);
+    CHECK_EQ(q.queue.dropped(Message::ID::AudioLevelReport), 1);
+    CHECK_EQ(q.queue.dropped(Message::ID::DisplayFrameSync), 1);
+    CHECK_EQ(q.queue.high_water(), 60);
+
+    // The dropped message leaves the queued ones intact, and space comes back.
+    q.queue.skip();
+    REQUIRE(q.queue.push(level(5)));
+    for (uint32_t i = 1; i < 6; i++) {
+        CHECK_EQ(level_of(q.queue.peek()), i);
+        q.queue.skip();
+    }
+    CHECK(q.queue.is_empty());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ctcss_tones.hpp"
+#include "tone_key.hpp"
+
+using namespace tonekey;
+
+TEST_SUITE_BEGIN("Tone key");
+
+TEST_CASE("The baseband CTCSS table matches tone_keys.") {
+    // tone_keys: "None", the CTCSS tones, then wireless mic pilot tones.
+    size_t ctcss_count = 0;
+    for (const auto& key : tone_keys) {
+        if (key.second == 0 || key.second >= 1000 * 100)
+            continue;
+        REQUIRE(ctcss_count < ctcss::tone_count);
+        CHECK(key.second == ctcss::tones_centihz[ctcss_count]);
+        ctcss_count++;
+    }
+    CHECK(ctcss_count == ctcss::tone_count);
+}
+
+TEST_CASE("Every detected CTCSS tone maps back to its tone key.") {
+    for (size_t i = 0; i < ctcss::tone_count; i++) {
+        const auto index = tone_key_index_by_value(ctcss::tones_centihz[i]);
+        REQUIRE(index > 0);
+        CHECK(tone_keys[index].second == ctcss::tones_centihz[i]);
+    }
+}
+
+TEST_CASE("A detected tone is shown on the first report.") {
+    CHECK(tone_key_string_by_value(8850, 20) == "T:88.5 #8 YB");
+    CHECK(tone_key_string_by_value(16220, 20) == "T:162.2 #26 5B");
+}
+
+TEST_SUITE_END();
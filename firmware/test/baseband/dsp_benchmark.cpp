@@ -0,0 +1,409 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host benchmark for the hot baseband kernels.
+ *
+ * Feeds fixed test captures (C8 at 3.072 MHz around +fs/4 and around DC, C16
+ * FM) through the decimators, demodulators and fxpt_atan2, timing each block
+ * and comparing its output against a double precision reference of the same
+ * filter. Prints input samples/second and SNR in dB, and exits non-zero if
+ * any block falls below its SNR floor, so numerical regressions in these
+ * kernels fail the test run.
+ *
+ *     baseband_benchmark [repeat_count]
+ */
+
+#include "dsp_decimate.hpp"
+#include "dsp_demodulate.hpp"
+#include "dsp_fir_taps.hpp"
+#include "fxpt_atan2.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using cd = std::complex<double>;
+
+constexpr size_t block_size = 2048;
+constexpr size_t block_count = 64;
+constexpr size_t sample_count = block_size * block_count;
+constexpr uint32_t fs_c8 = 3072000;
+constexpr uint32_t fs_c16 = 384000;
+
+/* Test captures ////////////////////////////////////////////////////////*/
+
+struct Tone {
+    double freq;
+    double amplitude;
+};
+
+/* Uniform noise in [-1, 1) from a fixed-seed LCG (<random> isn't usable with
+ * the firmware's _RANDOM_TCC=0 define), so every run sees the same capture.
+ */
+class Noise {
+   public:
+    double operator()() {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state_ >> 11) / static_cast<double>(1ULL << 52) - 1.0;
+    }
+
+   private:
+    uint64_t state_{1234};
+};
+
+/* Sum of tones plus uniform noise, rounded and clipped like an ADC. */
+template <typename T>
+std::vector<T> make_capture(const uint32_t fs, const std::vector<Tone>& tones, const double noise, const double limit) {
+    Noise rng;
+    std::vector<T> v(sample_count);
+    for (size_t n = 0; n < sample_count; n++) {
+        cd s{noise * rng(), noise * rng()};
+        for (const auto& tone : tones) {
+            s += std::polar(tone.amplitude, 2.0 * M_PI * tone.freq * n / fs);
+        }
+        const auto clip = [limit](const double x) { return std::round(std::max(-limit - 1, std::min(limit, x))); };
+        v[n] = {static_cast<typename T::value_type>(clip(s.real())),
+                static_cast<typename T::value_type>(clip(s.imag()))};
+    }
+    return v;
+}
+
+std::vector<complex16_t> make_fm(const uint32_t fs, const double deviation, const double amplitude) {
+    std::vector<complex16_t> v(sample_count);
+    double phase = 0.0;
+    for (size_t n = 0; n < sample_count; n++) {
+        const double audio = 0.7 * std::sin(2.0 * M_PI * 1000.0 * n / fs) + 0.3 * std::sin(2.0 * M_PI * 2700.0 * n / fs);
+        phase += 2.0 * M_PI * deviation * audio / fs;
+        v[n] = {static_cast<int16_t>(std::lround(amplitude * std::cos(phase))),
+                static_cast<int16_t>(std::lround(amplitude * std::sin(phase)))};
+    }
+    return v;
+}
+
+template <typename T>
+std::vector<cd> to_complex(const std::vector<T>& v) {
+    std::vector<cd> result(v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        result[i] = {static_cast<double>(v[i].real()), static_cast<double>(v[i].imag())};
+    }
+    return result;
+}
+
+/* Float references /////////////////////////////////////////////////////*/
+
+/* y[i] = gain * sum(taps[k] * x[factor * i + factor - taps.size() + k]), i.e.
+ * taps are applied oldest sample first and the window ends on the newest
+ * input sample of each output, matching the delay lines in dsp_decimate.
+ */
+std::vector<cd> fir_decimate(const std::vector<cd>& x, const std::vector<cd>& taps, const size_t factor, const double gain) {
+    std::vector<cd> y(x.size() / factor);
+    const long n_taps = taps.size();
+    for (size_t i = 0; i < y.size(); i++) {
+        cd acc{};
+        const long start = static_cast<long>(factor * i + factor) - n_taps;
+        for (long k = 0; k < n_taps; k++) {
+            if (start + k >= 0) acc += taps[k] * x[start + k];
+        }
+        y[i] = acc * gain;
+    }
+    return y;
+}
+
+template <size_t N>
+std::vector<cd> real_taps(const std::array<int16_t, N>& taps) {
+    return {taps.begin(), taps.end()};
+}
+
+/* Multiplies by (-j)^n, i.e. translates by -fs/4. */
+std::vector<cd> shift_fs4_down(std::vector<cd> x) {
+    static const cd rotation[4] = {{1, 0}, {0, -1}, {-1, 0}, {0, 1}};
+    for (size_t n = 0; n < x.size(); n++) {
+        x[n] *= rotation[n & 3];
+    }
+    return x;
+}
+
+double snr_db(const std::vector<cd>& reference, const std::vector<cd>& actual) {
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = 0; i < reference.size(); i++) {
+        signal += std::norm(reference[i]);
+        noise += std::norm(actual[i] - reference[i]);
+    }
+    return (noise > 0.0) ? 10.0 * std::log10(signal / noise) : 999.0;
+}
+
+/* Harness //////////////////////////////////////////////////////////////*/
+
+size_t repeat_count = 20;
+bool failed = false;
+
+/* Runs one pass over the capture with process(block_index), times
+ * repeat_count more passes, then prints the result row.
+ */
+void report(const char* const name, const size_t samples_per_pass, const double snr, const double min_snr, const std::function<void(size_t)>& process) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < repeat_count; r++) {
+        for (size_t b = 0; b < block_count; b++) {
+            process(b);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double rate = samples_per_pass * repeat_count / elapsed.count();
+
+    const bool ok = snr >= min_snr;
+    failed |= !ok;
+    std::printf("%-38s %10.2f Msps %8.1f dB (min %5.1f) %s\n", name, rate / 1e6, snr, min_snr, ok ? "" : "FAIL");
+}
+
+/* Runs a C8 or C16 -> C16 block over the whole capture once (for SNR) and
+ * then through report() for timing.
+ */
+template <typename Block, typename In>
+void run_complex(const char* const name, Block& block, Block& timed, std::vector<In>& in, const std::vector<cd>& reference, const double min_snr) {
+    std::vector<complex16_t> out(sample_count);
+    std::vector<cd> result;
+    for (size_t b = 0; b < block_count; b++) {
+        const buffer_t<In> src{&in[b * block_size], block_size, fs_c8};
+        const auto dst = block.execute(src, buffer_c16_t{out.data(), block_size});
+        for (size_t i = 0; i < dst.count; i++) {
+            result.emplace_back(dst.p[i].real(), dst.p[i].imag());
+        }
+    }
+
+    report(name, sample_count, snr_db(reference, result), min_snr, [&](const size_t b) {
+        timed.execute(buffer_t<In>{&in[b * block_size], block_size, fs_c8}, buffer_c16_t{out.data(), block_size});
+    });
+}
+
+/* Decimators ///////////////////////////////////////////////////////////*/
+
+void benchmark_decimators() {
+    /* NFM-like channel at +fs/4 (shifted to DC by decim_0), a second
+     * in-band signal, an out-of-band blocker and broadband noise.
+     */
+    auto c8_fs4 = make_capture<complex8_t>(fs_c8, {{fs_c8 / 4 + 3000.0, 60.0}, {fs_c8 / 4 - 41000.0, 25.0}, {-900000.0, 20.0}}, 6.0, 127.0);
+    auto c8_dc = make_capture<complex8_t>(fs_c8, {{12000.0, 60.0}, {-95000.0, 25.0}, {700000.0, 20.0}}, 6.0, 127.0);
+    auto c16 = make_capture<complex16_t>(fs_c16, {{2100.0, 12000.0}, {-17000.0, 5000.0}, {120000.0, 4000.0}}, 300.0, 32767.0);
+
+    const auto x_fs4 = to_complex(c8_fs4);
+    const auto x_dc = to_complex(c8_dc);
+    const auto x_c16 = to_complex(c16);
+    const std::vector<cd> cic3{1, 3, 3, 1};
+
+    {
+        dsp::decimate::Complex8DecimateBy2CIC3 a, b;
+        run_complex("Complex8DecimateBy2CIC3", a, b, c8_dc, fir_decimate(x_dc, cic3, 2, 32.0), 90.0);
+    }
+    {
+        dsp::decimate::TranslateByFSOver4AndDecimateBy2CIC3 a, b;
+        run_complex("TranslateByFSOver4AndDecimateBy2CIC3", a, b, c8_fs4, fir_decimate(shift_fs4_down(x_fs4), cic3, 2, 32.0), 90.0);
+    }
+    {
+        dsp::decimate::DecimateBy2CIC3 a, b;
+        run_complex("DecimateBy2CIC3", a, b, c16, fir_decimate(x_c16, cic3, 2, 1.0 / 8.0), 75.0);
+    }
+    {
+        dsp::decimate::FIRC8xR16x24FS4Decim4 a, b;
+        a.configure(taps_200k_decim_0.taps);
+        b.configure(taps_200k_decim_0.taps);
+        run_complex("FIRC8xR16x24FS4Decim4", a, b, c8_fs4, fir_decimate(shift_fs4_down(x_fs4), real_taps(taps_200k_decim_0.taps), 4, 1.0 / 128.0), 80.0);
+    }
+    {
+        dsp::decimate::FIRC8xR16x24FS4Decim8 a, b;
+        a.configure(taps_11k0_decim_0.taps);
+        b.configure(taps_11k0_decim_0.taps);
+        run_complex("FIRC8xR16x24FS4Decim8", a, b, c8_fs4, fir_decimate(shift_fs4_down(x_fs4), real_taps(taps_11k0_decim_0.taps), 8, 1.0 / 128.0), 80.0);
+    }
+    {
+        dsp::decimate::FIRC16xR16x16Decim2 a, b;
+        a.configure(taps_200k_decim_1.taps);
+        b.configure(taps_200k_decim_1.taps);
+        run_complex("FIRC16xR16x16Decim2", a, b, c16, fir_decimate(x_c16, real_taps(taps_200k_decim_1.taps), 2, 1.0 / 32768.0), 80.0);
+    }
+    {
+        dsp::decimate::FIRC16xR16x32Decim8 a, b;
+        a.configure(taps_11k0_decim_1.taps);
+        b.configure(taps_11k0_decim_1.taps);
+        run_complex("FIRC16xR16x32Decim8", a, b, c16, fir_decimate(x_c16, real_taps(taps_11k0_decim_1.taps), 8, 1.0 / 32768.0), 80.0);
+    }
+    {
+        const auto& taps = taps_2k8_usb_channel.taps;
+        std::vector<cd> reversed;
+        for (auto it = taps.rbegin(); it != taps.rend(); ++it) {
+            reversed.emplace_back(it->real(), it->imag());
+        }
+        dsp::decimate::FIRAndDecimateComplex a, b;
+        a.configure(taps, 2);
+        b.configure(taps, 2);
+        run_complex("FIRAndDecimateComplex (64 taps, /2)", a, b, c16, fir_decimate(x_c16, reversed, 2, 1.0 / 65536.0), 60.0);
+    }
+
+    /* Real-valued decimators run on the I channel of the C16 capture. */
+    std::vector<int16_t> s16(sample_count);
+    std::vector<cd> x_s16(sample_count);
+    for (size_t i = 0; i < sample_count; i++) {
+        s16[i] = c16[i].real();
+        x_s16[i] = s16[i];
+    }
+
+    const auto run_real = [&](const char* const name, auto& block, auto& timed, const std::vector<cd>& reference, const double min_snr) {
+        std::vector<int16_t> out(block_size);
+        std::vector<cd> result;
+        for (size_t b = 0; b < block_count; b++) {
+            const auto dst = block.execute(buffer_s16_t{&s16[b * block_size], block_size, fs_c16}, buffer_s16_t{out.data(), block_size});
+            for (size_t i = 0; i < dst.count; i++) {
+                result.emplace_back(dst.p[i]);
+            }
+        }
+        report(name, sample_count, snr_db(reference, result), min_snr, [&](const size_t b) {
+            timed.execute(buffer_s16_t{&s16[b * block_size], block_size, fs_c16}, buffer_s16_t{out.data(), block_size});
+        });
+    };
+
+    {
+        dsp::decimate::DecimateBy2CIC4Real a, b;
+        run_real("DecimateBy2CIC4Real", a, b, fir_decimate(x_s16, {1, 4, 6, 4, 1}, 2, 1.0 / 16.0), 75.0);
+    }
+    {
+        dsp::decimate::FIR64AndDecimateBy2Real a, b;
+        a.configure(taps_64_lp_025_025.taps);
+        b.configure(taps_64_lp_025_025.taps);
+        run_real("FIR64AndDecimateBy2Real", a, b, fir_decimate(x_s16, real_taps(taps_64_lp_025_025.taps), 2, 1.0 / 65536.0), 65.0);
+    }
+}
+
+/* Demodulators /////////////////////////////////////////////////////////*/
+
+void benchmark_demodulators() {
+    /* The s16 FM path uses an arctangent approximation that only holds for
+     * phase steps up to pi/4, so keep deviation / fs inside that.
+     */
+    constexpr double deviation = 5000.0;
+    constexpr uint32_t fs_demod = 48000;
+    auto fm = make_fm(fs_demod, deviation, 16000.0);
+    const auto x = to_complex(fm);
+
+    std::vector<float> out_f32(block_size);
+    std::vector<int16_t> out_s16(block_size);
+
+    {
+        dsp::demodulate::AM am;
+        std::vector<cd> reference, result;
+        auto am_in = make_capture<complex16_t>(fs_demod, {{0.0, 12000.0}, {1000.0, 6000.0}}, 100.0, 32767.0);
+        for (size_t b = 0; b < block_count; b++) {
+            const auto dst = am.execute(buffer_c16_t{&am_in[b * block_size], block_size, fs_demod}, buffer_f32_t{out_f32.data(), block_size});
+            for (size_t i = 0; i < dst.count; i++) {
+                const auto& s = am_in[b * block_size + i];
+                reference.emplace_back(std::hypot(s.real(), s.imag()) / 32768.0);
+                result.emplace_back(dst.p[i]);
+            }
+        }
+        report("demodulate::AM", sample_count, snr_db(reference, result), 120.0, [&](const size_t b) {
+            am.execute(buffer_c16_t{&am_in[b * block_size], block_size, fs_demod}, buffer_f32_t{out_f32.data(), block_size});
+        });
+    }
+
+    /* FM reference: angle of x[n] * conj(x[n - 1]), scaled so that the
+     * configured deviation maps to full scale.
+     */
+    const double kf = fs_demod / (2.0 * M_PI * deviation);
+    std::vector<cd> fm_reference(sample_count);
+    for (size_t n = 0; n < sample_count; n++) {
+        const cd previous = n ? x[n - 1] : cd{};
+        fm_reference[n] = std::arg(x[n] * std::conj(previous)) * kf;
+    }
+
+    {
+        dsp::demodulate::FM demod;
+        demod.configure(fs_demod, deviation);
+        std::vector<cd> result;
+        for (size_t b = 0; b < block_count; b++) {
+            const auto dst = demod.execute(buffer_c16_t{&fm[b * block_size], block_size, fs_demod}, buffer_f32_t{out_f32.data(), block_size});
+            for (size_t i = 0; i < dst.count; i++) {
+                result.emplace_back(dst.p[i]);
+            }
+        }
+        report("demodulate::FM (f32)", sample_count, snr_db(fm_reference, result), 120.0, [&](const size_t b) {
+            demod.execute(buffer_c16_t{&fm[b * block_size], block_size, fs_demod}, buffer_f32_t{out_f32.data(), block_size});
+        });
+    }
+    {
+        dsp::demodulate::FM demod;
+        demod.configure(fs_demod, deviation);
+        std::vector<cd> reference, result;
+        for (const auto& r : fm_reference) {
+            reference.emplace_back(std::max(-32768.0, std::min(32767.0, r.real() * 32767.0)));
+        }
+        for (size_t b = 0; b < block_count; b++) {
+            const auto dst = demod.execute(buffer_c16_t{&fm[b * block_size], block_size, fs_demod}, buffer_s16_t{out_s16.data(), block_size});
+            for (size_t i = 0; i < dst.count; i++) {
+                result.emplace_back(dst.p[i]);
+            }
+        }
+        report("demodulate::FM (s16, approx atan)", sample_count, snr_db(reference, result), 30.0, [&](const size_t b) {
+            demod.execute(buffer_c16_t{&fm[b * block_size], block_size, fs_demod}, buffer_s16_t{out_s16.data(), block_size});
+        });
+    }
+
+    /* fxpt_atan2 returns 1/65536ths of a turn; errors are taken modulo one
+     * turn so the +/-pi seam doesn't count.
+     */
+    {
+        std::vector<cd> reference, result;
+        for (const auto& s : fm) {
+            const double turns = std::atan2(s.imag(), s.real()) / (2.0 * M_PI) * 65536.0;
+            const uint16_t actual = fxpt_atan2(s.imag(), s.real());
+            const double error = std::remainder(actual - turns, 65536.0);
+            reference.emplace_back(turns);
+            result.emplace_back(turns + error);
+        }
+        volatile int16_t sink = 0;
+        report("fxpt_atan2", sample_count, snr_db(reference, result), 50.0, [&](const size_t b) {
+            int32_t acc = 0;
+            for (size_t i = 0; i < block_size; i++) {
+                const auto& s = fm[b * block_size + i];
+                acc += fxpt_atan2(s.imag(), s.real());
+            }
+            sink = acc;
+        });
+    }
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        repeat_count = std::max(1, std::atoi(argv[1]));
+    }
+
+    std::printf("%zu samples x %zu passes per block\n", sample_count, repeat_count);
+    benchmark_decimators();
+    benchmark_demodulators();
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
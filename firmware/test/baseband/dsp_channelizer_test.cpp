@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_channelizer.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using Channelizer = dsp::channelizer::PolyphaseChannelizer<64, 4>;
+
+constexpr uint32_t fs = 4000000;
+constexpr double channel_width = static_cast<double>(fs) / Channelizer::channel_count;
+
+std::vector<complex8_t> make_tone(const double freq, const double amplitude) {
+    std::vector<complex8_t> v(2048);
+    for (size_t n = 0; n < v.size(); n++) {
+        const double ph = 2.0 * M_PI * freq * n / fs;
+        v[n] = {static_cast<int8_t>(std::lround(amplitude * std::cos(ph))),
+                static_cast<int8_t>(std::lround(amplitude * std::sin(ph)))};
+    }
+    return v;
+}
+
+std::array<float, Channelizer::channel_count> channel_power(const double freq, const double amplitude = 100.0) {
+    Channelizer channelizer;
+    std::array<float, Channelizer::channel_count> power{};
+    auto input = make_tone(freq, amplitude);
+    const auto blocks = channelizer.accumulate(buffer_c8_t{input.data(), input.size(), fs}, 16, power);
+    REQUIRE(blocks == 16);
+    for (auto& p : power) {
+        p /= blocks;
+    }
+    return power;
+}
+
+double db(const double p) {
+    return 10.0 * std::log10(p + 1e-20);
+}
+
+}  // namespace
+
+TEST_CASE("channelizer prototype is symmetric") {
+    const auto& h = Channelizer::prototype;
+    for (size_t n = 0; n < h.size(); n++)
+        CHECK(h[n] == h[h.size() - 1 - n]);
+}
+
+TEST_CASE("channelizer block count is limited by the buffer") {
+    CHECK(Channelizer::max_blocks(Channelizer::taps - 1) == 0);
+    CHECK(Channelizer::max_blocks(Channelizer::taps) == 1);
+    CHECK(Channelizer::max_blocks(2048) == 29);
+}
+
+TEST_CASE("tone at a channel centre lands in that channel only") {
+    for (const size_t channel : {size_t{5}, size_t{31}, size_t{32}, size_t{50}}) {
+        const double freq = (static_cast<double>(channel) - 32.0) * channel_width;
+        const auto power = channel_power(freq);
+
+        const double expected = db((100.0 / 128.0) * (100.0 / 128.0));
+        CHECK(db(power[channel]) == doctest::Approx(expected).epsilon(0.02));
+
+        /* Beyond the adjacent channels, isolation is bounded by the 8 bit
+         * input's quantization noise rather than the prototype filter. */
+        for (size_t i = 0; i < power.size(); i++) {
+            if ((i + 1 < channel) || (i > channel + 1)) {
+                CHECK(db(power[channel]) - db(power[i]) > 45.0);
+            }
+        }
+    }
+}
+
+TEST_CASE("neighbouring channels cross near -6dB") {
+    const auto power = channel_power(10.5 * channel_width);
+    const auto peak = db(power[32 + 10]);
+    CHECK(db(power[32 + 11]) == doctest::Approx(peak).epsilon(0.05));
+    CHECK(peak - db((100.0 / 128.0) * (100.0 / 128.0)) == doctest::Approx(-6.0).epsilon(0.2));
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_fft_q15.hpp"
+#include "doctest.h"
+
+#include <cmath>
+
+/* Plain integer reference for fft_c_preswapped_q15(). It is written without
+ * the packed SIMD helpers so the two can be compared bit for bit. */
+template <size_t N>
+static int32_t reference_fft_q15(std::array<complex16_t, N>& data) {
+    constexpr auto K = log_2(N);
+    constexpr auto& sine = FFTTwiddleTableQ15<N>::sine;
+    constexpr size_t quarter = N / 4;
+
+    auto saturate = [](int32_t v) -> int16_t {
+        return (v > 32767) ? 32767 : ((v < -32768) ? -32768 : v);
+    };
+    // One's complement magnitude, as fft_q15_peak_bits() measures it.
+    auto magnitude = [](int32_t v) { return (v < 0) ? -v - 1 : v; };
+    auto peak_of = [&]() {
+        int32_t peak = 0;
+        for (const auto& v : data) {
+            peak = std::max(peak, magnitude(v.real()));
+            peak = std::max(peak, magnitude(v.imag()));
+        }
+        return peak;
+    };
+
+    int32_t exponent = 0;
+    for (size_t k = 0; k < K; k++) {
+        const int32_t peak = peak_of();
+        const int32_t shift = (peak >= 16384) ? 2 : ((peak >= 8192) ? 1 : 0);
+        const int32_t round = 1 << (14 + shift);
+        exponent += shift;
+
+        const size_t mmax = 1 << k;
+        for (size_t m = 0; m < mmax; m++) {
+            const size_t t = m * (N / (mmax * 2));
+            const int32_t s = sine[t % quarter];
+            const int32_t c = sine[quarter - (t % quarter)];
+            const int32_t wr = (t < quarter) ? c : -s;
+            const int32_t wi = (t < quarter) ? -s : -c;
+            for (size_t i = m; i < N; i += mmax * 2) {
+                const size_t j = i + mmax;
+                const int32_t br = data[j].real();
+                const int32_t bi = data[j].imag();
+                const int32_t tr = static_cast<int16_t>((br * wr - bi * wi + round) >> (15 + shift));
+                const int32_t ti = static_cast<int16_t>((br * wi + bi * wr + round) >> (15 + shift));
+                const int32_t ar = data[i].real() >> shift;
+                const int32_t ai = data[i].imag() >> shift;
+                data[i] = {saturate(ar + tr), saturate(ai + ti)};
+                data[j] = {saturate(ar - tr), saturate(ai - ti)};
+            }
+        }
+    }
+    return exponent;
+}
+
+template <size_t N>
+static void bit_reversed_tone(std::array<complex16_t, N>& data, const int32_t amplitude, const uint32_t seed) {
+    constexpr auto K = log_2(N);
+    uint32_t lfsr = seed;
+    for (size_t i = 0; i < N; i++) {
+        size_t i_rev = 0;
+        for (size_t b = 0; b < K; b++)
+            i_rev |= ((i >> b) & 1) << (K - 1 - b);
+
+        lfsr = lfsr * 1664525u + 1013904223u;
+        const int32_t noise = static_cast<int16_t>(lfsr >> 16) * amplitude / (8 * 32768);
+        const double phase = 2.0 * M_PI * (N / 5.0 + 0.25) * i / N;
+        data[i_rev] = {
+            static_cast<int16_t>(std::clamp<int32_t>(amplitude * 0.8 * cos(phase) + noise, -32768, 32767)),
+            static_cast<int16_t>(std::clamp<int32_t>(amplitude * 0.8 * sin(phase) - noise, -32768, 32767))};
+    }
+}
+
+template <size_t N>
+static bool q15_matches_reference(const int32_t amplitude, const uint32_t seed) {
+    std::array<complex16_t, N> simd{};
+    bit_reversed_tone(simd, amplitude, seed);
+    auto reference = simd;
+
+    const auto simd_exponent = fft_c_preswapped_q15(simd);
+    const auto reference_exponent = reference_fft_q15(reference);
+    if (simd_exponent != reference_exponent) return false;
+
+    for (size_t i = 0; i < N; i++) {
+        if (simd[i].__rep() != reference[i].__rep()) return false;
+    }
+    return true;
+}
+
+TEST_CASE("fft_c_preswapped_q15 is bit exact with the integer reference") {
+    for (const int32_t amplitude : {100, 3000, 12000, 32767}) {
+        CAPTURE(amplitude);
+        CHECK(q15_matches_reference<8>(amplitude, 1));
+        CHECK(q15_matches_reference<64>(amplitude, 2));
+        CHECK(q15_matches_reference<256>(amplitude, 3));
+        CHECK(q15_matches_reference<1024>(amplitude, 4));
+    }
+}
+
+TEST_CASE("fft_c_preswapped_q15 picks the reference shift at the thresholds") {
+    for (const int16_t value : {8191, 8192, 16383, 16384, -8192, -8193, -16384, -16385}) {
+        CAPTURE(value);
+        std::array<complex16_t, 64> simd{};
+        simd[5] = {value, 0};
+        simd[9] = {0, value};
+        auto reference = simd;
+
+        CHECK_EQ(fft_c_preswapped_q15(simd), reference_fft_q15(reference));
+        for (size_t i = 0; i < simd.size(); i++)
+            CHECK_EQ(simd[i].__rep(), reference[i].__rep());
+    }
+}
+
+TEST_CASE("fft_c_preswapped_q15 never saturates at full scale") {
+    std::array<complex16_t, 256> data{};
+    for (auto& v : data) v = {32767, -32768};
+    const auto exponent = fft_c_preswapped_q15(data);
+
+    // All energy ends up in the DC bin: 256 * 32767 (real), scaled by 2^exponent.
+    CHECK(exponent >= 8);
+    CHECK(std::abs(data[0].real() * std::pow(2.0, exponent) - 256.0 * 32767) < 256.0 * 32767 * 0.01);
+    CHECK(std::abs(data[0].imag() * std::pow(2.0, exponent) + 256.0 * 32768) < 256.0 * 32768 * 0.01);
+}
+
+TEST_CASE("fft_c_preswapped_q15 is accurate against the float FFT") {
+    std::array<complex16_t, 256> q15{};
+    bit_reversed_tone(q15, 20000, 5);
+    std::array<std::complex<float>, 256> reference{};
+    for (size_t i = 0; i < q15.size(); i++)
+        reference[i] = q15[i];
+
+    const auto exponent = fft_c_preswapped_q15(q15);
+    fft_c_preswapped_radix4(reference);
+
+    const float scale = std::pow(2.0f, exponent);
+    double signal = 0.0;
+    double error = 0.0;
+    for (size_t i = 0; i < q15.size(); i++) {
+        const std::complex<float> actual = static_cast<std::complex<float>>(q15[i]) * scale;
+        signal += std::norm(reference[i]);
+        error += std::norm(actual - reference[i]);
+    }
+    const double snr_db = 10.0 * std::log10(signal / error);
+    MESSAGE("Q15 FFT SNR against float: " << snr_db << " dB");
+    // ChannelSpectrum only carries ~51 dB (255 steps of 0.2 dB), so this leaves margin.
+    CHECK(snr_db > 55.0);
+}
@@ -22,6 +22,9 @@
 #include "dsp_fft.hpp"
 #include "doctest.h"
 
+#include <algorithm>
+#include <chrono>
+
 TEST_CASE("ifft successfully calculates dc on zero frequency") {
     uint32_t fft_width = 8;
     complex16_t* v = new complex16_t[fft_width];
@@ -123,3 +126,176 @@ TEST_CASE("ifft successfully calculates pure sine of half the sample rate") {
     delete[] v;
     delete[] tmp;
 }
+
+/* Reference helpers for the float FFT engines. Bit reversal is done here
+ * rather than with fft_swap() because __RBIT isn't available on the host. */
+template <size_t N>
+static void bit_reverse_copy(const std::array<std::complex<float>, N>& src, std::array<std::complex<float>, N>& dst) {
+    constexpr auto K = log_2(N);
+    for (size_t i = 0; i < N; i++) {
+        size_t i_rev = 0;
+        for (size_t b = 0; b < K; b++)
+            i_rev |= ((i >> b) & 1) << (K - 1 - b);
+        dst[i_rev] = src[i];
+    }
+}
+
+template <size_t N>
+static void make_test_signal(std::array<std::complex<float>, N>& v) {
+    /* Two tones plus a deterministic pseudo-random component. */
+    uint32_t lfsr = 0xACE1u;
+    for (size_t i = 0; i < N; i++) {
+        lfsr = lfsr * 1664525u + 1013904223u;
+        const float noise = static_cast<int16_t>(lfsr >> 16) / 8.0f;
+        const double p1 = 2.0 * M_PI * 3.0 * i / N;
+        const double p2 = 2.0 * M_PI * (N / 3.0 + 0.37) * i / N;
+        v[i] = {
+            static_cast<float>(16000.0 * cos(p1) + 4000.0 * cos(p2)) + noise,
+            static_cast<float>(16000.0 * sin(p1) - 4000.0 * sin(p2)) - noise};
+    }
+}
+
+/* Largest error against a double precision DFT, relative to the largest bin. */
+template <size_t N>
+static double radix4_relative_error() {
+    std::array<std::complex<float>, N> input{};
+    std::array<std::complex<float>, N> data{};
+    make_test_signal(input);
+    bit_reverse_copy(input, data);
+    fft_c_preswapped_radix4(data);
+
+    double max_error = 0.0;
+    double max_magnitude = 0.0;
+    for (size_t k = 0; k < N; k++) {
+        std::complex<double> sum{0.0, 0.0};
+        for (size_t n = 0; n < N; n++) {
+            const double phase = -2.0 * M_PI * static_cast<double>((k * n) % N) / N;
+            sum += std::complex<double>(input[n].real(), input[n].imag()) * std::polar(1.0, phase);
+        }
+        const std::complex<double> actual{data[k].real(), data[k].imag()};
+        max_error = std::max(max_error, std::abs(actual - sum));
+        max_magnitude = std::max(max_magnitude, std::abs(sum));
+    }
+    return max_error / max_magnitude;
+}
+
+TEST_CASE("fft_c_preswapped_radix4 matches the DFT for all sizes up to 2048") {
+    CHECK(radix4_relative_error<4>() < 1e-6);
+    CHECK(radix4_relative_error<8>() < 1e-6);
+    CHECK(radix4_relative_error<16>() < 1e-6);
+    CHECK(radix4_relative_error<32>() < 1e-6);
+    CHECK(radix4_relative_error<64>() < 1e-6);
+    CHECK(radix4_relative_error<128>() < 1e-6);
+    CHECK(radix4_relative_error<256>() < 1e-6);
+    CHECK(radix4_relative_error<512>() < 1e-6);
+    CHECK(radix4_relative_error<1024>() < 1e-6);
+    CHECK(radix4_relative_error<2048>() < 1e-6);
+}
+
+TEST_CASE("fft_c_preswapped_radix4 matches fft_c_preswapped at 256 points") {
+    std::array<std::complex<float>, 256> input{};
+    std::array<std::complex<float>, 256> radix2{};
+    std::array<std::complex<float>, 256> radix4{};
+    make_test_signal(input);
+    bit_reverse_copy(input, radix2);
+    radix4 = radix2;
+
+    fft_c_preswapped(radix2, 0, 8);
+    fft_c_preswapped_radix4(radix4);
+
+    float max_magnitude = 0.0f;
+    for (const auto& v : radix4)
+        max_magnitude = std::max(max_magnitude, std::abs(v));
+
+    for (size_t i = 0; i < radix4.size(); i++)
+        CHECK(std::abs(radix4[i] - radix2[i]) < max_magnitude * 1e-4f);
+}
+
+/* Stand-in for std::complex<float> that counts arithmetic, so the cost of the
+ * engines can be compared independently of the host CPU and its vectorizer.
+ * On the M4 every complex multiply is 4 FPU multiplies and 2 adds. */
+struct CountingComplex {
+    using value_type = float;
+    static size_t multiplies;
+    static size_t additions;
+
+    std::complex<float> v{};
+
+    CountingComplex() = default;
+    CountingComplex(const float re, const float im)
+        : v{re, im} {}
+    CountingComplex(const std::complex<float>& c)
+        : v{c} {}
+
+    float real() const { return v.real(); }
+    float imag() const { return v.imag(); }
+
+    CountingComplex& operator+=(const CountingComplex& other) {
+        additions++;
+        v += other.v;
+        return *this;
+    }
+};
+
+size_t CountingComplex::multiplies = 0;
+size_t CountingComplex::additions = 0;
+
+static CountingComplex operator*(const CountingComplex& a, const CountingComplex& b) {
+    CountingComplex::multiplies++;
+    return {a.v * b.v};
+}
+static CountingComplex operator+(const CountingComplex& a, const CountingComplex& b) {
+    CountingComplex::additions++;
+    return {a.v + b.v};
+}
+static CountingComplex operator-(const CountingComplex& a, const CountingComplex& b) {
+    CountingComplex::additions++;
+    return {a.v - b.v};
+}
+
+TEST_CASE("fft_c_preswapped_radix4 needs fewer multiplies than fft_c_preswapped") {
+    std::array<CountingComplex, 256> data{};
+
+    CountingComplex::multiplies = 0;
+    CountingComplex::additions = 0;
+    fft_c_preswapped(data, 0, 8);
+    const auto radix2_multiplies = CountingComplex::multiplies;
+    const auto radix2_additions = CountingComplex::additions;
+
+    CountingComplex::multiplies = 0;
+    CountingComplex::additions = 0;
+    fft_c_preswapped_radix4(data);
+    const auto radix4_multiplies = CountingComplex::multiplies;
+    const auto radix4_additions = CountingComplex::additions;
+
+    MESSAGE("256-point complex multiplies: radix-2 " << radix2_multiplies << ", radix-4 " << radix4_multiplies);
+    MESSAGE("256-point complex additions: radix-2 " << radix2_additions << ", radix-4 " << radix4_additions);
+    CHECK(radix4_multiplies * 3 <= radix2_multiplies * 2);
+    CHECK(radix4_additions <= radix2_additions);
+}
+
+TEST_CASE("fft_c_preswapped_radix4 host timing against fft_c_preswapped") {
+    constexpr size_t iterations = 2000;
+    std::array<std::complex<float>, 256> input{};
+    std::array<std::complex<float>, 256> data{};
+    make_test_signal(input);
+    bit_reverse_copy(input, data);
+
+    /* Host timing is only a proxy for M4 cycles (the host vectorizes the
+     * radix-2 loop, the M4 can't), so report it rather than fail on it. */
+    auto time_engine = [&](auto&& engine) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            auto work = data;
+            engine(work);
+            data[i & 0xFF] = work[(i * 7) & 0xFF] * 1e-6f;
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+
+    const auto radix2_ns = time_engine([](std::array<std::complex<float>, 256>& d) { fft_c_preswapped(d, 0, 8); });
+    const auto radix4_ns = time_engine([](std::array<std::complex<float>, 256>& d) { fft_c_preswapped_radix4(d); });
+
+    MESSAGE("256-point FFT: radix-2 " << radix2_ns << " ns, radix-4 " << radix4_ns << " ns");
+    CHECK(radix4_ns > 0.0);
+}
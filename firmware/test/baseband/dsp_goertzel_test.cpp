@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_goertzel.hpp"
+#include "ctcss_tones.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+// The NFM processor's CTCSS detector settings.
+constexpr float fs = 3000.0f;
+constexpr size_t window_length = 1200;
+constexpr float min_confidence = 0.5f;
+
+struct Random {
+    uint32_t state;
+
+    float uniform() {
+        state = state * 1664525u + 1013904223u;
+        return ((state >> 8) + 0.5f) / 16777216.0f;
+    }
+
+    /* Box-Muller. */
+    float gaussian() {
+        return std::sqrt(-2.0f * std::log(uniform())) * std::cos(2.0f * pi * uniform());
+    }
+};
+
+/* Speech-ish audio: a pitch gliding between 100 and 200 Hz and its harmonics
+ * up to 1.4kHz, with the ones under 300Hz cut as a transmitter does.
+ */
+struct Speech {
+    Random random{7};
+    float phase{0.0f};
+    float t{0.0f};
+    bool with_fundamental{false};
+
+    float next() {
+        t += 1.0f / fs;
+        const float pitch = 150.0f + 50.0f * std::sin(2.0f * pi * 0.7f * t) + 2.0f * random.gaussian();
+        phase += 2.0f * pi * pitch / fs;
+        float sum = 0.0f;
+        for (size_t h = 1; h * pitch < 1400.0f; h++) {
+            if (with_fundamental || h * pitch > 300.0f)
+                sum += std::sin(h * phase) / h;
+        }
+        return 0.5f * sum;
+    }
+};
+
+dsp::GoertzelBank<ctcss::tone_count> make_bank() {
+    dsp::GoertzelBank<ctcss::tone_count> bank{};
+    bank.configure(ctcss::tones_centihz, fs * 100.0f, window_length);
+    return bank;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("GoertzelBank");
+
+TEST_CASE("Every CTCSS tone is detected under speech and noise.") {
+    for (size_t tone = 0; tone < ctcss::tone_count; tone++) {
+        auto bank = make_bank();
+        Random random{static_cast<uint32_t>(tone)};
+        Speech speech{};
+        const float f = ctcss::tones_centihz[tone] / 100.0f;
+
+        size_t results = 0;
+        for (size_t n = 0; n < 3 * window_length; n++) {
+            const float sample = 0.1f * std::sin(2.0f * pi * f * n / fs) + speech.next() + 0.05f * random.gaussian();
+            if (bank.execute_once(sample)) {
+                results++;
+                CHECK(bank.result().index == tone);
+                CHECK(bank.result().confidence >= min_confidence);
+            }
+        }
+        CHECK(results == 4);
+    }
+}
+
+TEST_CASE("Noise and speech alone are not detected.") {
+    auto bank = make_bank();
+    Random random{99};
+    Speech speech{};
+    speech.with_fundamental = true;
+
+    float worst = 0.0f;
+    for (size_t n = 0; n < 40 * window_length; n++) {
+        const float sample = speech.next() + 0.05f * random.gaussian();
+        if (bank.execute_once(sample)) {
+            worst = std::max(worst, bank.result().confidence);
+        }
+    }
+    MESSAGE("Highest confidence without a tone: ", worst);
+    CHECK(worst < min_confidence);
+}
+
+TEST_CASE("A tone locks in well under a second.") {
+    auto bank = make_bank();
+    Random random{3};
+    const size_t tone = 27;  // 162.2Hz, 2.4Hz from its neighbours.
+    const float f = ctcss::tones_centihz[tone] / 100.0f;
+
+    // Arbitrary phase in the window cycle before the tone starts.
+    const size_t start = 777;
+    size_t locked_at = 0;
+    for (size_t n = 0; (n < start + 3 * window_length) && !locked_at; n++) {
+        float sample = 0.05f * random.gaussian();
+        if (n >= start)
+            sample += 0.1f * std::sin(2.0f * pi * f * (n - start) / fs);
+        if (bank.execute_once(sample) && (bank.result().confidence >= min_confidence)) {
+            CHECK(bank.result().index == tone);
+            locked_at = n;
+        }
+    }
+
+    REQUIRE(locked_at > start);
+    const float seconds = (locked_at - start) / fs;
+    MESSAGE("Locked after ", seconds, " s");
+    CHECK(seconds < 0.6f);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "matched_filter.hpp"
+#include "clock_recovery.hpp"
+#include "symbol_coding.hpp"
+#include "ais_baseband.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+
+/* There are no recorded captures in the tree, so the tests synthesize them:
+ * AIS-like frames (9600bd, +/-2400Hz deviation, NRZI) at 38.4kHz with
+ * Gaussian noise, decoded by the AIS symbol path with each filter. */
+
+namespace {
+
+constexpr double fs = 38400.0;
+constexpr double symbol_rate = 9600.0;
+constexpr double deviation = 2400.0;
+constexpr size_t samples_per_symbol = fs / symbol_rate;
+constexpr size_t payload_bits = 168;
+
+using dsp::matched_filter::MatchedFilter;
+using dsp::matched_filter::MatchedFilterQ15;
+
+struct Random {
+    uint32_t state;
+
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state;
+    }
+
+    double uniform() {
+        return (next() >> 8) / 16777216.0 + 1.0 / 33554432.0;
+    }
+
+    /* Box-Muller. */
+    double gaussian() {
+        return std::sqrt(-2.0 * std::log(uniform())) * std::cos(2.0 * M_PI * uniform());
+    }
+};
+
+struct Capture {
+    std::vector<complex16_t> samples{};
+    std::vector<std::string> payloads{};
+};
+
+/* Frames of preamble, flag, random payload and flag, separated by noise. */
+Capture make_capture(const size_t frames, const double amplitude, const double snr_db, const uint32_t seed) {
+    Random random{seed};
+    Capture capture{};
+    std::string bits;
+
+    for (size_t f = 0; f < frames; f++) {
+        bits += std::string(16, '0');
+        for (size_t i = 0; i < 24; i++)
+            bits += (i & 1) ? '1' : '0';
+        bits += "01111110";
+
+        std::string payload;
+        for (size_t i = 0; i < payload_bits; i++)
+            payload += (random.next() & 0x10000) ? '1' : '0';
+        bits += payload;
+        capture.payloads.push_back(payload);
+
+        bits += "01111110";
+    }
+    bits += std::string(16, '0');
+
+    const double noise = amplitude * std::pow(10.0, -snr_db / 20.0) / std::sqrt(2.0);
+    double phase = 0.0;
+    int level = 0;
+    for (const auto bit : bits) {
+        // NRZI: a 0 is a transition.
+        if (bit == '0')
+            level ^= 1;
+
+        const double f = level ? deviation : -deviation;
+        for (size_t i = 0; i < samples_per_symbol; i++) {
+            phase += 2.0 * M_PI * f / fs;
+            const double re = amplitude * std::cos(phase) + noise * random.gaussian();
+            const double im = amplitude * std::sin(phase) + noise * random.gaussian();
+            capture.samples.push_back({
+                static_cast<int16_t>(std::lround(std::max(-32768.0, std::min(32767.0, re)))),
+                static_cast<int16_t>(std::lround(std::max(-32768.0, std::min(32767.0, im)))),
+            });
+        }
+    }
+
+    return capture;
+}
+
+/* Runs the AIS symbol path and counts the payloads found intact. */
+template <typename Filter>
+size_t decode(const Capture& capture) {
+    Filter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    symbol_coding::NRZIDecoder nrzi_decode{};
+    std::string bits;
+    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
+        19200,
+        9600,
+        {0.0555f},
+        [&](const float symbol) {
+            bits += nrzi_decode((symbol >= 0.0f) ? 1 : 0) ? '1' : '0';
+        }};
+
+    for (const auto sample : capture.samples) {
+        if (mf.execute_once(sample))
+            clock_recovery(mf.get_output());
+    }
+
+    size_t decoded = 0;
+    for (const auto& payload : capture.payloads) {
+        if (bits.find("01111110" + payload + "01111110") != std::string::npos)
+            decoded++;
+    }
+    return decoded;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("MatchedFilterQ15");
+
+TEST_CASE("Q15 output tracks the float filter.") {
+    const auto capture = make_capture(4, 8000.0, 20.0, 1);
+
+    MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    MatchedFilterQ15 mf_q15{baseband::ais::square_taps_38k4_1t_p, 2};
+
+    double error = 0.0;
+    double power = 0.0;
+    size_t sign_errors = 0;
+    size_t outputs = 0;
+    for (const auto sample : capture.samples) {
+        const bool out = mf.execute_once(sample);
+        REQUIRE(out == mf_q15.execute_once(sample));
+        if (!out)
+            continue;
+
+        const double d = mf.get_output() - mf_q15.get_output();
+        error += d * d;
+        power += double(mf.get_output()) * mf.get_output();
+        if ((mf.get_output() >= 0.0f) != (mf_q15.get_output() >= 0.0f))
+            sign_errors++;
+        outputs++;
+    }
+
+    const double snr_db = 10.0 * std::log10(power / error);
+    MESSAGE("Q15 output SNR against float: ", snr_db, " dB");
+    CHECK(snr_db > 60.0);
+    CHECK(sign_errors * 1000 < outputs);
+}
+
+TEST_CASE("Q15 handles full scale input with 16 taps.") {
+    // TPMS/ACARS style rectangular taps, 16 long.
+    std::array<std::complex<float>, 16> taps{};
+    for (size_t n = 0; n < taps.size(); n++)
+        taps[n] = std::polar(1.0f / 16.0f, static_cast<float>(M_PI / 4.0 * n));
+
+    MatchedFilter mf{taps, 8};
+    MatchedFilterQ15 mf_q15{taps, 8};
+
+    // Worst case: corners, correlated with the taps.
+    for (size_t n = 0; n < 64; n++) {
+        const auto tap = taps[taps.size() - 1 - (n % taps.size())];
+        const complex16_t sample{
+            static_cast<int16_t>(tap.real() >= 0.0f ? 32767 : -32768),
+            static_cast<int16_t>(tap.imag() >= 0.0f ? 32767 : -32768)};
+        if (mf.execute_once(sample) & mf_q15.execute_once(sample)) {
+            CHECK(mf_q15.get_output() == doctest::Approx(mf.get_output()).epsilon(0.001));
+        }
+    }
+}
+
+TEST_CASE("Q15 decodes the captures as well as float.") {
+    constexpr size_t frames = 40;
+
+    for (const double snr_db : {6.0, 9.0, 12.0, 20.0}) {
+        for (const double amplitude : {600.0, 8000.0}) {
+            const auto capture = make_capture(frames, amplitude, snr_db, static_cast<uint32_t>(snr_db * 100 + amplitude));
+            const auto decoded = decode<MatchedFilter>(capture);
+            const auto decoded_q15 = decode<MatchedFilterQ15>(capture);
+
+            MESSAGE("SNR ", snr_db, " dB, amplitude ", amplitude, ": float ", decoded, "/", frames, ", Q15 ", decoded_q15, "/", frames);
+            CHECK(decoded_q15 >= decoded);
+            if (snr_db >= 12.0)
+                CHECK(decoded_q15 == frames);
+        }
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_welch.hpp"
+#include "doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using Window = WidebandSpectrumConfigMessage::Window;
+
+namespace {
+
+constexpr size_t span = 1024;
+
+/* int8 complex tone at bin + fraction, with a constant phase offset. */
+std::vector<complex8_t> make_tone(const double bin, const double amplitude) {
+    std::vector<complex8_t> samples(span);
+    for (size_t n = 0; n < span; n++) {
+        const double phase = 2.0 * M_PI * bin * n / dsp::welch::length + 0.3;
+        samples[n] = {
+            static_cast<int8_t>(std::lround(amplitude * std::cos(phase))),
+            static_cast<int8_t>(std::lround(amplitude * std::sin(phase)))};
+    }
+    return samples;
+}
+
+float peak_db(const std::vector<complex8_t>& samples, const Window window, const size_t step) {
+    dsp::welch::Averager averager{};
+    averager.configure(window);
+    for (size_t offset = 0; offset + dsp::welch::length <= span; offset += step)
+        averager.add(&samples[offset]);
+
+    float peak = 0.0f;
+    for (size_t i = 0; i < dsp::welch::length; i++)
+        peak = std::max(peak, averager.power(i));
+    return 10.0f * std::log10(peak);
+}
+
+}  // namespace
+
+TEST_CASE("A tone reads the same level with every window") {
+    const auto tone = make_tone(40.0, 100.0);
+    const float expected = 20.0f * std::log10(100.0f / 128.0f);
+    for (const auto window : {Window::None, Window::Hann, Window::BlackmanHarris, Window::FlatTop}) {
+        CHECK(peak_db(tone, window, 128) == doctest::Approx(expected).epsilon(0.02));
+    }
+}
+
+TEST_CASE("A tone half a bin off centre shows only the window's scalloping loss") {
+    const auto tone = make_tone(40.5, 100.0);
+    const float expected = 20.0f * std::log10(100.0f / 128.0f);
+
+    struct Case {
+        Window window;
+        float loss_db;
+    };
+    for (const auto c : {Case{Window::None, 3.92f}, Case{Window::Hann, 1.42f}, Case{Window::BlackmanHarris, 0.83f}, Case{Window::FlatTop, 0.01f}}) {
+        for (const size_t step : {256, 128, 64}) {
+            CHECK(peak_db(tone, c.window, step) == doctest::Approx(expected - c.loss_db).epsilon(0.02));
+        }
+    }
+}
+
+TEST_CASE("Full scale input doesn't overflow") {
+    std::vector<complex8_t> samples(span, complex8_t{-128, -128});
+    dsp::welch::Averager averager{};
+    averager.configure(Window::None);
+    averager.add(samples.data());
+    // DC at -128-128j is 2.0 in power.
+    CHECK(averager.power(0) == doctest::Approx(2.0f).epsilon(0.01));
+    for (size_t i = 1; i < dsp::welch::length; i++)
+        CHECK(averager.power(i) < 1e-6f);
+}
+
+TEST_CASE("Coherent gain of the windows") {
+    std::array<int16_t, dsp::window::length> w{};
+    dsp::window::expand(Window::Hann, w);
+    CHECK(dsp::welch::coherent_gain(w) == doctest::Approx(0.5f).epsilon(0.01));
+    dsp::window::expand(Window::BlackmanHarris, w);
+    CHECK(dsp::welch::coherent_gain(w) == doctest::Approx(0.359f).epsilon(0.01));
+    dsp::window::expand(Window::FlatTop, w);
+    CHECK(dsp::welch::coherent_gain(w) == doctest::Approx(0.216f).epsilon(0.01));
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_window.hpp"
+#include "doctest.h"
+
+#include <cmath>
+
+using Window = WidebandSpectrumConfigMessage::Window;
+
+TEST_CASE("Hann window table matches the closed form") {
+    std::array<int16_t, dsp::window::length> w{};
+    dsp::window::expand(Window::Hann, w);
+
+    for (size_t n = 0; n < w.size(); n++) {
+        const double expected = 0.5 - 0.5 * std::cos(2.0 * M_PI * n / w.size());
+        CHECK(std::abs(w[n] - expected * 32767.0) <= 1.0);
+    }
+}
+
+TEST_CASE("window tables are symmetric and peak at the centre") {
+    for (const auto type : {Window::Hann, Window::BlackmanHarris, Window::FlatTop}) {
+        std::array<int16_t, dsp::window::length> w{};
+        dsp::window::expand(type, w);
+
+        for (size_t n = 1; n < w.size(); n++)
+            CHECK(w[n] == w[w.size() - n]);
+
+        const auto peak = *std::max_element(w.begin(), w.end());
+        CHECK(peak == w[w.size() / 2]);
+        CHECK(peak >= 32700);
+    }
+}
+
+TEST_CASE("Blackman-Harris window starts near zero") {
+    CHECK(std::abs(dsp::window::blackman_harris[0]) <= 2);
+}
+
+TEST_CASE("flat top window dips negative by about 7%") {
+    const auto min = *std::min_element(dsp::window::flat_top.begin(), dsp::window::flat_top.end());
+    CHECK(min < -0.06 * 32767);
+    CHECK(min > -0.08 * 32767);
+}
+
+TEST_CASE("no window is unity") {
+    std::array<int16_t, dsp::window::length> w{};
+    dsp::window::expand(Window::None, w);
+    for (const auto v : w)
+        CHECK(v == 32767);
+}
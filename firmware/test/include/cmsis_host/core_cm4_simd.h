@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host (non-ARM) stand-in for the CMSIS core_cm4_simd.h.
+ *
+ * Portable C versions of the Cortex-M4 DSP extension intrinsics, so that
+ * baseband DSP code can be built and benchmarked on a development machine.
+ * It also provides the extra intrinsics that lpc43xx_m4.h only defines for
+ * ARM targets (two-operand __SXTB16, __SXTH, __SMLAxy, __SMULxy, __BFI...).
+ * GE flags are not modelled, so __SEL and the GE side effects of the parallel
+ * add/subtract instructions are not available.
+ */
+
+#ifndef __CORE_CM4_SIMD_H
+#define __CORE_CM4_SIMD_H
+
+#include <stdint.h>
+
+static inline int32_t __cm4_lo(uint32_t x) {
+    return (int16_t)(x & 0xffff);
+}
+
+static inline int32_t __cm4_hi(uint32_t x) {
+    return (int16_t)(x >> 16);
+}
+
+static inline uint32_t __cm4_pack(int32_t lo, int32_t hi) {
+    return ((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16);
+}
+
+static inline int32_t __cm4_sat16(int32_t x) {
+    return (x > 32767) ? 32767 : ((x < -32768) ? -32768 : x);
+}
+
+static inline int32_t __cm4_sat8(int32_t x) {
+    return (x > 127) ? 127 : ((x < -128) ? -128 : x);
+}
+
+static inline int32_t __cm4_sat32(int64_t x) {
+    return (x > INT32_MAX) ? INT32_MAX : ((x < INT32_MIN) ? INT32_MIN : (int32_t)x);
+}
+
+/* Parallel 16-bit add/subtract */
+
+static inline uint32_t __SADD16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_lo(op1) + __cm4_lo(op2), __cm4_hi(op1) + __cm4_hi(op2));
+}
+
+static inline uint32_t __QADD16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_sat16(__cm4_lo(op1) + __cm4_lo(op2)), __cm4_sat16(__cm4_hi(op1) + __cm4_hi(op2)));
+}
+
+static inline uint32_t __SHADD16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack((__cm4_lo(op1) + __cm4_lo(op2)) >> 1, (__cm4_hi(op1) + __cm4_hi(op2)) >> 1);
+}
+
+static inline uint32_t __SSUB16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_lo(op1) - __cm4_lo(op2), __cm4_hi(op1) - __cm4_hi(op2));
+}
+
+static inline uint32_t __QSUB16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_sat16(__cm4_lo(op1) - __cm4_lo(op2)), __cm4_sat16(__cm4_hi(op1) - __cm4_hi(op2)));
+}
+
+static inline uint32_t __SHSUB16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack((__cm4_lo(op1) - __cm4_lo(op2)) >> 1, (__cm4_hi(op1) - __cm4_hi(op2)) >> 1);
+}
+
+static inline uint32_t __SASX(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_lo(op1) - __cm4_hi(op2), __cm4_hi(op1) + __cm4_lo(op2));
+}
+
+static inline uint32_t __QASX(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_sat16(__cm4_lo(op1) - __cm4_hi(op2)), __cm4_sat16(__cm4_hi(op1) + __cm4_lo(op2)));
+}
+
+static inline uint32_t __SSAX(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_lo(op1) + __cm4_hi(op2), __cm4_hi(op1) - __cm4_lo(op2));
+}
+
+static inline uint32_t __QSAX(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_sat16(__cm4_lo(op1) + __cm4_hi(op2)), __cm4_sat16(__cm4_hi(op1) - __cm4_lo(op2)));
+}
+
+/* Parallel 8-bit add/subtract */
+
+static inline uint32_t __QADD8(uint32_t op1, uint32_t op2) {
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i += 8) {
+        result |= ((uint32_t)__cm4_sat8((int8_t)(op1 >> i) + (int8_t)(op2 >> i)) & 0xff) << i;
+    }
+    return result;
+}
+
+static inline uint32_t __QSUB8(uint32_t op1, uint32_t op2) {
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i += 8) {
+        result |= ((uint32_t)__cm4_sat8((int8_t)(op1 >> i) - (int8_t)(op2 >> i)) & 0xff) << i;
+    }
+    return result;
+}
+
+/* Extension */
+
+static inline uint32_t __SXTB16(uint32_t op1) {
+    return __cm4_pack((int8_t)(op1 & 0xff), (int8_t)((op1 >> 16) & 0xff));
+}
+
+static inline uint32_t __UXTB16(uint32_t op1) {
+    return op1 & 0x00ff00ff;
+}
+
+static inline uint32_t __SXTAB16(uint32_t op1, uint32_t op2) {
+    return __cm4_pack(__cm4_lo(op1) + (int8_t)(op2 & 0xff), __cm4_hi(op1) + (int8_t)((op2 >> 16) & 0xff));
+}
+
+/* Dual 16-bit multiply */
+
+static inline uint32_t __SMUAD(uint32_t op1, uint32_t op2) {
+    return (uint32_t)(__cm4_lo(op1) * __cm4_lo(op2) + __cm4_hi(op1) * __cm4_hi(op2));
+}
+
+static inline uint32_t __SMUADX(uint32_t op1, uint32_t op2) {
+    return (uint32_t)(__cm4_lo(op1) * __cm4_hi(op2) + __cm4_hi(op1) * __cm4_lo(op2));
+}
+
+static inline uint32_t __SMUSD(uint32_t op1, uint32_t op2) {
+    return (uint32_t)(__cm4_lo(op1) * __cm4_lo(op2) - __cm4_hi(op1) * __cm4_hi(op2));
+}
+
+static inline uint32_t __SMUSDX(uint32_t op1, uint32_t op2) {
+    return (uint32_t)(__cm4_lo(op1) * __cm4_hi(op2) - __cm4_hi(op1) * __cm4_lo(op2));
+}
+
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3) {
+    return __SMUAD(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLADX(uint32_t op1, uint32_t op2, uint32_t op3) {
+    return __SMUADX(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLSD(uint32_t op1, uint32_t op2, uint32_t op3) {
+    return __SMUSD(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLSDX(uint32_t op1, uint32_t op2, uint32_t op3) {
+    return __SMUSDX(op1, op2) + op3;
+}
+
+static inline int64_t __SMLALD(uint32_t op1, uint32_t op2, int64_t acc) {
+    return acc + (int64_t)__cm4_lo(op1) * __cm4_lo(op2) + (int64_t)__cm4_hi(op1) * __cm4_hi(op2);
+}
+
+static inline int64_t __SMLALDX(uint32_t op1, uint32_t op2, int64_t acc) {
+    return acc + (int64_t)__cm4_lo(op1) * __cm4_hi(op2) + (int64_t)__cm4_hi(op1) * __cm4_lo(op2);
+}
+
+static inline int64_t __SMLSLD(uint32_t op1, uint32_t op2, int64_t acc) {
+    return acc + (int64_t)__cm4_lo(op1) * __cm4_lo(op2) - (int64_t)__cm4_hi(op1) * __cm4_hi(op2);
+}
+
+static inline int64_t __SMLSLDX(uint32_t op1, uint32_t op2, int64_t acc) {
+    return acc + (int64_t)__cm4_lo(op1) * __cm4_hi(op2) - (int64_t)__cm4_hi(op1) * __cm4_lo(op2);
+}
+
+/* Saturating 32-bit arithmetic */
+
+static inline uint32_t __QADD(uint32_t op1, uint32_t op2) {
+    return (uint32_t)__cm4_sat32((int64_t)(int32_t)op1 + (int32_t)op2);
+}
+
+static inline uint32_t __QSUB(uint32_t op1, uint32_t op2) {
+    return (uint32_t)__cm4_sat32((int64_t)(int32_t)op1 - (int32_t)op2);
+}
+
+static inline uint32_t __SSAT16(uint32_t op1, uint32_t sat) {
+    const int32_t max = (1 << (sat - 1)) - 1;
+    const int32_t lo = __cm4_lo(op1);
+    const int32_t hi = __cm4_hi(op1);
+    return __cm4_pack((lo > max) ? max : ((lo < -max - 1) ? -max - 1 : lo),
+                      (hi > max) ? max : ((hi < -max - 1) ? -max - 1 : hi));
+}
+
+/* Pack halfword */
+
+#define __PKHBT(ARG1, ARG2, ARG3) ((((uint32_t)(ARG1)) & 0x0000FFFFUL) | \
+                                   ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+#define __PKHTB(ARG1, ARG2, ARG3) ((((uint32_t)(ARG1)) & 0xFFFF0000UL) | \
+                                   ((((uint32_t)(ARG2)) >> (ARG3)) & 0x0000FFFFUL))
+
+/* LPC43xx_M4 platform extensions (see lpc43xx_m4.h) */
+
+static inline int32_t __SXTH(uint32_t rm, uint32_t ror) {
+    return (int16_t)((ror ? ((rm >> ror) | (rm << (32 - ror))) : rm) & 0xffff);
+}
+
+static inline int32_t __SXTAH(uint32_t rn, uint32_t rm, uint32_t ror) {
+    return (int32_t)rn + __SXTH(rm, ror);
+}
+
+static inline int32_t __SMLABB(uint32_t rm, uint32_t rs, uint32_t rn) {
+    return __cm4_lo(rm) * __cm4_lo(rs) + (int32_t)rn;
+}
+
+static inline int32_t __SMLATB(uint32_t rm, uint32_t rs, uint32_t rn) {
+    return __cm4_hi(rm) * __cm4_lo(rs) + (int32_t)rn;
+}
+
+static inline int32_t __SMULBB(uint32_t op1, uint32_t op2) {
+    return __cm4_lo(op1) * __cm4_lo(op2);
+}
+
+static inline int32_t __SMULBT(uint32_t op1, uint32_t op2) {
+    return __cm4_lo(op1) * __cm4_hi(op2);
+}
+
+static inline int32_t __SMULTB(uint32_t op1, uint32_t op2) {
+    return __cm4_hi(op1) * __cm4_lo(op2);
+}
+
+static inline int32_t __SMULTT(uint32_t op1, uint32_t op2) {
+    return __cm4_hi(op1) * __cm4_hi(op2);
+}
+
+static inline int64_t __SMULL(int32_t op1, int32_t op2) {
+    return (int64_t)op1 * op2;
+}
+
+static inline int32_t __SMMULR(int32_t op1, int32_t op2) {
+    return (int32_t)(((int64_t)op1 * op2 + 0x80000000LL) >> 32);
+}
+
+static inline uint32_t __BFI(uint32_t rd, uint32_t rn, uint32_t lsb, uint32_t width) {
+    const uint32_t mask = ((width < 32) ? ((1UL << width) - 1) : 0xffffffffUL) << lsb;
+    return (rd & ~mask) | ((rn << lsb) & mask);
+}
+
+#ifdef __cplusplus
+/* core_cm4.h includes this inside extern "C", which doesn't allow overloads. */
+extern "C++" {
+static inline int32_t __SXTB16(uint32_t rm, uint32_t ror) {
+    return (int32_t)__SXTB16(ror ? ((rm >> ror) | (rm << (32 - ror))) : rm);
+}
+}
+#endif
+
+#endif /* __CORE_CM4_SIMD_H */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host (non-ARM) stand-in for the CMSIS core_cmInstr.h.
+ *
+ * Host test builds put this directory ahead of the CMSIS include directory,
+ * so core_cm4.h picks up these portable C versions instead of the inline
+ * assembly ones. Results match the Cortex-M4 instructions bit for bit;
+ * barriers, hints and exclusive monitors become no-ops.
+ */
+
+#ifndef __CORE_CMINSTR_H
+#define __CORE_CMINSTR_H
+
+#include <stdint.h>
+
+static inline void __NOP(void) {}
+static inline void __WFI(void) {}
+static inline void __WFE(void) {}
+static inline void __SEV(void) {}
+static inline void __ISB(void) {}
+static inline void __DSB(void) {}
+static inline void __DMB(void) {}
+static inline void __CLREX(void) {}
+
+static inline uint32_t __REV(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+static inline uint32_t __REV16(uint32_t value) {
+    return ((value & 0xff00ff00) >> 8) | ((value & 0x00ff00ff) << 8);
+}
+
+static inline int32_t __REVSH(int32_t value) {
+    return (int16_t)(((value & 0xff00) >> 8) | ((value & 0x00ff) << 8));
+}
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2) {
+    op2 &= 31;
+    return op2 ? ((op1 >> op2) | (op1 << (32 - op2))) : op1;
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value) {
+    return value ? __builtin_clz(value) : 32;
+}
+
+static inline int32_t __SSAT(int32_t value, uint32_t sat) {
+    const int32_t max = (int32_t)((1UL << (sat - 1)) - 1);
+    const int32_t min = -max - 1;
+    return (value > max) ? max : ((value < min) ? min : value);
+}
+
+static inline uint32_t __USAT(int32_t value, uint32_t sat) {
+    const int32_t max = (int32_t)((1UL << sat) - 1);
+    return (value > max) ? (uint32_t)max : ((value < 0) ? 0 : (uint32_t)value);
+}
+
+static inline uint8_t __LDREXB(volatile uint8_t* addr) {
+    return *addr;
+}
+
+static inline uint16_t __LDREXH(volatile uint16_t* addr) {
+    return *addr;
+}
+
+static inline uint32_t __LDREXW(volatile uint32_t* addr) {
+    return *addr;
+}
+
+static inline uint32_t __STREXB(uint8_t value, volatile uint8_t* addr) {
+    *addr = value;
+    return 0;
+}
+
+static inline uint32_t __STREXH(uint16_t value, volatile uint16_t* addr) {
+    *addr = value;
+    return 0;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t* addr) {
+    *addr = value;
+    return 0;
+}
+
+#endif /* __CORE_CMINSTR_H */
@@ -44,6 +44,7 @@ do
             echo "Copying external applications to" $mountpoint
             mkdir -p $mountpoint/APPS
             cp application/*.ppma $mountpoint/APPS
+            cp application/*.ppmz $mountpoint/APPS 2>/dev/null
             cp standalone/*/*.ppmp $mountpoint/APPS
 
             echo "Unmounting" $mountpoint
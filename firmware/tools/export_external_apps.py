@@ -53,6 +53,50 @@ def write_image(data, path):
 	f.write(data)
 	f.close()
 
+def image_checksum(image_data):
+	checksum = 0
+	for i in range(0, len(image_data), 4):
+		checksum += image_data[i] + (image_data[i + 1] << 8) + (image_data[i + 2] << 16) + (image_data[i + 3] << 24)
+	return (0 - checksum) & 0xFFFFFFFF
+
+# .ppmz holds the image as it sits in RAM once loaded (m4 image first, then the app), lz4 compressed,
+# so the loader can pull fewer bytes off the SD card. The loader decompresses in place from the end
+# of the region, which needs a small margin past the decompressed image; apps that don't leave it
+# (or don't compress at all) just get no .ppmz and load from the .ppma as before.
+def write_compressed_image(memory_image, path):
+	if os.path.exists(path):
+		os.remove(path)
+
+	raw = path + ".raw"
+	packed = path + ".lz4"
+	write_image(memory_image, raw)
+	try:
+		subprocess.run(["lz4", "-f", "-9", "-q", raw, packed], check=True)
+	except (OSError, subprocess.CalledProcessError):
+		print("lz4 not available, skipping", path)
+		return
+	finally:
+		os.remove(raw)
+
+	frame = read_image(packed)
+	os.remove(packed)
+
+	# skip frame header (magic, flags, bd, [content size], hc), keep the single data block
+	header_length = 15 if (frame[4] & 8) == 8 else 7
+	block_size = int.from_bytes(frame[header_length:header_length+4], byteorder='little')
+	if block_size & 0x80000000:
+		return  # stored uncompressed
+
+	block = frame[header_length+4:header_length+4+block_size]
+	# unlz4 reads a match offset after the final literals, zeros make that a no-op like the end mark in image chunks
+	block_end_pad = bytes(4)
+	inplace_margin = (len(block) >> 8) + 32
+	if len(memory_image) + inplace_margin + len(block_end_pad) > maximum_application_size:
+		return
+
+	header = struct.pack('<4sIII', b'PPMZ', len(memory_image), len(block), image_checksum(memory_image))
+	write_image(header + block + block_end_pad, path)
+
 def patch_image(path, image_data, search_address, replace_address):
 	if (len(image_data) % 4) != 0:
 		#sys.exit(-1)
@@ -112,12 +156,9 @@ for external_image_prefix in sys.argv[4:]:
 		external_application_image = patch_image(himg, external_application_image, search_address, replace_address)
 		external_application_image[memory_location_header_position:memory_location_header_position+4] = replace_address.to_bytes(4, byteorder='little')
 
-		checksum = 0
-		for i in range(0, len(external_application_image), 4):
-			checksum += external_application_image[i] + (external_application_image[i + 1] << 8) + (external_application_image[i + 2] << 16) + (external_application_image[i + 3] << 24)
+		write_compressed_image(external_application_image, "{}/{}.ppmz".format(binary_dir, external_image_prefix))
 
-		final_checksum = 0
-		checksum = (final_checksum - checksum) & 0xFFFFFFFF
+		checksum = image_checksum(external_application_image)
 		external_application_image += checksum.to_bytes(4, 'little')
 
 		write_image(external_application_image, "{}/{}.ppma".format(binary_dir, external_image_prefix))
@@ -146,12 +187,10 @@ for external_image_prefix in sys.argv[4:]:
 		print("application {} can not exceed 32kb: {} bytes used".format(external_image_prefix, len(external_application_image)))
 		sys.exit(-1)
 
-	checksum = 0
-	for i in range(0, len(external_application_image), 4):
-		checksum += external_application_image[i] + (external_application_image[i + 1] << 8) + (external_application_image[i + 2] << 16) + (external_application_image[i + 3] << 24)
+	memory_image = external_application_image[app_image_len:] + external_application_image[:app_image_len]
+	write_compressed_image(memory_image, "{}/{}.ppmz".format(binary_dir, external_image_prefix))
 
-	final_checksum = 0
-	checksum = (final_checksum - checksum) & 0xFFFFFFFF
+	checksum = image_checksum(external_application_image)
 	external_application_image += checksum.to_bytes(4, 'little')
 
 	# write .ppma (portapack mayhem application)
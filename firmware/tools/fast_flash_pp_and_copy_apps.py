@@ -203,13 +203,13 @@ def run():
             return
         print(f"find pp sd: {mount_point}")
 
-        # worker 5: copy ppma and ppmp apps
+        # worker 5: copy ppma, ppmz and ppmp apps
         apps_dir = os.path.join(mount_point, 'APPS')
         if not os.path.exists(apps_dir):
             os.makedirs(apps_dir)
 
         firmware_dir = os.path.join('.', 'firmware', 'application')
-        for ext in ['ppma', 'ppmp']:
+        for ext in ['ppma', 'ppmz', 'ppmp']:
             for file in glob.glob(os.path.join(firmware_dir, f'*.{ext}')):
                 dest = os.path.join(apps_dir, os.path.basename(file))
                 print(f"cp: {os.path.basename(file)}")
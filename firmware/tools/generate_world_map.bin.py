@@ -19,10 +19,75 @@
 #
 
 from __future__ import print_function
+import argparse
 import sys
 import struct
 from PIL import Image
 
+parser = argparse.ArgumentParser(description="Convert world_map.jpg to the PortaPack map formats.")
+parser.add_argument('--tiles', action='store_true',
+                    help="also write world_map.tiles, the tiled map with zoom levels")
+parser.add_argument('--levels', type=int, default=5,
+                    help="zoom levels in world_map.tiles, each half the size of the last (default 5)")
+args = parser.parse_args()
+
+TILES_MAGIC = b'PPMT'
+TILES_VERSION = 1
+TILE_SIZE = 16          # 16x16 RGB565 = one 512 byte SD sector per tile
+TILES_ALIGN = 512
+
+
+def rgb565(r, g, b):
+	# RRRRRGGGGGGBBBBB
+	return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def write_tiles(im, filename, levels):
+	# Level 0 is the full image, each further level is box filtered to half size.
+	images = [im]
+	for level in range(1, levels):
+		w, h = images[-1].size
+		if w < 2 * TILE_SIZE or h < 2 * TILE_SIZE:
+			break
+		images.append(images[-1].resize((w // 2, h // 2), Image.BOX))
+
+	header_size = 12 + 12 * len(images)
+	offset = (header_size + TILES_ALIGN - 1) // TILES_ALIGN * TILES_ALIGN
+	table = b''
+	for level_im in images:
+		w, h = level_im.size
+		tiles_x = (w + TILE_SIZE - 1) // TILE_SIZE
+		tiles_y = (h + TILE_SIZE - 1) // TILE_SIZE
+		table += struct.pack('<HHHHI', w, h, tiles_x, tiles_y, offset)
+		offset += tiles_x * tiles_y * TILE_SIZE * TILE_SIZE * 2
+
+	with open(filename, 'wb') as out:
+		out.write(TILES_MAGIC)
+		out.write(struct.pack('<HHHH', TILES_VERSION, TILE_SIZE, len(images), 0))
+		out.write(table)
+		out.write(b'\0' * ((header_size + TILES_ALIGN - 1) // TILES_ALIGN * TILES_ALIGN - header_size))
+
+		for level, level_im in enumerate(images):
+			w, h = level_im.size
+			tiles_x = (w + TILE_SIZE - 1) // TILE_SIZE
+			tiles_y = (h + TILE_SIZE - 1) // TILE_SIZE
+			print("level " + str(level) + "\t" + str(w) + "x" + str(h) + " pixels, " + str(tiles_x * tiles_y) + " tiles")
+			for ty in range(0, tiles_y):
+				# Edge tiles are padded with black
+				band = Image.new('RGB', (tiles_x * TILE_SIZE, TILE_SIZE))
+				band.paste(level_im.crop((0, ty * TILE_SIZE, w, min(h, (ty + 1) * TILE_SIZE))), (0, 0))
+				pix = band.load()
+				for tx in range(0, tiles_x):
+					tile = b''
+					for y in range(0, TILE_SIZE):
+						for x in range(tx * TILE_SIZE, (tx + 1) * TILE_SIZE):
+							r, g, b = pix[x, y]
+							tile += struct.pack('<H', rgb565(r, g, b))
+					out.write(tile)
+				print(str(ty) + '/' + str(tiles_y) + '\r', end="")
+			print()
+
+
 outfile = open('../../sdcard/ADSB/world_map.bin', 'wb')
 
 # Allow for bigger images
@@ -38,10 +103,7 @@ print("Generating: \t" + outfile.name + "\n from\t\t" + im.filename + "\n please
 for y in range (0, im.size[1]):
 	line = b''
 	for x in range (0, im.size[0]):
-		# RRRRRGGGGGGBBBBB
-		pixel_lcd = (pix[x, y][0] >> 3) << 11
-		pixel_lcd |= (pix[x, y][1] >> 2) << 5
-		pixel_lcd |= (pix[x, y][2] >> 3)
+		pixel_lcd = rgb565(pix[x, y][0], pix[x, y][1], pix[x, y][2])
 		#         RRRGGGBB to
 		# RRR00GGG000BB000
 		# pixel_lcd = (pix[x, y][0] >> 5) << 5
@@ -52,4 +114,9 @@ for y in range (0, im.size[1]):
 	print(str(y) + '/' + str(im.size[1]) + '\r', end="")
 
 outfile.close();
+
+if args.tiles:
+	print("Generating: \t../../sdcard/ADSB/world_map.tiles\n please wait...");
+	write_tiles(im.convert('RGB'), '../../sdcard/ADSB/world_map.tiles', args.levels)
+
 print("Ready.");